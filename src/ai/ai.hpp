@@ -13,6 +13,8 @@
 #include "../script/api/script_event_types.hpp"
 #include "ai_scanner.hpp"
 
+extern bool _ai_parallel_game_loop;
+
 /**
  * Main AI class. Contains all functions needed to start, stop, save and load AIs.
  */
@@ -17,6 +17,9 @@
 #include "../framerate_type.h"
 #include "../scope_info.h"
 #include "../string_func.h"
+#include "../genworld.h"
+#include "../worker_thread.h"
+#include "../script/squirrel.hpp"
 #include "ai_scanner.hpp"
 #include "ai_instance.hpp"
 #include "ai_config.hpp"
@@ -71,6 +74,25 @@
 	return;
 }
 
+bool _ai_parallel_game_loop = false; ///< Whether to run the AI scripts of multiple companies in parallel.
+
+/**
+ * Run the GameLoop of the AI of one company.
+ * @param c The AI company.
+ */
+static void RunAIGameLoop(const Company *c)
+{
+	SCOPE_INFO_FMT([&], "AI::GameLoop: {}: {} (v{})\n", c->index, c->ai_info->GetName(), c->ai_info->GetVersion());
+	PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
+	AutoRestoreBackup cur_company(_current_company, c->index);
+	c->ai_instance->GameLoop();
+	/* Occasionally collect garbage; every 255 ticks do one company.
+	 * Effectively collecting garbage once every two months per AI. */
+	if ((AI::GetTick() & 255) == 0 && (CompanyID)GB(AI::GetTick(), 8, 4) == c->index) {
+		c->ai_instance->CollectGarbage();
+	}
+}
+
 /* static */ void AI::GameLoop()
 {
 	/* If we are in networking, only servers run this function, and that only if it is allowed */
@@ -81,21 +103,32 @@
 	assert(_settings_game.difficulty.competitor_speed <= 4);
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
+	std::vector<const Company *> ai_companies;
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
-			SCOPE_INFO_FMT([&], "AI::GameLoop: {}: {} (v{})\n", c->index, c->ai_info->GetName(), c->ai_info->GetVersion());
-			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
-			AutoRestoreBackup cur_company(_current_company, c->index);
-			c->ai_instance->GameLoop();
-			/* Occasionally collect garbage; every 255 ticks do one company.
-			 * Effectively collecting garbage once every two months per AI. */
-			if ((AI::frame_counter & 255) == 0 && (CompanyID)GB(AI::frame_counter, 8, 4) == c->index) {
-				c->ai_instance->CollectGarbage();
-			}
+			ai_companies.push_back(c);
 		} else {
 			PerformanceMeasurer::SetInactive((PerformanceElement)(PFE_AI0 + c->index));
 		}
 	}
+
+	if (ai_companies.size() > 1 && _ai_parallel_game_loop && !_generating_world && _general_worker_pool.GetWorkerCount() > 0) {
+		/* The scripts only test their commands while running in parallel,
+		 * execute them afterwards in company order to keep the game deterministic. */
+		RunScriptsParallel((uint)ai_companies.size(), [&](uint i) {
+			RunAIGameLoop(ai_companies[i]);
+		});
+		for (const Company *c : ai_companies) {
+			c->ai_instance->ExecuteDeferredCommand();
+
+			AutoRestoreBackup cur_company(_current_company, c->index);
+			c->ai_instance->ReportDeath();
+		}
+	} else {
+		for (const Company *c : ai_companies) {
+			RunAIGameLoop(c);
+		}
+	}
 }
 
 /* static */ uint AI::GetTick()
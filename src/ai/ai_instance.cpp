@@ -13,6 +13,7 @@
 #include "../company_base.h"
 #include "../company_func.h"
 
+#include "../script/squirrel.hpp"
 #include "../script/squirrel_class.hpp"
 
 #include "ai_config.hpp"
@@ -67,16 +68,31 @@ void AIInstance::Died()
 	/* Don't show errors while loading savegame. They will be shown at end of loading anyway. */
 	if (_switch_mode != SM_NONE) return;
 
+	const AIInfo *info = AIConfig::GetConfig(_current_company)->GetInfo();
+	if (info != nullptr && !info->GetURL().empty()) {
+		ScriptLog::Info("Please report the error to the following URL:");
+		ScriptLog::Info(info->GetURL());
+	}
+
+	/* Windows can only be opened by the main thread. When running in parallel,
+	 * AI::GameLoop reports the death after all scripts have finished. */
+	this->death_reported = false;
+	if (!IsRunningScriptsParallel()) this->ReportDeath();
+}
+
+/**
+ * Show the death of the AI to the user, if that has not been done yet.
+ * This must be called on the main thread, with #_current_company set to the company of the AI.
+ */
+void AIInstance::ReportDeath()
+{
+	if (this->death_reported) return;
+	this->death_reported = true;
+
 	ShowScriptDebugWindow(_current_company);
 
-	const AIInfo *info = AIConfig::GetConfig(_current_company)->GetInfo();
-	if (info != nullptr) {
+	if (AIConfig::GetConfig(_current_company)->GetInfo() != nullptr) {
 		ShowErrorMessage(GetEncodedString(STR_ERROR_AI_PLEASE_REPORT_CRASH), {}, WarningLevel::Warning);
-
-		if (!info->GetURL().empty()) {
-			ScriptLog::Info("Please report the error to the following URL:");
-			ScriptLog::Info(info->GetURL());
-		}
 	}
 }
 
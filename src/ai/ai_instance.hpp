@@ -26,7 +26,11 @@ public:
 	int GetSetting(const std::string &name) override;
 	ScriptInfo *FindLibrary(const std::string &library, int version) override;
 
+	void ReportDeath();
+
 private:
+	bool death_reported = true; ///< Whether the death of the AI, if any, has been shown to the user.
+
 	void RegisterAPI() override;
 	void Died() override;
 	CommandCallback GetDoCommandCallback() override;
@@ -0,0 +1,66 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file 32bpp_anim_avx2.hpp An AVX2 32 bpp blitter with animation support. */
+
+#ifndef BLITTER_32BPP_AVX2_ANIM_HPP
+#define BLITTER_32BPP_AVX2_ANIM_HPP
+
+#ifdef WITH_SSE
+
+#ifndef SSE_VERSION
+#define SSE_VERSION 5
+#endif
+
+#ifndef SSE_TARGET
+#define SSE_TARGET "avx2"
+#endif
+
+#ifndef FULL_ANIMATION
+#define FULL_ANIMATION 1
+#endif
+
+#include "32bpp_anim.hpp"
+#include "32bpp_anim_sse2.hpp"
+#include "32bpp_avx2.hpp"
+#include "../cpu.h"
+
+#undef MARGIN_NORMAL_THRESHOLD
+#define MARGIN_NORMAL_THRESHOLD 4
+
+/** The AVX2 32 bpp blitter with palette animation. */
+class Blitter_32bppAVX2_Anim final : public Blitter_32bppSSE2_Anim, public Blitter_32bppAVX2 {
+private:
+
+public:
+	Blitter_32bppAVX2_Anim()
+	{
+		this->Blitter_32bppSSE2_Anim::SetSupportsMissingZoomLevels(true);
+		this->Blitter_32bppAVX2::SetSupportsMissingZoomLevels(true);
+	}
+
+	template <BlitterMode mode, Blitter_32bppSSE_Base::ReadMode read_mode, Blitter_32bppSSE_Base::BlockType bt_last, bool translucent, bool animated>
+	void Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom);
+	void Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom) override;
+
+	Sprite *Encode(SpriteType sprite_type, const SpriteLoader::SpriteCollection &sprite, SpriteAllocator &allocator) override
+	{
+		return Blitter_32bppSSE_Base::Encode(sprite_type, sprite, allocator);
+	}
+	const char *GetName() const override { return "32bpp-avx2-anim"; }
+	using Blitter_32bppSSE2_Anim::LookupColourInPalette;
+};
+
+/** Factory for the AVX2 32 bpp blitter (with palette animation). */
+class FBlitter_32bppAVX2_Anim: public BlitterFactory {
+public:
+	FBlitter_32bppAVX2_Anim() : BlitterFactory("32bpp-avx2-anim", "32bpp AVX2 Blitter (palette animation)", HasCPUAVX2Support()) {}
+	std::unique_ptr<Blitter> CreateInstance() override { return std::unique_ptr<Blitter>(static_cast<Blitter_32bppSSE2_Anim *>(new Blitter_32bppAVX2_Anim())); }
+};
+
+#endif /* WITH_SSE */
+#endif /* BLITTER_32BPP_AVX2_ANIM_HPP */
@@ -203,6 +203,128 @@ INTERNAL_LINKAGE inline __m128i AdjustBrightnessOfTwoPixels([[maybe_unused]] __m
 #endif
 }
 
+#if (SSE_VERSION >= 5)
+/* The following helpers process 8 pixels at once.
+ * Each 128 bit lane holds 2 pixels expanded to uint16, so the existing 128 bit control masks can be used for both lanes.
+ */
+
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i BroadcastMask(const __m128i mask)
+{
+	return _mm256_broadcastsi128_si256(mask);
+}
+
+/** Pack two sets of 4 expanded pixels back into 8 pixels, keeping only the low bytes. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i PackUnsaturatedEightPixels(__m256i lo, __m256i hi)
+{
+	const __m256i low_bytes = _mm256_set1_epi16(0xFF);
+	lo = _mm256_and_si256(lo, low_bytes);
+	hi = _mm256_and_si256(hi, low_bytes);
+	return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8); // VPACKUSWB works per lane, restore the pixel order
+}
+
+/** Pack two sets of 4 expanded pixels back into 8 pixels, with saturation. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i PackSaturatedEightPixels(__m256i lo, __m256i hi)
+{
+	return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+}
+
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AlphaBlendFourExpandedPixels(__m256i srcAB, __m256i dstAB, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	__m256i alphaMaskAB = _mm256_cmpgt_epi16(srcAB, _mm256_setzero_si256());
+	__m256i alphaAB = _mm256_sub_epi16(srcAB, alphaMaskAB);
+	alphaAB = _mm256_shuffle_epi8(alphaAB, distribution_mask);
+
+	srcAB = _mm256_sub_epi16(srcAB, dstAB);
+	srcAB = _mm256_mullo_epi16(srcAB, alphaAB);
+	srcAB = _mm256_srli_epi16(srcAB, 8);
+	srcAB = _mm256_add_epi16(srcAB, dstAB);
+
+	alphaMaskAB = _mm256_and_si256(alphaMaskAB, alpha_mask);
+	return _mm256_or_si256(srcAB, alphaMaskAB);
+}
+
+/** Same as AlphaBlendTwoPixels(), for 8 pixels. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AlphaBlendEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &alpha_mask)
+{
+	__m256i lo = AlphaBlendFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(src)), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(dst)), distribution_mask, alpha_mask);
+	__m256i hi = AlphaBlendFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(src, 1)), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(dst, 1)), distribution_mask, alpha_mask);
+	return PackUnsaturatedEightPixels(lo, hi);
+}
+
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i DarkenFourExpandedPixels(__m256i srcAB, __m256i dstAB, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	__m256i alphaAB = _mm256_shuffle_epi8(srcAB, distribution_mask);
+	alphaAB = _mm256_srli_epi16(alphaAB, 2);
+	__m256i nom = _mm256_sub_epi16(tr_nom_base, alphaAB);
+	dstAB = _mm256_mullo_epi16(dstAB, nom);
+	return _mm256_srli_epi16(dstAB, 8);
+}
+
+/** Same as DarkenTwoPixels(), for 8 pixels. */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i DarkenEightPixels(__m256i src, __m256i dst, const __m256i &distribution_mask, const __m256i &tr_nom_base)
+{
+	__m256i lo = DarkenFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(src)), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(dst)), distribution_mask, tr_nom_base);
+	__m256i hi = DarkenFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(src, 1)), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(dst, 1)), distribution_mask, tr_nom_base);
+	return PackSaturatedEightPixels(lo, hi);
+}
+
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AdjustBrightnessOfFourExpandedPixels(__m256i colAB, const __m256i &briAB)
+{
+	const __m256i ob_value = BroadcastMask(OVERBRIGHT_VALUE_MASK);
+
+	colAB = _mm256_mullo_epi16(colAB, briAB);
+	__m256i colAB_ob = _mm256_srli_epi16(colAB, 8 + 7);
+	colAB = _mm256_srli_epi16(colAB, 7);
+
+	colAB = _mm256_and_si256(colAB, BroadcastMask(BRIGHTNESS_DIV_CLEANER));
+	colAB_ob = _mm256_and_si256(colAB_ob, BroadcastMask(OVERBRIGHT_PRESENCE_MASK));
+	colAB_ob = _mm256_mullo_epi16(colAB_ob, ob_value);
+	colAB_ob = _mm256_and_si256(colAB_ob, colAB);
+	__m256i obAB = _mm256_hadd_epi16(_mm256_hadd_epi16(colAB_ob, _mm256_setzero_si256()), _mm256_setzero_si256());
+
+	obAB = _mm256_srli_epi16(obAB, 1);
+	obAB = _mm256_shuffle_epi8(obAB, BroadcastMask(OVERBRIGHT_CONTROL_MASK));
+	__m256i retAB = _mm256_subs_epu16(ob_value, colAB);
+	retAB = _mm256_mullo_epi16(retAB, obAB);
+	retAB = _mm256_srli_epi16(retAB, 8);
+	return _mm256_add_epi16(retAB, colAB);
+}
+
+/**
+ * Same as AdjustBrightnessOfTwoPixels(), for 8 pixels which all share the same brightness.
+ * @param from The pixels to adjust.
+ * @param briAB The brightness for each colour channel, DEFAULT_BRIGHTNESS for the alpha channels, see AdjustBrightnessOfTwoPixels().
+ */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m256i AdjustBrightnessOfEightPixels(__m256i from, const __m256i &briAB)
+{
+	__m256i lo = AdjustBrightnessOfFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(from)), briAB);
+	__m256i hi = AdjustBrightnessOfFourExpandedPixels(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(from, 1)), briAB);
+	return PackSaturatedEightPixels(lo, hi);
+}
+
+/**
+ * Get the alpha values of 8 pixels as uint16.
+ * @param src The pixels.
+ * @return The 8 alpha values.
+ */
+GNU_TARGET(SSE_TARGET)
+INTERNAL_LINKAGE inline __m128i ExtractAlphaOfEightPixels(__m256i src)
+{
+	__m256i alpha = _mm256_srli_epi32(src, 24);
+	alpha = _mm256_packus_epi32(alpha, alpha);
+	return _mm256_castsi256_si128(_mm256_permute4x64_epi64(alpha, 0x08));
+}
+#endif /* SSE_VERSION >= 5 */
+
 #if FULL_ANIMATION == 0
 /**
  * Draws a sprite to a (screen) buffer. It is templated to allow faster operation.
@@ -219,6 +341,8 @@ inline void Blitter_32bppSSE2::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 inline void Blitter_32bppSSSE3::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+inline void Blitter_32bppAVX2::Draw(const Blitter::BlitterParams *bp, ZoomLevel zoom)
 #endif
 {
 	const uint8_t * const remap = bp->remap;
@@ -261,6 +385,18 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 	#define DARKEN_PARAM_2      tr_nom_base
 #endif
 	const __m128i tr_nom_base = TRANSPARENT_NOM_BASE;
+#if (SSE_VERSION >= 5)
+	const __m256i a_cm_256        = BroadcastMask(ALPHA_CONTROL_MASK);
+	const __m256i alpha_and_256   = BroadcastMask(ALPHA_AND_MASK);
+	const __m256i tr_nom_base_256 = BroadcastMask(TRANSPARENT_NOM_BASE);
+	const __m128i m_mask          = CLEAR_HIGH_BYTE_MASK;
+	__m256i bm_normal_brightness_256 = _mm256_setzero_si256();
+	if (mode == BlitterMode::NormalWithBrightness) {
+		const int16_t bri = (DEFAULT_BRIGHTNESS + bp->brightness_adjust) & 0xFF;
+		bm_normal_brightness_256 = _mm256_setr_epi16(bri, bri, bri, DEFAULT_BRIGHTNESS, bri, bri, bri, DEFAULT_BRIGHTNESS,
+				bri, bri, bri, DEFAULT_BRIGHTNESS, bri, bri, bri, DEFAULT_BRIGHTNESS);
+	}
+#endif
 
 	for (int y = bp->height; y != 0; y--) {
 		Colour *dst = dst_line;
@@ -291,7 +427,19 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 					break;
 				}
 
+#if (SSE_VERSION >= 5)
+				for (uint x = (uint) effective_width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+					__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+					_mm256_storeu_si256((__m256i*) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm_256, alpha_and_256));
+					src += 8;
+					dst += 8;
+				}
+
+				for (uint x = ((uint) effective_width / 2) & 3; x > 0; x--) {
+#else
 				for (uint x = (uint) effective_width / 2; x > 0; x--) {
+#endif
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
 					_mm_storel_epi64((__m128i*) dst, AlphaBlendTwoPixels(srcABCD, dstABCD, ALPHA_BLEND_PARAM_1, ALPHA_BLEND_PARAM_2, ALPHA_BLEND_PARAM_3));
@@ -309,6 +457,22 @@ inline void Blitter_32bppSSE4::Draw(const Blitter::BlitterParams *bp, ZoomLevel
 			case BlitterMode::ColourRemap:
 #if (SSE_VERSION >= 3)
 				for (uint x = (uint) effective_width / 2; x > 0; x--) {
+#if (SSE_VERSION >= 5)
+					if (x >= 4) {
+						/* When none of the next 8 pixels needs remapping, blend them at once. */
+						const __m128i mvX8 = _mm_loadu_si128((const __m128i*) src_mv);
+						if (_mm_testz_si128(mvX8, m_mask)) {
+							__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+							__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+							_mm256_storeu_si256((__m256i*) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm_256, alpha_and_256));
+							dst += 8;
+							src += 8;
+							src_mv += 8;
+							x -= 3;
+							continue;
+						}
+					}
+#endif
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
 					uint32_t mvX2 = *((uint32_t *) const_cast<MapValue *>(src_mv));
@@ -390,7 +554,19 @@ bmcr_alpha_blend_single:
 
 			case BlitterMode::Transparent:
 				/* Make the current colour a bit more black, so it looks like this image is transparent. */
+#if (SSE_VERSION >= 5)
+				for (uint x = (uint) bp->width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+					__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+					_mm256_storeu_si256((__m256i *) dst, DarkenEightPixels(srcABCD, dstABCD, a_cm_256, tr_nom_base_256));
+					src += 8;
+					dst += 8;
+				}
+
+				for (uint x = ((uint) bp->width / 2) & 3; x > 0; x--) {
+#else
 				for (uint x = (uint) bp->width / 2; x > 0; x--) {
+#endif
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					__m128i dstABCD = _mm_loadl_epi64((__m128i*) dst);
 					_mm_storel_epi64((__m128i *) dst, DarkenTwoPixels(srcABCD, dstABCD, DARKEN_PARAM_1, DARKEN_PARAM_2));
@@ -446,7 +622,20 @@ bmcr_alpha_blend_single:
 				break;
 
 			case BlitterMode::NormalWithBrightness:
+#if (SSE_VERSION >= 5)
+				for (uint x = (uint) effective_width / 8; x > 0; x--) {
+					__m256i srcABCD = _mm256_loadu_si256((const __m256i*) src);
+					srcABCD = AdjustBrightnessOfEightPixels(srcABCD, bm_normal_brightness_256);
+					__m256i dstABCD = _mm256_loadu_si256((__m256i*) dst);
+					_mm256_storeu_si256((__m256i*) dst, AlphaBlendEightPixels(srcABCD, dstABCD, a_cm_256, alpha_and_256));
+					src += 8;
+					dst += 8;
+				}
+
+				for (uint x = ((uint) effective_width / 2) & 3; x > 0; x--) {
+#else
 				for (uint x = (uint) effective_width / 2; x > 0; x--) {
+#endif
 #if (SSE_VERSION >= 3)
 					__m128i srcABCD = _mm_loadl_epi64((const __m128i*) src);
 					srcABCD = AdjustBrightnessOfTwoPixels(srcABCD, bm_normal_brightness);
@@ -521,6 +710,8 @@ void Blitter_32bppSSE2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomL
 void Blitter_32bppSSSE3::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #elif (SSE_VERSION == 4)
 void Blitter_32bppSSE4::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
+#elif (SSE_VERSION == 5)
+void Blitter_32bppAVX2::Draw(Blitter::BlitterParams *bp, BlitterMode mode, ZoomLevel zoom)
 #endif
 {
 	switch (mode) {
@@ -147,8 +147,9 @@ Sprite *Blitter_8bppOptimized::Encode(SpriteType sprite_type, const SpriteLoader
 
 	/* Don't allocate memory each time, but just keep some
 	 * memory around as this function is called quite often
-	 * and the memory usage is quite low. */
-	static ReusableBuffer<uint8_t> temp_buffer;
+	 * and the memory usage is quite low.
+	 * This is per thread, as sprites may be encoded on worker threads. */
+	static thread_local ReusableBuffer<uint8_t> temp_buffer;
 	SpriteData *temp_dst = reinterpret_cast<SpriteData *>(temp_buffer.ZeroAllocate(memory));
 	uint8_t *dst = temp_dst->data;
 
@@ -687,6 +687,11 @@ void CheckCaches(bool force_check, std::function<void(std::string_view)> log, Ch
 		WaterRegionCheckCaches(cclog_output);
 	}
 
+	if (flags & CHECK_CACHE_NEWGRF_CB_MEMO) {
+		extern void NewGRFCallbackMemoCheckCaches(std::function<void(std::string_view)> log);
+		NewGRFCallbackMemoCheckCaches(cclog_output);
+	}
+
 	if ((flags & CHECK_CACHE_EMIT_LOG) && !saved_messages.empty()) {
 		InconsistencyExtraInfo info;
 		info.check_caches_result = std::move(saved_messages);
@@ -18,6 +18,7 @@
 #include "newgrf_generic.h"
 #include "newgrf_newlandscape.h"
 #include "tree_func.h"
+#include "worker_thread.h"
 
 #include "table/strings.h"
 #include "table/sprites.h"
@@ -413,6 +414,72 @@ static void TileLoop_Clear(TileIndex tile)
 	MarkTileDirtyByTile(tile, VMDF_NOT_MAP_MODE_NON_VEG);
 }
 
+/** Number of rows of each band in which rough and rocky land is placed independently by GenerateClearTileParallel. */
+static constexpr uint CLEAR_TILE_BAND_HEIGHT = 64;
+
+/**
+ * Add rough and rocky land to a band of rows, using a random stream of its own.
+ * Rocks do not spread out of the band, so bands can be processed concurrently.
+ * @param random The random stream of this band.
+ * @param y_start The first row of the band.
+ * @param y_end One past the last row of the band.
+ * @param rough The number of attempts to place rough land.
+ * @param rocks The number of attempts to place rocks.
+ */
+static void GenerateClearTileBand(Randomizer &random, uint y_start, uint y_end, uint rough, uint rocks)
+{
+	auto random_tile = [&]() { return TileXY(random.Next(Map::SizeX()), y_start + random.Next(y_end - y_start)); };
+
+	for (; rough > 0; rough--) {
+		TileIndex tile = random_tile();
+		if (IsTileType(tile, TileType::Clear) && !IsClearGround(tile, ClearGround::Desert)) SetClearGroundDensity(tile, ClearGround::Rough, 3);
+	}
+
+	for (; rocks > 0; rocks--) {
+		uint32_t r = random.Next();
+		TileIndex tile = random_tile();
+		if (!IsTileType(tile, TileType::Clear)) continue;
+
+		uint j = GB(r, 16, 4) + _settings_game.game_creation.amount_of_rocks + ((int)TileHeight(tile) * _settings_game.game_creation.height_affects_rocks);
+		for (;;) {
+			SetClearGroundDensity(tile, ClearGround::Rocks, 3);
+
+			TileIndex tile_new;
+			do {
+				if (--j == 0) break;
+				tile_new = tile + TileOffsByDiagDir((DiagDirection)GB(random.Next(), 0, 2));
+			} while (tile_new >= Map::Size() || TileY(tile_new) < y_start || TileY(tile_new) >= y_end || !IsTileType(tile_new, TileType::Clear));
+			if (j == 0) break;
+			tile = tile_new;
+		}
+	}
+}
+
+/**
+ * Add rough and rocky land with the same density as GenerateClearTile, in bands of rows on the worker pool.
+ * Each band gets its own random stream, seeded in order from the game's random, so the result does not
+ * depend on the number of threads; it does differ from the serial placement for the same seed.
+ * The tiles are not marked dirty, as the whole screen is redrawn after generating the world.
+ * @param rough The number of attempts to place rough land on the whole map.
+ * @param rocks The number of attempts to place rocks on the whole map.
+ */
+static void GenerateClearTileParallel(uint rough, uint rocks)
+{
+	const uint bands = std::max(1u, Map::SizeY() / CLEAR_TILE_BAND_HEIGHT);
+	std::vector<Randomizer> streams(bands);
+	for (Randomizer &stream : streams) stream.SetSeed(Random());
+
+	_general_worker_pool.ParallelFor(bands, [&](uint band) {
+		const uint y_start = Map::SizeY() * band / bands;
+		const uint y_end = Map::SizeY() * (band + 1) / bands;
+		/* Share the attempts in proportion to the rows of the band, the shares add up to the totals. */
+		auto share = [&](uint total) { return static_cast<uint>((uint64_t)total * y_end / Map::SizeY() - (uint64_t)total * y_start / Map::SizeY()); };
+		GenerateClearTileBand(streams[band], y_start, y_end, share(rough), share(rocks));
+	});
+
+	for (uint i = 0; i < rough + rocks; i++) IncreaseGeneratingWorldProgress(GenWorldProgress::RoughAndRocks);
+}
+
 void GenerateClearTile()
 {
 	uint i, gi;
@@ -423,6 +490,11 @@ void GenerateClearTile()
 	gi = Map::ScaleBySize(GB(Random(), 0, 7) + 0x80);
 
 	SetGeneratingWorldProgress(GenWorldProgress::RoughAndRocks, gi + i);
+	if (_parallel_world_generation) {
+		GenerateClearTileParallel(i, gi);
+		return;
+	}
+
 	do {
 		IncreaseGeneratingWorldProgress(GenWorldProgress::RoughAndRocks);
 		tile = RandomTile();
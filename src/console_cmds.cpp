@@ -63,6 +63,8 @@
 #include "debug_settings.h"
 #include "walltime_func.h"
 #include "debug_desync.h"
+#include "debug_trace.h"
+#include "vehicle_cpu_stats.h"
 #include "scope_info.h"
 #include "event_logs.h"
 #include "tile_cmd.h"
@@ -3202,6 +3204,51 @@ static bool ConVehicleStats(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConVehicleCpuStats(std::span<std::string_view> argv)
+{
+	if (argv.size() < 2 || argv.size() > 3) {
+		IConsolePrint(CC_HELP, "Debug: Sample the CPU time spent ticking and pathfinding for each vehicle. Usage: 'dump_veh_cpu_stats start [<interval>] | stop | clear | company | group | orders | vehicle [<count>]'");
+		IConsolePrint(CC_HELP, "  start: sample every tick, or every <interval> ticks. stop: stop sampling, the statistics are kept. clear: discard the statistics.");
+		IConsolePrint(CC_HELP, "  company, group, orders, vehicle: show the statistics of the current vehicles per company, group, order list or vehicle, most expensive first.");
+		IConsolePrint(CC_HELP, "  Tick time includes the pathfinder time of the same tick.");
+		return true;
+	}
+
+	uint value = 0;
+	if (argv.size() == 3) {
+		auto parsed = ParseInteger<uint>(argv[2]);
+		if (!parsed.has_value() || *parsed == 0) return false;
+		value = *parsed;
+	}
+
+	VehicleCpuStatsGrouping grouping;
+	if (argv[1] == "start") {
+		StartVehicleCpuStats(value != 0 ? value : 1);
+		return true;
+	} else if (argv[1] == "stop" && argv.size() == 2) {
+		StopVehicleCpuStats();
+		return true;
+	} else if (argv[1] == "clear" && argv.size() == 2) {
+		ClearVehicleCpuStats();
+		return true;
+	} else if (argv[1] == "company") {
+		grouping = VehicleCpuStatsGrouping::Company;
+	} else if (argv[1] == "group") {
+		grouping = VehicleCpuStatsGrouping::Group;
+	} else if (argv[1] == "orders") {
+		grouping = VehicleCpuStatsGrouping::OrderList;
+	} else if (argv[1] == "vehicle") {
+		grouping = VehicleCpuStatsGrouping::Vehicle;
+	} else {
+		return false;
+	}
+
+	format_buffer buffer;
+	DumpVehicleCpuStats(buffer, grouping, value != 0 ? value : 20);
+	PrintLineByLine(buffer);
+	return true;
+}
+
 static bool ConMapStats(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -3769,6 +3816,80 @@ static bool ConCheckCaches(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConDumpWorldHash(std::span<std::string_view> argv)
+{
+	if (argv.empty() || argv.size() > 3) {
+		IConsolePrint(CC_HELP, "Debug: Dump hashes of the world state, to localise desyncs. Usage: 'dump_world_hash [<part> [<region size log2>]]'");
+		IConsolePrint(CC_HELP, "  Without a part, the root hash and the hash of each part are shown.");
+		IConsolePrint(CC_HELP, "  With a part, the hash of each map region or each range of {} pool items of that part is shown.", WORLD_STATE_HASH_POOL_SHARD_SIZE);
+		return true;
+	}
+
+	uint region_size_log = WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG;
+	if (argv.size() == 3) {
+		auto value = ParseInteger<uint>(argv[2]);
+		if (!value.has_value() || *value < 2 || *value > 12) return false;
+		region_size_log = *value;
+	}
+
+	const WorldStateHash hash = ComputeWorldStateHash(region_size_log);
+
+	if (argv.size() == 1) {
+		IConsolePrint(CC_DEFAULT, "root: {:016X}", hash.RootHash());
+		for (uint i = 0; i < WSHP_END; i++) {
+			const WorldStateHashPart part = static_cast<WorldStateHashPart>(i);
+			IConsolePrint(CC_DEFAULT, "{}: {:016X} ({} shards)", GetWorldStateHashPartName(part), hash.PartHash(part), hash.shards[part].size());
+		}
+		return true;
+	}
+
+	for (uint i = 0; i < WSHP_END; i++) {
+		const WorldStateHashPart part = static_cast<WorldStateHashPart>(i);
+		if (argv[1] != GetWorldStateHashPartName(part)) continue;
+
+		IConsolePrint(CC_DEFAULT, "{}: {:016X}", GetWorldStateHashPartName(part), hash.PartHash(part));
+		const std::vector<uint64_t> &shards = hash.shards[part];
+		for (uint j = 0; j < shards.size(); j++) {
+			IConsolePrint(CC_DEFAULT, "  {}: {:016X}", DescribeWorldStateHashShard(part, j, region_size_log), shards[j]);
+		}
+		return true;
+	}
+
+	IConsolePrint(CC_ERROR, "Unknown part: {}", argv[1]);
+	return true;
+}
+
+static bool ConTrace(std::span<std::string_view> argv)
+{
+	if (argv.size() < 2 || argv.size() > 3) {
+		IConsolePrint(CC_HELP, "Debug: Record a trace of the game loop, pathfinders, link graph jobs, viewport drawing and save/load. Usage: 'trace start [newgrf] | stop | clear | status | export <filename>'");
+		IConsolePrint(CC_HELP, "  start newgrf: also record every NewGRF resolve, these are very frequent and quickly overwrite the other zones.");
+		IConsolePrint(CC_HELP, "  The export is in the Chrome trace event format, which can be viewed in Perfetto (ui.perfetto.dev) or chrome://tracing.");
+		return true;
+	}
+
+	if (argv[1] == "start" && (argv.size() == 2 || argv[2] == "newgrf")) {
+		StartTrace(argv.size() == 3);
+	} else if (argv[1] == "stop" && argv.size() == 2) {
+		StopTrace();
+	} else if (argv[1] == "clear" && argv.size() == 2) {
+		ClearTrace();
+	} else if (argv[1] == "status" && argv.size() == 2) {
+		const TraceStatus status = GetTraceStatus();
+		IConsolePrint(CC_DEFAULT, "Tracing: {}, NewGRF resolves: {}, threads: {}, zones recorded: {}, retained: {}", status.enabled ? "on" : "off", status.newgrf ? "on" : "off", status.threads, status.recorded, status.retained);
+	} else if (argv[1] == "export" && argv.size() == 3) {
+		size_t exported;
+		if (!ExportTrace(std::string(argv[2]), exported)) {
+			IConsolePrint(CC_ERROR, "Failed to write trace to: {}", argv[2]);
+			return true;
+		}
+		IConsolePrint(CC_DEFAULT, "Exported {} zones to: {}", exported, argv[2]);
+	} else {
+		return false;
+	}
+	return true;
+}
+
 static bool ConShowTownWindow(std::span<std::string_view> argv)
 {
 	if (argv.size() != 2) {
@@ -3845,6 +3966,7 @@ static bool ConViewportDebug(std::span<std::string_view> argv)
 		IConsolePrint(CC_HELP, "  10: VDF_SHOW_NO_LANDSCAPE_MAP_DRAW");
 		IConsolePrint(CC_HELP, "  20: VDF_DISABLE_LANDSCAPE_CACHE");
 		IConsolePrint(CC_HELP, "  40: VDF_DISABLE_THREAD");
+		IConsolePrint(CC_HELP, "  80: VDF_DISABLE_BUCKET_SPRITE_SORTER");
 		return true;
 	}
 
@@ -4614,6 +4736,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_inflation",          ConDumpInflation,    nullptr, true);
 	IConsole::CmdRegister("dump_cpdp_stats",         ConDumpCpdpStats,    nullptr, true);
 	IConsole::CmdRegister("dump_veh_stats",          ConVehicleStats,     nullptr, true);
+	IConsole::CmdRegister("dump_veh_cpu_stats",      ConVehicleCpuStats,  nullptr, true);
 	IConsole::CmdRegister("dump_map_stats",          ConMapStats,         nullptr, true);
 	IConsole::CmdRegister("dump_st_flow_stats",      ConStFlowStats,      nullptr, true);
 	IConsole::CmdRegister("dump_slot_stats",         ConSlotsStats,       nullptr, true);
@@ -4632,6 +4755,8 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("dump_sprite_cache_stats", ConSpriteCacheStats, nullptr, true);
 	IConsole::CmdRegister("dump_version",            ConDumpVersion,      nullptr, true);
 	IConsole::CmdRegister("check_caches",            ConCheckCaches,      nullptr, true);
+	IConsole::CmdRegister("dump_world_hash",         ConDumpWorldHash,    nullptr, true);
+	IConsole::CmdRegister("trace",                   ConTrace,            nullptr, true);
 	IConsole::CmdRegister("show_town_window",        ConShowTownWindow,   nullptr, true);
 	IConsole::CmdRegister("show_station_window",     ConShowStationWindow, nullptr, true);
 	IConsole::CmdRegister("show_industry_window",    ConShowIndustryWindow, nullptr, true);
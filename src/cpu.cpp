@@ -32,6 +32,7 @@ using CPUIDArray = std::array<int, 4>;
  *
  * Other platforms/architectures don't have CPUID, so zero the info and then
  * most (if not all) of the features are set as if they do not exist.
+ * Sub-leaf 0 is always requested, as required by the extended feature leaf (7).
  * @param type The information this instruction should retrieve.
  * @return The retrieved info. All zeros on architectures without CPUID.
  */
@@ -39,7 +40,7 @@ static CPUIDArray CPUID([[maybe_unused]] int type)
 {
 	CPUIDArray info{};
 #if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
-	__cpuid(info.data(), type);
+	__cpuidex(info.data(), type, 0);
 #elif defined(__i386) && defined(__PIC__)
 	/* The easy variant would be just cpuid, however... ebx is being used by the GOT (Global Offset Table)
 	 * in case of PIC;
@@ -55,13 +56,13 @@ static CPUIDArray CPUID([[maybe_unused]] int type)
 			/* It is safe to write "=r" for (info[1]) as in case that PIC is enabled for i386,
 			 * the compiler will not choose EBX as target register (but something else).
 			 */
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #elif defined(__x86_64__) || defined(__i386)
 	__asm__ __volatile__ (
 			"cpuid           \n\t"
 			: "=a" (info[0]), "=b" (info[1]), "=c" (info[2]), "=d" (info[3])
-			: "a" (type)
+			: "a" (type), "c" (0)
 	);
 #elif defined(__e2k__) /* MCST Elbrus 2000*/
 	if (type == 0) {
@@ -91,3 +92,39 @@ bool HasCPUIDFlag(uint type, uint index, uint bit)
 	cpu_info = CPUID(type);
 	return HasBit(cpu_info[index], bit);
 }
+
+/**
+ * Get the extended control register XCR0, which tells which register states the OS saves.
+ * Only call this when CPUID reports OSXSAVE support.
+ * @return The value of XCR0, or 0 on architectures without XGETBV.
+ */
+static uint64_t GetXCR0()
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	return _xgetbv(0);
+#elif defined(__x86_64__) || defined(__i386)
+	uint32_t eax, edx;
+	__asm__ __volatile__ (
+			"xgetbv          \n\t"
+			: "=a" (eax), "=d" (edx)
+			: "c" (0)
+	);
+	return ((uint64_t)edx << 32) | eax;
+#else
+	return 0;
+#endif
+}
+
+bool HasCPUAVX2Support()
+{
+	/* The CPU must support AVX and XSAVE/XGETBV must be enabled by the OS. */
+	if (!HasCPUIDFlag(1, 2, 27) || !HasCPUIDFlag(1, 2, 28)) return false;
+
+	/* The OS must save both the XMM and YMM register state on context switches. */
+	if ((GetXCR0() & 0x6) != 0x6) return false;
+
+	/* The extended feature leaf must be supported, otherwise the CPU returns the data of its highest basic leaf. */
+	if (CPUID(0)[0] < 7) return false;
+
+	return HasBit(CPUID(7)[1], 5);
+}
@@ -19,4 +19,10 @@
  */
 bool HasCPUIDFlag(uint type, uint index, uint bit);
 
+/**
+ * Check whether the current CPU supports AVX2, and whether the OS has enabled the AVX register state.
+ * @return True when AVX2 instructions can be used.
+ */
+bool HasCPUAVX2Support();
+
 #endif /* CPU_H */
@@ -674,9 +674,11 @@ void CrashLog::FillDesyncCrashLog(format_target_ctrl &buffer, const DesyncExtraI
 		auto flag_check = [&](DesyncExtraInfo::Flags flag, const char *str) {
 			return info.flags & flag ? str : "";
 		};
-		buffer.format("Flags: {}{}\n",
+		buffer.format("Flags: {}{}{}\n",
 				flag_check(DesyncExtraInfo::DEIF_RAND, "R"),
-				flag_check(DesyncExtraInfo::DEIF_STATE, "S"));
+				flag_check(DesyncExtraInfo::DEIF_STATE, "S"),
+				flag_check(DesyncExtraInfo::DEIF_WORLD_HASH, "W"));
+		if (!info.world_hash_mismatch.empty()) buffer.format("{}\n", info.world_hash_mismatch);
 	}
 	if (_network_server && !info.desync_frame_info.empty()) {
 		buffer.format("{}\n", info.desync_frame_info);
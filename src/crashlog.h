@@ -24,12 +24,14 @@ struct DesyncExtraInfo {
 		DEIF_NONE       = 0,      ///< no flags
 		DEIF_RAND       = 1 << 0, ///< random mismatch
 		DEIF_STATE      = 1 << 1, ///< state mismatch
+		DEIF_WORLD_HASH = 1 << 2, ///< world state shard hash mismatch
 	};
 
 	Flags flags = DEIF_NONE;
 	const char *client_name = nullptr;
 	int client_id = -1;
 	std::string desync_frame_info;
+	std::string world_hash_mismatch; ///< description of the mismatching world state shard, if any
 	std::optional<FileHandle> *log_file = nullptr; ///< save unclosed log file handle here
 	DesyncDeferredSaveInfo *defer_savegame_write = nullptr;
 };
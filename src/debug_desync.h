@@ -10,13 +10,18 @@
 #ifndef DEBUG_DESYNC_H
 #define DEBUG_DESYNC_H
 
+#include <array>
 #include <functional>
+#include <span>
+#include <string>
+#include <vector>
 
 enum CheckCachesFlags : uint32_t {
 	CHECK_CACHE_NONE               =       0,
 	CHECK_CACHE_GENERAL            = 1 <<  0,
 	CHECK_CACHE_INFRA_TOTALS       = 1 <<  1,
 	CHECK_CACHE_WATER_REGIONS      = 1 <<  2,
+	CHECK_CACHE_NEWGRF_CB_MEMO     = 1 <<  3,
 	CHECK_CACHE_ALL                = UINT16_MAX,
 	CHECK_CACHE_EMIT_LOG           = 1 << 16,
 };
@@ -24,4 +29,46 @@ DECLARE_ENUM_AS_BIT_SET(CheckCachesFlags)
 
 extern void CheckCaches(bool force_check, std::function<void(std::string_view)> log = nullptr, CheckCachesFlags flags = CHECK_CACHE_ALL);
 
+/** Parts of the world state hash. */
+enum WorldStateHashPart : uint8_t {
+	WSHP_MAP,                      ///< Map tiles, one shard per map region.
+	WSHP_VEHICLES,                 ///< Vehicle pool.
+	WSHP_STATIONS,                 ///< Station pool.
+	WSHP_CARGO_PACKETS,            ///< Cargo packet pool.
+	WSHP_ORDERS,                   ///< Order list pool.
+	WSHP_COMPANIES,                ///< Company pool.
+	WSHP_END,
+};
+
+static const uint WORLD_STATE_HASH_POOL_SHARD_SIZE = 64; ///< Number of consecutive pool indices in each shard of a pool part.
+static const uint WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG = 6; ///< Default log2 of the width/height of a map region.
+
+/**
+ * Hashes of the world state, split into parts and shards.
+ * Comparing the root, part and shard hashes of two clients narrows a desync down to a map region or a range of pool items.
+ */
+struct WorldStateHash {
+	uint region_size_log = 0;                                  ///< Log2 of the width/height of a map region.
+	uint regions_x = 0;                                        ///< Number of map regions in the x direction.
+	std::array<std::vector<uint64_t>, WSHP_END> shards;        ///< Shard hashes of each part, map regions are in row major order.
+
+	uint64_t PartHash(WorldStateHashPart part) const;
+	uint64_t RootHash() const;
+};
+
+/** Hash of one shard of the world state, as sent by the server with a sync. */
+struct WorldStateShardHash {
+	WorldStateHashPart part; ///< The part of the world state.
+	uint32_t shard;          ///< The shard within the part, using #WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG for map regions.
+	uint64_t hash;           ///< The hash of the shard.
+};
+
+WorldStateHash ComputeWorldStateHash(uint region_size_log);
+uint GetWorldStateHashShardCount(WorldStateHashPart part, uint region_size_log);
+uint64_t ComputeWorldStateHashShard(WorldStateHashPart part, uint shard, uint region_size_log);
+std::vector<WorldStateShardHash> ComputeNextWorldStateShardHashes(uint count);
+const WorldStateShardHash *FindWorldStateShardHashMismatch(std::span<const WorldStateShardHash> expected);
+const char *GetWorldStateHashPartName(WorldStateHashPart part);
+std::string DescribeWorldStateHashShard(WorldStateHashPart part, uint shard, uint region_size_log);
+
 #endif /* DEBUG_DESYNC_H */
@@ -40,6 +40,7 @@ enum NewGRFOptimiserFlags {
 	NGOF_NO_OPT_VARACT2_INSERT_JUMPS    = 6,
 	NGOF_NO_OPT_VARACT2_CB_QUICK_EXIT   = 7,
 	NGOF_NO_OPT_VARACT2_PROC_INLINE     = 8,
+	NGOF_NO_CALLBACK_MEMO               = 9,
 };
 
 inline bool HasGrfOptimiserFlag(NewGRFOptimiserFlags flag)
@@ -0,0 +1,250 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file debug_trace.cpp Tracing of scoped zones, for export in the Chrome trace event format. */
+
+#include "stdafx.h"
+#include "debug_trace.h"
+#include "fileio_func.h"
+#include "thread.h"
+#include "core/format.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "safeguards.h"
+
+std::atomic<bool> _trace_enabled{false};        ///< Whether zones are being recorded.
+std::atomic<bool> _trace_newgrf_enabled{false}; ///< Whether NewGRF resolves are recorded, they are by far the most frequent zones.
+
+/** Number of zones retained in the trace of each thread, older zones are overwritten. */
+static constexpr uint64_t TRACE_THREAD_CAPACITY = 1 << 16;
+/** Number of traces of exited threads which are retained, before they are reused for new threads. */
+static constexpr size_t TRACE_MAX_EXITED_THREADS = 32;
+
+/** One recorded zone, the fields are atomic as an export may read them while the thread overwrites them. */
+struct TraceEvent {
+	std::atomic<const char *> name;
+	std::atomic<int64_t> start;
+	std::atomic<int64_t> end;
+};
+
+/** Ring buffer with the trace of one thread, only that thread records to it. */
+struct TraceThreadBuffer {
+	std::unique_ptr<TraceEvent[]> events = std::make_unique<TraceEvent[]>(TRACE_THREAD_CAPACITY);
+	std::atomic<uint64_t> head{0};    ///< Number of zones ever recorded, the next zone is stored at head % TRACE_THREAD_CAPACITY.
+	std::atomic<uint64_t> writing{0}; ///< Number of zones of which the recording has started, at most one more than head.
+	std::atomic<bool> exited{false}; ///< Whether the thread has exited.
+	uint64_t cleared = 0;            ///< Zones before this have been cleared, protected by _trace_buffers_mutex.
+	uint tid = 0;                    ///< Thread ID in the exported trace.
+	std::string thread_name;         ///< Thread name in the exported trace.
+};
+
+static std::mutex _trace_buffers_mutex;                              ///< Protects the list of thread traces.
+static std::vector<std::unique_ptr<TraceThreadBuffer>> _trace_buffers; ///< Traces of all threads, in order of registration.
+static uint _trace_next_tid = 1;                                     ///< Thread ID of the next registered thread.
+
+/** Owner of the trace of the current thread, which marks the trace as exited when the thread exits. */
+struct TraceThreadHolder {
+	TraceThreadBuffer *buffer = nullptr;
+
+	~TraceThreadHolder()
+	{
+		if (this->buffer != nullptr) this->buffer->exited.store(true, std::memory_order_release);
+	}
+};
+
+static thread_local TraceThreadHolder _trace_thread;
+
+/**
+ * Register a trace for the current thread.
+ * @return The trace.
+ */
+static TraceThreadBuffer *RegisterTraceThread()
+{
+	format_buffer name;
+	GetCurrentThreadName(name);
+
+	std::lock_guard lock(_trace_buffers_mutex);
+
+	std::unique_ptr<TraceThreadBuffer> buffer;
+	const size_t exited = std::ranges::count_if(_trace_buffers, [](const auto &b) { return b->exited.load(std::memory_order_acquire); });
+	if (exited >= TRACE_MAX_EXITED_THREADS) {
+		/* Reuse the trace of the exited thread which was registered first. */
+		auto it = std::ranges::find_if(_trace_buffers, [](const auto &b) { return b->exited.load(std::memory_order_acquire); });
+		buffer = std::move(*it);
+		_trace_buffers.erase(it);
+		buffer->head.store(0, std::memory_order_relaxed);
+		buffer->writing.store(0, std::memory_order_relaxed);
+		buffer->exited.store(false, std::memory_order_relaxed);
+		buffer->cleared = 0;
+	} else {
+		buffer = std::make_unique<TraceThreadBuffer>();
+	}
+
+	buffer->tid = _trace_next_tid++;
+	buffer->thread_name = name.empty() ? fmt::format("thread {}", buffer->tid) : name.to_string();
+	return _trace_buffers.emplace_back(std::move(buffer)).get();
+}
+
+/**
+ * Record a zone in the trace of the current thread.
+ * @param name Name of the zone, this must outlive the trace.
+ * @param start Start time of the zone, from TraceTimestamp.
+ * @param end End time of the zone, from TraceTimestamp.
+ */
+void TraceRecordZone(const char *name, int64_t start, int64_t end)
+{
+	if (_trace_thread.buffer == nullptr) _trace_thread.buffer = RegisterTraceThread();
+	TraceThreadBuffer *buffer = _trace_thread.buffer;
+
+	/* Announce which slot is being overwritten before storing to it, so an export which reads any of the new values
+	 * also sees the announcement, and drops the zone it was reading from that slot; see ExportTrace. */
+	const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+	buffer->writing.store(head + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	TraceEvent &event = buffer->events[head % TRACE_THREAD_CAPACITY];
+	event.name.store(name, std::memory_order_relaxed);
+	event.start.store(start, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	buffer->head.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Start recording zones.
+ * @param newgrf Whether to also record the resolves of NewGRF sprite groups.
+ */
+void StartTrace(bool newgrf)
+{
+	_trace_newgrf_enabled.store(newgrf, std::memory_order_relaxed);
+	_trace_enabled.store(true, std::memory_order_relaxed);
+}
+
+/** Stop recording zones, zones which are in progress are still recorded when they end. */
+void StopTrace()
+{
+	_trace_enabled.store(false, std::memory_order_relaxed);
+	_trace_newgrf_enabled.store(false, std::memory_order_relaxed);
+}
+
+/** Discard the recorded zones of all threads. */
+void ClearTrace()
+{
+	std::lock_guard lock(_trace_buffers_mutex);
+	for (auto &buffer : _trace_buffers) {
+		buffer->cleared = buffer->head.load(std::memory_order_acquire);
+	}
+}
+
+/**
+ * Get a summary of the recorded trace.
+ * @return The summary.
+ */
+TraceStatus GetTraceStatus()
+{
+	TraceStatus status{ _trace_enabled.load(std::memory_order_relaxed), _trace_newgrf_enabled.load(std::memory_order_relaxed), 0, 0, 0 };
+
+	std::lock_guard lock(_trace_buffers_mutex);
+	status.threads = _trace_buffers.size();
+	for (auto &buffer : _trace_buffers) {
+		const uint64_t recorded = buffer->head.load(std::memory_order_acquire) - buffer->cleared;
+		status.recorded += recorded;
+		status.retained += std::min(recorded, TRACE_THREAD_CAPACITY);
+	}
+	return status;
+}
+
+/**
+ * Append a string to a JSON document, escaped as a JSON string.
+ * @param buffer The JSON document.
+ * @param str The string.
+ */
+static void AppendTraceJSONString(format_buffer &buffer, std::string_view str)
+{
+	buffer.push_back('"');
+	for (char c : str) {
+		if (c == '"' || c == '\\') {
+			buffer.push_back('\\');
+			buffer.push_back(c);
+		} else if (static_cast<uint8_t>(c) < 0x20) {
+			buffer.format("\\u{:04x}", static_cast<uint8_t>(c));
+		} else {
+			buffer.push_back(c);
+		}
+	}
+	buffer.push_back('"');
+}
+
+/**
+ * Export the recorded zones of all threads in the Chrome trace event format, which can be viewed in Perfetto or chrome://tracing.
+ * Recording may continue during the export, zones which may have been overwritten while they were read are dropped.
+ * @param filename The file to write.
+ * @param[out] exported The number of exported zones.
+ * @return Whether the file could be written.
+ */
+bool ExportTrace(const std::string &filename, size_t &exported)
+{
+	struct Zone {
+		const char *name;
+		int64_t start;
+		int64_t end;
+	};
+
+	exported = 0;
+	auto f = FileHandle::Open(filename, "w");
+	if (!f.has_value()) return false;
+
+	bool ok = true;
+	format_buffer buffer;
+	auto flush = [&]() {
+		if (fwrite(buffer.data(), 1, buffer.size(), *f) != buffer.size()) ok = false;
+		buffer.clear();
+	};
+
+	buffer.append("{\"traceEvents\":[\n");
+	const char *separator = "";
+
+	std::lock_guard lock(_trace_buffers_mutex);
+	std::vector<Zone> zones;
+	for (auto &thread : _trace_buffers) {
+		buffer.format("{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":", separator, thread->tid);
+		AppendTraceJSONString(buffer, thread->thread_name);
+		buffer.append("}}");
+		separator = ",\n";
+
+		const uint64_t head = thread->head.load(std::memory_order_acquire);
+		const uint64_t first = std::max(thread->cleared, head > TRACE_THREAD_CAPACITY ? head - TRACE_THREAD_CAPACITY : 0);
+		zones.clear();
+		for (uint64_t i = first; i < head; i++) {
+			const TraceEvent &event = thread->events[i % TRACE_THREAD_CAPACITY];
+			zones.push_back({ event.name.load(std::memory_order_relaxed), event.start.load(std::memory_order_relaxed), event.end.load(std::memory_order_relaxed) });
+		}
+
+		/* If any value that was read has been stored by a later recording, the fences make sure that the announcement
+		 * of that recording is seen as well. Drop every zone whose slot may have been overwritten meanwhile. */
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t writing = thread->writing.load(std::memory_order_relaxed);
+		const uint64_t valid = writing > TRACE_THREAD_CAPACITY ? writing - TRACE_THREAD_CAPACITY : 0;
+
+		for (size_t i = valid > first ? valid - first : 0; i < zones.size(); i++) {
+			const Zone &zone = zones[i];
+			buffer.append(separator);
+			buffer.append("{\"name\":");
+			AppendTraceJSONString(buffer, zone.name);
+			buffer.format(",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}", thread->tid, zone.start / 1000.0, (zone.end - zone.start) / 1000.0);
+			exported++;
+			if (buffer.size() >= 1 << 16) flush();
+		}
+	}
+
+	buffer.append("\n]}\n");
+	flush();
+	return ok;
+}
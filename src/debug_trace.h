@@ -0,0 +1,69 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file debug_trace.h Tracing of scoped zones, for export in the Chrome trace event format. */
+
+#ifndef DEBUG_TRACE_H
+#define DEBUG_TRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+extern std::atomic<bool> _trace_enabled;
+extern std::atomic<bool> _trace_newgrf_enabled;
+
+/**
+ * Get a timestamp for tracing.
+ * @return Nanoseconds since an arbitrary, steady, epoch.
+ */
+inline int64_t TraceTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TraceRecordZone(const char *name, int64_t start, int64_t end);
+
+/**
+ * Zone which is recorded in the trace of the current thread from construction to destruction, when tracing is enabled.
+ * Usage:
+ * TraceZone trace_zone("A name");
+ * --Do your code--
+ * Very frequent zones pass their own switch, such as #_trace_newgrf_enabled, so that they do not flood the trace by default.
+ */
+class TraceZone {
+	const char *name; ///< Name of the zone, this must outlive the trace, or nullptr if not tracing.
+	int64_t start;    ///< Start time of the zone.
+
+public:
+	inline TraceZone(const char *name, const std::atomic<bool> &enabled = _trace_enabled) : name(enabled.load(std::memory_order_relaxed) ? name : nullptr), start(this->name != nullptr ? TraceTimestamp() : 0) {}
+
+	inline ~TraceZone()
+	{
+		if (this->name != nullptr) TraceRecordZone(this->name, this->start, TraceTimestamp());
+	}
+
+	TraceZone(const TraceZone &) = delete;
+	TraceZone &operator=(const TraceZone &) = delete;
+};
+
+/** Summary of the recorded trace. */
+struct TraceStatus {
+	bool enabled;      ///< Whether tracing is enabled.
+	bool newgrf;       ///< Whether NewGRF resolves are traced.
+	size_t threads;    ///< Number of threads which have recorded zones.
+	uint64_t recorded; ///< Number of recorded zones.
+	uint64_t retained; ///< Number of recorded zones which have not been overwritten yet.
+};
+
+void StartTrace(bool newgrf);
+void StopTrace();
+void ClearTrace();
+TraceStatus GetTraceStatus();
+bool ExportTrace(const std::string &filename, size_t &exported);
+
+#endif /* DEBUG_TRACE_H */
@@ -37,6 +37,7 @@
 #include "industry.h"
 #include "scope.h"
 #include "debug.h"
+#include "core/hash_func.hpp"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "3rdparty/cpp-btree/btree_map.h"
 #include "3rdparty/robin_hood/robin_hood.h"
@@ -443,6 +444,36 @@ static bool IsVehicleUsableForDepartures(const Vehicle *v, DepartureCallingSetti
 	return true;
 }
 
+/** Time horizon of a live mode departure list, which also records when the list may change only because time has passed. */
+struct LiveDepartureHorizon {
+	const Ticks max_ticks;         ///< Departures scheduled more than this many ticks from now are not listed.
+	Ticks next_change = INT32_MAX; ///< Ticks from now after which a decision made on the current time may be different.
+
+	/**
+	 * Test whether a departure is scheduled too far in the future to be listed.
+	 * @param tick The scheduled tick, relative to now.
+	 * @return true if the departure is not listed.
+	 */
+	bool IsTooLate(Ticks tick)
+	{
+		if (tick <= this->max_ticks) return false;
+		this->next_change = std::min<Ticks>(this->next_change, tick - this->max_ticks);
+		return true;
+	}
+
+	/**
+	 * Test whether a tick has passed.
+	 * @param tick The tick, relative to now.
+	 * @return true if the tick is in the past.
+	 */
+	bool HasPassed(Ticks tick)
+	{
+		if (tick < 0) return true;
+		this->next_change = std::min<Ticks>(this->next_change, tick + 1);
+		return false;
+	}
+};
+
 struct LiveCandidateVehicle {
 	ScheduledDispatchVehicleRecords dispatch_records;
 	std::vector<ArrivalHistoryEntry> arrival_history;
@@ -539,7 +570,7 @@ enum class ProcessLiveDepartureCandidateVehicleResult : uint8_t {
 };
 
 static ProcessLiveDepartureCandidateVehicleResult ProcessLiveDepartureCandidateVehicle(std::vector<OrderDate> &next_orders, LiveCandidateVehicle &candidate, const DepartureOrderDestinationDetector &source, const DepartureType type,
-		DepartureCallingSettings calling_settings, const Ticks max_ticks, ScheduledDispatchCache &schdispatch_last_planned_dispatch, bool check_first_order)
+		DepartureCallingSettings calling_settings, LiveDepartureHorizon &horizon, ScheduledDispatchCache &schdispatch_last_planned_dispatch, bool check_first_order)
 {
 	const Vehicle *v = candidate.v;
 	const Order *order = candidate.order;
@@ -632,7 +663,7 @@ static ProcessLiveDepartureCandidateVehicleResult ProcessLiveDepartureCandidateV
 		}
 
 		/* If the scheduled departure date is too far in the future, stop. */
-		if (start_ticks - current_lateness > max_ticks) {
+		if (horizon.IsTooLate(start_ticks - current_lateness)) {
 			break;
 		}
 
@@ -646,7 +677,7 @@ static ProcessLiveDepartureCandidateVehicleResult ProcessLiveDepartureCandidateV
 		if ((type == D_DEPARTURE && calling_settings.IsDeparture(order, source)) ||
 				(type == D_ARRIVAL && calling_settings.IsArrival(order, source))) {
 			/* If the departure was scheduled to have already begun and has been cancelled, do not show it. */
-			if (start_ticks < 0 && status == D_CANCELLED) {
+			if (status == D_CANCELLED && horizon.HasPassed(start_ticks)) {
 				break;
 			}
 
@@ -900,7 +931,7 @@ static bool ProcessArrivalHistory(Departure *d, std::span<ArrivalHistoryEntry> a
 }
 
 static void AdvanceLiveDepartureOrderToNextCandidate(LiveQueueItem queue_item, OrderDate &lod, std::vector<LiveQueueItem> &candidate_queue, const DepartureType type,
-		DepartureOrderDestinationDetector source, DepartureCallingSettings calling_settings, const Ticks max_ticks, ScheduledDispatchCache &schdispatch_last_planned_dispatch, bool check_first_order)
+		DepartureOrderDestinationDetector source, DepartureCallingSettings calling_settings, LiveDepartureHorizon &horizon, ScheduledDispatchCache &schdispatch_last_planned_dispatch, bool check_first_order)
 {
 	const Order *order = lod.order;
 	const StateTicks state_ticks_base = _state_ticks;
@@ -973,7 +1004,7 @@ static void AdvanceLiveDepartureOrderToNextCandidate(LiveQueueItem queue_item, O
 		}
 
 		/* If the departure is scheduled to be too late, then stop. */
-		if (lod.expected_tick - lod.lateness > max_ticks) {
+		if (horizon.IsTooLate(lod.expected_tick - lod.lateness)) {
 			break;
 		}
 
@@ -1006,15 +1037,93 @@ static void AdvanceLiveDepartureOrderToNextCandidate(LiveQueueItem queue_item, O
 	}
 }
 
+/** Last generation assigned to the timetable and dispatch state of an order list, see #InvalidateDepartureScheduleState. */
+static uint64_t _departures_schedule_state_generation = 0;
+
+/**
+ * Mark that the timetable or scheduled dispatch state of the orders of a vehicle may have changed,
+ * so that cached departure lists which include the vehicles sharing these orders are recomputed.
+ * @param v the vehicle
+ */
+void InvalidateDepartureScheduleState(const Vehicle *v)
+{
+	if (v->orders != nullptr) v->orders->SetDepartureStateGeneration(++_departures_schedule_state_generation);
+}
+
+/**
+ * Get a key identifying the state which a schedule mode departure list depends on, other than the departure source and the list settings.
+ * A schedule mode list does not need to be recomputed whilst this key is unchanged.
+ * @param vehicles set of all the vehicles stopping at this station, of all vehicles types that we are interested in
+ * @param calling_settings departure calling settings
+ * @return the state key
+ */
+uint64_t GetDepartureListScheduleModeStateKey(const std::span<const Vehicle *> vehicles, DepartureCallingSettings calling_settings)
+{
+	uint64_t key = 0;
+	for (const Vehicle *veh : vehicles) {
+		if (veh->orders != nullptr) HashCombine<uint64_t>(key, veh->orders->GetDepartureStateGeneration());
+	}
+	if (_settings_time.time_in_minutes) {
+		HashCombine<uint64_t>(key, _settings_time.FromTickMinutes(_settings_time.NowInTickMinutes().ToSameDayClockTime(0, 0)).base());
+	}
+
+	/* Vehicles stopping in or leaving depots change which vehicle of a shared order list is used, without changing any orders */
+	for (const Vehicle *veh : vehicles) {
+		if (!veh->vehicle_flags.Test(VehicleFlag::ScheduledDispatch)) continue;
+
+		uint32_t usable = UINT32_MAX;
+		for (const Vehicle *u = veh->FirstShared(); u != nullptr; u = u->NextShared()) {
+			if (IsVehicleUsableForDepartures(u, calling_settings)) {
+				usable = u->index.base();
+				break;
+			}
+		}
+		HashCombine<uint64_t>(key, usable);
+	}
+
+	return key;
+}
+
+/**
+ * Get a key identifying the state which a live mode departure list depends on, other than the departure source, the list settings and the current time.
+ * Whilst this key is unchanged, a live mode list only needs to be recomputed once the tick returned by #MakeDepartureList is reached.
+ * @param vehicles set of all the vehicles stopping at this station, of all vehicles types that we are interested in
+ * @param calling_settings departure calling settings
+ * @return the state key
+ */
+uint64_t GetDepartureListLiveModeStateKey(const std::span<const Vehicle *> vehicles, DepartureCallingSettings calling_settings)
+{
+	uint64_t key = 0;
+	for (const Vehicle *v : vehicles) {
+		HashCombine<uint64_t>(key, v->index.base());
+		if (!IsVehicleUsableForDepartures(v, calling_settings)) continue;
+
+		/* The expected times are relative to the start of the current order, which does not move whilst the vehicle makes progress on it */
+		HashCombine<uint64_t>(key, v->orders != nullptr ? v->orders->GetDepartureStateGeneration() : 0);
+		HashCombine<uint64_t>(key, (_state_ticks - v->current_order_time).base());
+		HashCombine<uint64_t>(key, v->cur_real_order_index | (v->cur_implicit_order_index << 16) | ((uint64_t)v->cur_timetable_order_index << 32));
+		HashCombine<uint64_t>(key, (uint32_t)v->lateness_counter | ((uint64_t)v->vehicle_flags.base() << 32));
+		HashCombine<uint64_t>(key, v->timetable_start.base());
+		HashCombine<uint64_t>(key, static_cast<uint64_t>(v->current_order.GetType()) | (static_cast<uint64_t>(v->current_order.GetDepotActionType()) << 8));
+		for (const auto &[index, record] : v->dispatch_records) {
+			HashCombine<uint64_t>(key, index);
+			HashCombine<uint64_t>(key, record.dispatched.base());
+		}
+	}
+
+	return key;
+}
+
 /**
  * Compute an up-to-date list of departures for a station.
  * @param source the station/etc to compute the departures of
  * @param vehicles set of all the vehicles stopping at this station, of all vehicles types that we are interested in
  * @param type the type of departures to get (departures or arrivals)
  * @param calling_settings departure calling settings
+ * @param[in,out] valid_until lowered to the tick from which the list may differ only because time has passed
  * @return a list of departures, which is empty if an error occurred
  */
-static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureType type, DepartureCallingSettings calling_settings)
+static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureType type, DepartureCallingSettings calling_settings, StateTicks &valid_until)
 {
 	/* This function is the meat of the departure boards functionality. */
 	/* As an overview, it works by repeatedly considering the best possible next departure to show. */
@@ -1035,10 +1144,15 @@ static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector
 	std::vector<OrderDate> next_orders;
 
 	/* The maximum possible date for departures to be scheduled to occur. */
-	const Ticks max_ticks = GetDeparturesMaxTicksAhead();
+	LiveDepartureHorizon horizon{ GetDeparturesMaxTicksAhead() };
 
 	const StateTicks state_ticks_base = _state_ticks;
 
+	/* However the list is left, it stays valid until the earliest time based decision may change. */
+	auto guard = scope_guard([&]() {
+		if (horizon.next_change != INT32_MAX) valid_until = std::min(valid_until, state_ticks_base + horizon.next_change);
+	});
+
 	/* Cache for scheduled departure time */
 	ScheduledDispatchCache schdispatch_last_planned_dispatch;
 
@@ -1051,7 +1165,7 @@ static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector
 		PrepareLiveDepartureCandidateVehicle(candidate_vehicles, v, calling_settings);
 	}
 	for (uint i = 0; i < (uint)candidate_vehicles.size(); i++) {
-		auto result = ProcessLiveDepartureCandidateVehicle(next_orders, candidate_vehicles[i], source, type, calling_settings, max_ticks, schdispatch_last_planned_dispatch, true);
+		auto result = ProcessLiveDepartureCandidateVehicle(next_orders, candidate_vehicles[i], source, type, calling_settings, horizon, schdispatch_last_planned_dispatch, true);
 		if (result == ProcessLiveDepartureCandidateVehicleResult::EnqueueCandidateVehicle) {
 			candidate_queue.emplace_back(candidate_vehicles[i].tick, LiveQueueItem::DataType::CandidateVehicle, i);
 		}
@@ -1090,7 +1204,7 @@ static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector
 
 		if (least_item.Type() == LiveQueueItem::DataType::CandidateVehicle) {
 			LiveCandidateVehicle &lcv = candidate_vehicles[least_item.Index()];
-			auto result = ProcessLiveDepartureCandidateVehicle(next_orders, lcv, source, type, calling_settings, max_ticks, schdispatch_last_planned_dispatch, false);
+			auto result = ProcessLiveDepartureCandidateVehicle(next_orders, lcv, source, type, calling_settings, horizon, schdispatch_last_planned_dispatch, false);
 			if (result == ProcessLiveDepartureCandidateVehicleResult::EnqueueCandidateVehicle) {
 				candidate_queue.emplace_back(lcv.tick, LiveQueueItem::DataType::CandidateVehicle, least_item.Index());
 				std::push_heap(candidate_queue.begin(), candidate_queue.end());
@@ -1102,13 +1216,13 @@ static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector
 			continue;
 		} else if (least_item.Type() == LiveQueueItem::DataType::AdvanceOrder) {
 			AdvanceLiveDepartureOrderToNextCandidate(least_item, next_orders[least_item.Index()], candidate_queue,
-					type, source, calling_settings, max_ticks, schdispatch_last_planned_dispatch, false);
+					type, source, calling_settings, horizon, schdispatch_last_planned_dispatch, false);
 			continue;
 		}
 
 		OrderDate &lod = next_orders[least_item.Index()];
 
-		if (lod.expected_tick - lod.lateness > max_ticks) break;
+		if (horizon.IsTooLate(lod.expected_tick - lod.lateness)) break;
 
 		/* We already know the least order and that it's a suitable departure, so make it into a departure. */
 		std::unique_ptr<Departure> departure_ptr = std::make_unique<Departure>();
@@ -1333,7 +1447,7 @@ static DepartureList MakeDepartureListLiveMode(DepartureOrderDestinationDetector
 		lod.order_iterations_remaining = (int)order_iteration_limit;
 		lod.require_travel_time = true;
 		AdvanceLiveDepartureOrderToNextCandidate(least_item, lod, candidate_queue,
-				type, source, calling_settings, max_ticks, schdispatch_last_planned_dispatch, true);
+				type, source, calling_settings, horizon, schdispatch_last_planned_dispatch, true);
 	}
 
 	if (type == D_DEPARTURE) {
@@ -2055,17 +2169,22 @@ static DepartureList MakeDepartureListScheduleMode(DepartureOrderDestinationDete
  * @param vehicles set of all the vehicles stopping at this station, of all vehicles types that we are interested in
  * @param types the types of departures to get (departures or arrivals)
  * @param calling_settings departure calling settings
+ * @param[out] valid_until if not nullptr, set to the tick from which a live mode list may differ only because time has passed
  * @return a list of departures, which is empty if an error occurred
  */
 DepartureList MakeDepartureList(DeparturesSourceMode source_mode, DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles,
-		DepartureTypes types, DepartureCallingSettings calling_settings)
+		DepartureTypes types, DepartureCallingSettings calling_settings, StateTicks *valid_until)
 {
+	StateTicks unused_valid_until;
+	if (valid_until == nullptr) valid_until = &unused_valid_until;
+	*valid_until = STATE_TICKS_INT_MAX;
+
 	DepartureList departures;
 	DepartureList arrivals;
 	switch (source_mode) {
 		case DSM_LIVE:
-			if (types.Test(D_DEPARTURE)) departures = MakeDepartureListLiveMode(source, vehicles, D_DEPARTURE, calling_settings);
-			if (types.Test(D_ARRIVAL)) arrivals = MakeDepartureListLiveMode(source, vehicles, D_ARRIVAL, calling_settings);
+			if (types.Test(D_DEPARTURE)) departures = MakeDepartureListLiveMode(source, vehicles, D_DEPARTURE, calling_settings, *valid_until);
+			if (types.Test(D_ARRIVAL)) arrivals = MakeDepartureListLiveMode(source, vehicles, D_ARRIVAL, calling_settings, *valid_until);
 			if (departures.empty()) {
 				departures = std::move(arrivals);
 			} else if (!arrivals.empty()) {
@@ -17,8 +17,13 @@
 
 #include <vector>
 
-DepartureList MakeDepartureList(DeparturesSourceMode source_mode, DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureTypes types, DepartureCallingSettings calling_settings);
+DepartureList MakeDepartureList(DeparturesSourceMode source_mode, DepartureOrderDestinationDetector source, const std::span<const Vehicle *> vehicles, DepartureTypes types, DepartureCallingSettings calling_settings, StateTicks *valid_until = nullptr);
 
 Ticks GetDeparturesMaxTicksAhead();
 
+uint64_t GetDepartureListScheduleModeStateKey(const std::span<const Vehicle *> vehicles, DepartureCallingSettings calling_settings);
+uint64_t GetDepartureListLiveModeStateKey(const std::span<const Vehicle *> vehicles, DepartureCallingSettings calling_settings);
+
+void InvalidateDepartureScheduleState(const Vehicle *v);
+
 #endif /* DEPARTURES_FUNC_H */
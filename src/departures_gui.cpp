@@ -144,6 +144,18 @@ protected:
 	uint entry_height = 0;                      ///< The height of an entry in the departures list.
 	uint64_t elapsed_ms = 0;                    ///< The number of milliseconds that have elapsed since the window was created. Used for scrolling text.
 	int calc_tick_countdown = 0;                ///< The number of ticks to wait until recomputing the departure list. Signed in case it goes below zero.
+
+	/** State which the current departure list was computed from. */
+	struct DepartureListCacheKey {
+		DeparturesSourceMode source_mode;
+		uint64_t state;
+		DepartureTypes types;
+		DepartureCallingSettings settings;
+
+		bool operator==(const DepartureListCacheKey &) const = default;
+	};
+	std::optional<DepartureListCacheKey> list_cache_key; ///< Key of the current departure list, if it may be reused.
+	StateTicks list_valid_until{};              ///< Tick from which the current live mode departure list may change only because time has passed.
 	VehicleTypeIndexArray<bool> show_types{};   ///< The vehicle types to show in the departure list.
 	DeparturesCargoMode cargo_mode = DCF_ALL_CARGOES;
 	DeparturesMode mode = DM_DEPARTURES;
@@ -279,6 +291,7 @@ protected:
 	void RefreshVehicleList() {
 		this->FillVehicleList();
 		this->calc_tick_countdown = 0;
+		this->list_cache_key.reset();
 	}
 
 	void ConstructWidgetLayout(WindowNumber window_number)
@@ -760,6 +773,63 @@ public:
 		}
 	}
 
+	/** Recompute the list of departures, unless it can be reused. */
+	void RecomputeDepartures()
+	{
+		bool show_pax = this->cargo_mode != DCF_FREIGHT_ONLY;
+		bool show_freight = this->cargo_mode != DCF_PAX_ONLY;
+
+		DepartureOrderDestinationDetector list_source = this->source;
+		ClrBit(list_source.order_type_mask, OT_IMPLICIT); // Not interested in implicit orders in this phase
+
+		DepartureCallingSettings settings;
+		settings.SetViaMode((this->source_type != DST_STATION) || this->show_via, (this->source_type == DST_STATION) && this->show_via);
+		settings.SetDepartureNoLoadTest(this->show_empty);
+		settings.SetShowAllStops(this->show_empty);
+		settings.SetCargoFilter(show_pax, show_freight);
+		settings.SetSmartTerminusEnabled(_settings_client.gui.departure_smart_terminus && (this->source_type == DST_STATION));
+		settings.SetVehicleCycleTrackingEnabled(this->order_list_filter != nullptr && this->mode != DM_ARRIVALS && this->source_mode == DSM_SCHEDULE_24H);
+		settings.SetDispatchArrivalTicksEnabled(settings.VehicleCycleTrackingEnabled() || (this->mode == DM_COMBINED && this->source_mode == DSM_SCHEDULE_24H));
+
+		DepartureTypes types{};
+		if (this->mode != DM_ARRIVALS) {
+			types.Set(D_DEPARTURE);
+		}
+		if (this->mode == DM_ARRIVALS || this->mode == DM_SEPARATE) {
+			types.Set(D_ARRIVAL);
+		}
+
+		if (this->source_mode == DSM_SCHEDULE_24H) {
+			/* The schedule mode list only depends on orders, timetables and dispatch schedules, not on the current positions of vehicles */
+			DepartureListCacheKey key{ this->source_mode, GetDepartureListScheduleModeStateKey(this->vehicles, settings), types, settings };
+			if (!this->departures_invalid && this->list_cache_key == key) return;
+			this->list_cache_key = key;
+		} else {
+			/* The live mode list also depends on the progress of vehicles through their orders, and on time passing */
+			DepartureListCacheKey key{ this->source_mode, GetDepartureListLiveModeStateKey(this->vehicles, settings), types, settings };
+			if (!this->departures_invalid && this->list_cache_key == key && _state_ticks < this->list_valid_until) return;
+			this->list_cache_key = key;
+		}
+
+		this->departures = MakeDepartureList(this->source_mode, list_source, this->vehicles, types, settings, &this->list_valid_until);
+
+		if (this->filter_target.IsValid()) {
+			auto erase_non_matching = [&](const std::unique_ptr<Departure> &d) -> bool {
+				if (d->terminus == this->filter_target) return false;
+				for (const CallAt &c : d->calling_at) {
+					if (c.target == this->filter_target) return false;
+				}
+				return true;
+			};
+			this->departures.erase(std::remove_if(this->departures.begin(), this->departures.end(), erase_non_matching), this->departures.end());
+		}
+
+		this->departures_invalid = false;
+		this->vscroll->SetCount(this->GetScrollbarCapacity());
+		this->SetWidgetDirty(WID_DB_LIST);
+		this->SetWidgetDirty(WID_DB_SCROLLBAR);
+	}
+
 	virtual void OnGameTick() override
 	{
 		if (_pause_mode.None()) {
@@ -783,45 +853,7 @@ public:
 		/* Recompute the list of departures if we're due to. */
 		if (this->calc_tick_countdown <= 0) {
 			this->calc_tick_countdown = _settings_client.gui.departure_calc_frequency;
-			bool show_pax = this->cargo_mode != DCF_FREIGHT_ONLY;
-			bool show_freight = this->cargo_mode != DCF_PAX_ONLY;
-
-			DepartureOrderDestinationDetector list_source = this->source;
-			ClrBit(list_source.order_type_mask, OT_IMPLICIT); // Not interested in implicit orders in this phase
-
-			DepartureCallingSettings settings;
-			settings.SetViaMode((this->source_type != DST_STATION) || this->show_via, (this->source_type == DST_STATION) && this->show_via);
-			settings.SetDepartureNoLoadTest(this->show_empty);
-			settings.SetShowAllStops(this->show_empty);
-			settings.SetCargoFilter(show_pax, show_freight);
-			settings.SetSmartTerminusEnabled(_settings_client.gui.departure_smart_terminus && (this->source_type == DST_STATION));
-			settings.SetVehicleCycleTrackingEnabled(this->order_list_filter != nullptr && this->mode != DM_ARRIVALS && this->source_mode == DSM_SCHEDULE_24H);
-			settings.SetDispatchArrivalTicksEnabled(settings.VehicleCycleTrackingEnabled() || (this->mode == DM_COMBINED && this->source_mode == DSM_SCHEDULE_24H));
-
-			DepartureTypes types{};
-			if (this->mode != DM_ARRIVALS) {
-				types.Set(D_DEPARTURE);
-			}
-			if (this->mode == DM_ARRIVALS || this->mode == DM_SEPARATE) {
-				types.Set(D_ARRIVAL);
-			}
-			this->departures = MakeDepartureList(this->source_mode, list_source, this->vehicles, types, settings);
-
-			if (this->filter_target.IsValid()) {
-				auto erase_non_matching = [&](const std::unique_ptr<Departure> &d) -> bool {
-					if (d->terminus == this->filter_target) return false;
-					for (const CallAt &c : d->calling_at) {
-						if (c.target == this->filter_target) return false;
-					}
-					return true;
-				};
-				this->departures.erase(std::remove_if(this->departures.begin(), this->departures.end(), erase_non_matching), this->departures.end());
-			}
-
-			this->departures_invalid = false;
-			this->vscroll->SetCount(this->GetScrollbarCapacity());
-			this->SetWidgetDirty(WID_DB_LIST);
-			this->SetWidgetDirty(WID_DB_SCROLLBAR);
+			this->RecomputeDepartures();
 		}
 
 		uint new_width = this->GetMinWidth();
@@ -876,6 +908,7 @@ public:
 		this->vehicles_invalid = true;
 		this->departures_invalid = true;
 		this->calc_tick_countdown = 0;
+		this->list_cache_key.reset();
 		if (data > 0) {
 			if (!_settings_time.time_in_minutes && this->source_mode == DSM_SCHEDULE_24H) {
 				this->source_mode = DSM_LIVE;
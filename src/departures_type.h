@@ -215,6 +215,8 @@ public:
 	inline bool DispatchArrivalTicksEnabled() const { return HasBit(this->flags, FlagBits::DispatchArrivalTicksEnabled); }
 	inline bool VehicleCycleTrackingEnabled() const { return HasBit(this->flags, FlagBits::VehicleCycleTrackingEnabled); }
 
+	bool operator==(const DepartureCallingSettings &) const = default;
+
 	inline void SetViaMode(bool allow_via, bool check_show_as_via_type)
 	{
 		AssignBit(this->flags, FlagBits::AllowVia, allow_via);
@@ -1038,6 +1038,8 @@ void DeterminePaths(const char *exe, bool only_local_path)
 	_windows_file = config_dir + "windows.cfg";
 	extern std::string _private_file;
 	_private_file = config_dir + "private.cfg";
+	extern std::string _grf_sprite_offset_cache_file;
+	_grf_sprite_offset_cache_file = config_dir + "grf_sprite_offsets.dat";
 	extern std::string _secrets_file;
 	_secrets_file = config_dir + "secrets.cfg";
 	extern std::string _favs_file;
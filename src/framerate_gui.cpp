@@ -28,11 +28,14 @@
 #include "timer/timer.h"
 #include "timer/timer_window.h"
 #include "zoom_func.h"
+#include "survey.h"
+#include "debug_trace.h"
 
 #include "widgets/framerate_widget.h"
 
 #include <atomic>
 #include <mutex>
+#include <numeric>
 #include <vector>
 
 #include "table/strings.h"
@@ -248,6 +251,56 @@ namespace {
 		PerformanceData(1),                     // PFE_AI14
 	};
 
+	/** Names of the performance elements in benchmark reports and traces */
+	const std::array<const char *, PFE_MAX> _pf_element_names = {
+		"game_loop",
+		"gl_economy",
+		"gl_trains",
+		"gl_road_vehicles",
+		"gl_ships",
+		"gl_aircraft",
+		"gl_landscape",
+		"gl_link_graph",
+		"drawing",
+		"draw_world",
+		"video",
+		"sound",
+		"all_scripts",
+		"game_script",
+		"ai_1",
+		"ai_2",
+		"ai_3",
+		"ai_4",
+		"ai_5",
+		"ai_6",
+		"ai_7",
+		"ai_8",
+		"ai_9",
+		"ai_10",
+		"ai_11",
+		"ai_12",
+		"ai_13",
+		"ai_14",
+		"ai_15",
+	};
+
+	/** Every duration of each performance element recorded since the benchmark was started, empty when no benchmark is running */
+	std::vector<std::vector<TimingMeasurement>> _pf_benchmark_durations;
+	/** Start time of the running benchmark */
+	TimingMeasurement _pf_benchmark_start = 0;
+
+	/**
+	 * Record a duration of a performance element for the running benchmark, if any.
+	 * @param elem The element.
+	 * @param start_time The start of the measurement.
+	 * @param duration The duration.
+	 */
+	inline void RecordBenchmarkDuration(PerformanceElement elem, TimingMeasurement start_time, TimingMeasurement duration)
+	{
+		if (_pf_benchmark_durations.empty() || start_time < _pf_benchmark_start) return;
+		_pf_benchmark_durations[elem].push_back(duration);
+	}
+
 }
 
 
@@ -274,11 +327,13 @@ PerformanceMeasurer::PerformanceMeasurer(PerformanceElement elem)
 
 	this->elem = elem;
 	this->start_time = GetPerformanceTimer();
+	this->trace_start = _trace_enabled.load(std::memory_order_relaxed) ? TraceTimestamp() : 0;
 }
 
 /** Finish a cycle of a measured element and store the measurement taken. */
 PerformanceMeasurer::~PerformanceMeasurer()
 {
+	if (this->trace_start != 0) TraceRecordZone(_pf_element_names[this->elem], this->trace_start, TraceTimestamp());
 	if (this->elem == PFE_ALLSCRIPTS) {
 		/* Hack to not record scripts total when no scripts are active */
 		bool any_active = _pf_data[PFE_GAMESCRIPT].num_valid > 0;
@@ -297,7 +352,9 @@ PerformanceMeasurer::~PerformanceMeasurer()
 		_sound_perf_pending.store(true, std::memory_order_release);
 		return;
 	}
-	_pf_data[this->elem].Add(this->start_time, GetPerformanceTimer());
+	const TimingMeasurement end_time = GetPerformanceTimer();
+	_pf_data[this->elem].Add(this->start_time, end_time);
+	RecordBenchmarkDuration(this->elem, this->start_time, end_time - this->start_time);
 }
 
 /**
@@ -340,11 +397,13 @@ PerformanceAccumulator::PerformanceAccumulator(PerformanceElement elem)
 
 	this->elem = elem;
 	this->start_time = GetPerformanceTimer();
+	this->trace_start = _trace_enabled.load(std::memory_order_relaxed) ? TraceTimestamp() : 0;
 }
 
 /** Finish and add one block of the accumulating value. */
 PerformanceAccumulator::~PerformanceAccumulator()
 {
+	if (this->trace_start != 0) TraceRecordZone(_pf_element_names[this->elem], this->trace_start, TraceTimestamp());
 	_pf_data[this->elem].AddAccumulate(GetPerformanceTimer() - this->start_time);
 }
 
@@ -355,7 +414,58 @@ PerformanceAccumulator::~PerformanceAccumulator()
  */
 void PerformanceAccumulator::Reset(PerformanceElement elem)
 {
-	_pf_data[elem].BeginAccumulate(GetPerformanceTimer());
+	PerformanceData &pf = _pf_data[elem];
+	RecordBenchmarkDuration(elem, pf.acc_timestamp, pf.acc_duration);
+	pf.BeginAccumulate(GetPerformanceTimer());
+}
+
+/**
+ * Start recording every measurement of the performance elements, for a benchmark report.
+ * Measurements of an element may be made on any thread, as long as only one thread at a time measures that
+ * element; e.g. the AIs measured on the worker threads by AI::GameLoop. The sound, measured on the mixer thread,
+ * is not recorded.
+ * @see SurveyPerformanceBenchmark
+ */
+void StartPerformanceBenchmark()
+{
+	_pf_benchmark_durations.assign(PFE_MAX, {});
+	_pf_benchmark_start = GetPerformanceTimer();
+}
+
+/**
+ * Stop the running benchmark, and convert the statistics of the measurements of each performance element to JSON.
+ * @param survey The JSON object.
+ */
+void SurveyPerformanceBenchmark(nlohmann::json &survey)
+{
+	if (_pf_benchmark_durations.empty()) return;
+
+	auto to_ms = [](TimingMeasurement duration) -> double {
+		return duration * 1000.0 / TIMESTAMP_PRECISION;
+	};
+
+	for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
+		std::vector<TimingMeasurement> &durations = _pf_benchmark_durations[e];
+		if (durations.empty()) continue;
+
+		std::sort(durations.begin(), durations.end());
+		const TimingMeasurement total = std::accumulate(durations.begin(), durations.end(), TimingMeasurement{0});
+		auto percentile = [&](uint p) -> double {
+			return to_ms(durations[(durations.size() - 1) * p / 100]);
+		};
+
+		auto &element = survey[_pf_element_names[e]];
+		element["count"] = durations.size();
+		element["total_ms"] = to_ms(total);
+		element["mean_ms"] = to_ms(total) / durations.size();
+		element["min_ms"] = to_ms(durations.front());
+		element["p50_ms"] = percentile(50);
+		element["p90_ms"] = percentile(90);
+		element["p99_ms"] = percentile(99);
+		element["max_ms"] = to_ms(durations.back());
+	}
+
+	_pf_benchmark_durations.clear();
 }
 
 
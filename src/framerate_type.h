@@ -91,6 +91,7 @@ typedef uint64_t TimingMeasurement;
 class PerformanceMeasurer {
 	PerformanceElement elem;
 	TimingMeasurement start_time;
+	int64_t trace_start; ///< Start time of the trace zone, or 0 if not tracing.
 public:
 	PerformanceMeasurer(PerformanceElement elem);
 	~PerformanceMeasurer();
@@ -113,6 +114,7 @@ public:
 class PerformanceAccumulator {
 	PerformanceElement elem;
 	TimingMeasurement start_time;
+	int64_t trace_start; ///< Start time of the trace zone, or 0 if not tracing.
 public:
 	PerformanceAccumulator(PerformanceElement elem);
 	~PerformanceAccumulator();
@@ -121,5 +123,6 @@ public:
 
 void ShowFramerateWindow();
 void ProcessPendingPerformanceMeasurements();
+void StartPerformanceBenchmark();
 
 #endif /* FRAMERATE_TYPE_H */
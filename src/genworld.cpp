@@ -77,6 +77,9 @@ struct GenWorldInfo {
 /** Whether we are generating the map or not. */
 bool _generating_world;
 
+/** Whether to generate parts of the world on the worker pool; this gives a different map for the same seed. */
+bool _parallel_world_generation = false;
+
 extern bool _town_noise_no_update;
 
 class AbortGenerateWorldSignal { };
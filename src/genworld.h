@@ -98,5 +98,6 @@ void ShowCreateScenario();
 void StartScenarioEditor();
 
 extern bool _generating_world;
+extern bool _parallel_world_generation;
 
 #endif /* GENWORLD_H */
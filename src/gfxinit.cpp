@@ -284,6 +284,7 @@ static void RealChangeBlitter(std::string_view repl_blitter)
 	if (cur_blitter == repl_blitter) return;
 
 	Debug(driver, 1, "Switching blitter from '{}' to '{}'... ", cur_blitter, repl_blitter);
+	StopSpriteCachePreload();
 	Blitter *new_blitter = BlitterFactory::SelectBlitter(repl_blitter);
 	if (new_blitter == nullptr) NOT_REACHED();
 	Debug(driver, 1, "Successfully switched to {}.", repl_blitter);
@@ -336,9 +337,11 @@ static bool SwitchNewGRFBlitter()
 		{ "8bpp-optimized",  2,  8,  8,  8,  8 },
 		{ "40bpp-anim",      2,  8, 32,  8, 32 },
 #ifdef WITH_SSE
+		{ "32bpp-avx2",      0, 32, 32,  8, 32 },
 		{ "32bpp-sse4",      0, 32, 32,  8, 32 },
 		{ "32bpp-ssse3",     0, 32, 32,  8, 32 },
 		{ "32bpp-sse2",      0, 32, 32,  8, 32 },
+		{ "32bpp-avx2-anim", 1, 32, 32,  8, 32 },
 		{ "32bpp-sse4-anim", 1, 32, 32,  8, 32 },
 #endif
 		{ "32bpp-optimized", 0,  8, 32,  8, 32 },
@@ -478,8 +481,10 @@ void GfxLoadSprites()
 	GfxInitSpriteMem();
 	GfxInitPalettes();
 	LoadSpriteTables();
+	SaveGRFSpriteOffsetCache();
 	GfxClearSpriteCacheLoadIndex();
 	GfxDetermineMainColours();
+	StartSpriteCachePreload();
 
 	extern void UpdateRouteStepSpriteSize();
 	UpdateRouteStepSpriteSize();
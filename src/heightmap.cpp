@@ -19,6 +19,7 @@
 #include "fios.h"
 #include "fileio_func.h"
 #include "core/random_func.hpp"
+#include "worker_thread.h"
 
 #include "table/strings.h"
 
@@ -78,79 +79,316 @@ static inline uint8_t RGBToGreyscale(uint8_t red, uint8_t green, uint8_t blue)
 }
 
 
-#ifdef WITH_PNG
-
 /**
- * The PNG Heightmap loader.
- * @param map The map to write data to.
- * @param png_ptr The PNG file to load.
- * @param info_ptr Metadata about the loaded PNG.
+ * Scales the rows of a greyscale heightmap image onto the tile heights of the map.
+ * The image is supplied in bands of consecutive rows from the top down. The map rows
+ * which sample a band are written when the band is supplied, in parallel, so the whole
+ * image does not need to be in memory at once.
  */
-static void ReadHeightmapPNGImageData(std::span<uint8_t> map, png_structp png_ptr, png_infop info_ptr)
-{
-	uint x, y;
-	uint8_t gray_palette[256];
-	png_bytep *row_pointers = nullptr;
-	bool has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
-	uint channels = png_get_channels(png_ptr, info_ptr);
-
-	/* Get palette and convert it to greyscale */
-	if (has_palette) {
-		int i;
-		int palette_size;
-		png_color *palette;
-		bool all_gray = true;
+class HeightmapScaler {
+	/* Defines the detail of the aspect ratio (to avoid doubles) */
+	static constexpr uint NUM_DIV = 16384;
+	/* Ensure multiplication with NUM_DIV does not cause overflows. */
+	static_assert(NUM_DIV <= std::numeric_limits<uint>::max() / MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS);
+
+	uint img_width;    ///< Width of the image in pixels.
+	uint img_height;   ///< Height of the image in pixels.
+	uint max_value;    ///< Greyscale value of the highest points of the image.
+	uint width;        ///< Length of the map rows, after rotation.
+	uint height;       ///< Number of map rows, after rotation.
+	uint row_pad = 0;  ///< Number of padding rows at either side.
+	uint col_pad = 0;  ///< Number of padding columns at either side.
+	uint img_scale;    ///< Scale of the map relative to the image, in 1/NUM_DIV.
+	uint next_row = 0; ///< First map row that has not been written yet.
+
+	bool IsPaddingRow(uint row) const
+	{
+		return (row < this->row_pad) || (row >= (this->height - this->row_pad - (_settings_game.construction.freeform_edges ? 0 : 1)));
+	}
+
+	uint GetImageRow(uint row) const
+	{
+		return ((row - this->row_pad) * NUM_DIV) / this->img_scale;
+	}
+
+	/**
+	 * Write the tile heights of one map row.
+	 * @param row The map row.
+	 * @param band The supplied band of image rows.
+	 * @param band_start The image row of the start of \a band.
+	 */
+	template <typename T>
+	void WriteRow(uint row, std::span<const T> band, uint band_start) const
+	{
+		const HeightmapRotation rotation = static_cast<HeightmapRotation>(_settings_game.game_creation.heightmap_rotation);
+		const bool freeform_edges = _settings_game.construction.freeform_edges;
+		const bool padding_row = this->IsPaddingRow(row);
+
+		for (uint col = 0; col < this->width; col++) {
+			TileIndex tile;
+			switch (rotation) {
+				default: NOT_REACHED();
+				case HM_COUNTER_CLOCKWISE: tile = TileXY(col, row); break;
+				case HM_CLOCKWISE:         tile = TileXY(row, col); break;
+			}
+
+			/* Check if current tile is within the 1-pixel map edge or padding regions */
+			if ((!freeform_edges && DistanceFromEdge(tile) <= 1) || padding_row ||
+					(col < this->col_pad) || (col >= (this->width - this->col_pad - (freeform_edges ? 0 : 1)))) {
+				SetTileHeight(tile, 0);
+			} else {
+				/* Use nearest neighbour resizing to scale map data.
+				 *  We rotate the map 45 degrees (counter)clockwise */
+				const uint img_row = this->GetImageRow(row);
+				uint img_col;
+				switch (rotation) {
+					default: NOT_REACHED();
+					case HM_COUNTER_CLOCKWISE:
+						img_col = (((this->width - 1 - col - this->col_pad) * NUM_DIV) / this->img_scale);
+						break;
+					case HM_CLOCKWISE:
+						img_col = (((col - this->col_pad) * NUM_DIV) / this->img_scale);
+						break;
+				}
 
-		png_get_PLTE(png_ptr, info_ptr, &palette, &palette_size);
-		for (i = 0; i < palette_size && (palette_size != 16 || all_gray); i++) {
-			all_gray &= palette[i].red == palette[i].green && palette[i].red == palette[i].blue;
-			gray_palette[i] = RGBToGreyscale(palette[i].red, palette[i].green, palette[i].blue);
+				assert(img_row < this->img_height);
+				assert(img_col < this->img_width);
+				assert(img_row >= band_start && (img_row - band_start + 1) * static_cast<size_t>(this->img_width) <= band.size());
+
+				uint heightmap_height = band[(img_row - band_start) * static_cast<size_t>(this->img_width) + img_col];
+
+				if (heightmap_height > 0) {
+					/* 0 is sea level.
+					 * Other grey scales are scaled evenly to the available height levels > 0.
+					 * (The coastline is independent from the number of height levels) */
+					heightmap_height = 1 + (heightmap_height - 1) * _settings_game.game_creation.heightmap_height / this->max_value;
+				}
+
+				SetTileHeight(tile, heightmap_height);
+			}
+			/* Only clear the tiles within the map area. */
+			if (IsInnerTile(tile)) {
+				MakeClear(tile, ClearGround::Grass, 3);
+			}
 		}
+	}
+
+public:
+	/**
+	 * Prepare the map for a heightmap image.
+	 * @param img_width The width of the image in pixels.
+	 * @param img_height The height of the image in pixels.
+	 * @param max_value The greyscale value of the highest points of the image, 255 or 65535.
+	 */
+	HeightmapScaler(uint img_width, uint img_height, uint max_value) : img_width(img_width), img_height(img_height), max_value(max_value)
+	{
+		/* Get map size and calculate scale and padding values */
+		switch (_settings_game.game_creation.heightmap_rotation) {
+			default: NOT_REACHED();
+			case HM_COUNTER_CLOCKWISE:
+				this->width  = Map::SizeX();
+				this->height = Map::SizeY();
+				break;
+			case HM_CLOCKWISE:
+				this->width  = Map::SizeY();
+				this->height = Map::SizeX();
+				break;
+		}
+
+		if ((img_width * NUM_DIV) / img_height > ((this->width * NUM_DIV) / this->height)) {
+			/* Image is wider than map - center vertically */
+			this->img_scale = (this->width * NUM_DIV) / img_width;
+			this->row_pad = (1 + this->height - ((img_height * this->img_scale) / NUM_DIV)) / 2;
+		} else {
+			/* Image is taller than map - center horizontally */
+			this->img_scale = (this->height * NUM_DIV) / img_height;
+			this->col_pad = (1 + this->width - ((img_width * this->img_scale) / NUM_DIV)) / 2;
+		}
+
+		if (_settings_game.construction.freeform_edges) {
+			for (uint x = 0; x < Map::SizeX(); x++) MakeVoid(TileXY(x, 0));
+			for (uint y = 0; y < Map::SizeY(); y++) MakeVoid(TileXY(0, y));
+		}
+	}
+
+	/**
+	 * Supply the next band of image rows, and write all map rows which are sampled from it or from earlier rows.
+	 * @param band_start The image row of the start of \a band, all earlier rows must have been supplied.
+	 * @param band The greyscale values of the rows, in row major order.
+	 */
+	template <typename T>
+	void AddRows(uint band_start, std::span<const T> band)
+	{
+		const uint band_end = band_start + static_cast<uint>(band.size() / this->img_width);
+
+		uint end_row = this->next_row;
+		while (end_row < this->height && (this->IsPaddingRow(end_row) || this->GetImageRow(end_row) < band_end)) end_row++;
+
+		const uint first_row = this->next_row;
+		_general_worker_pool.ParallelFor(end_row - first_row, [&](uint i) {
+			this->WriteRow(first_row + i, band, band_start);
+		});
+		this->next_row = end_row;
+	}
+
+	/** Write the map rows after the last sampled image row. */
+	void Finish()
+	{
+		for (; this->next_row < this->height; this->next_row++) {
+			this->WriteRow<uint8_t>(this->next_row, {}, this->img_height);
+		}
+	}
+};
 
-		/**
-		 * For a non-gray palette of size 16 we assume that
-		 * the order of the palette determines the height;
-		 * the first entry is the sea (level 0), the second one
-		 * level 1, etc.
-		 */
-		if (palette_size == 16 && !all_gray) {
-			for (i = 0; i < palette_size; i++) {
-				gray_palette[i] = 256 * i / palette_size;
+#ifdef WITH_PNG
+
+/** Conversion of the rows of a PNG heightmap to greyscale. */
+struct HeightmapPNGRowConverter {
+	uint8_t gray_palette[256]; ///< Greyscale value of each palette entry.
+	bool has_palette;          ///< Whether the image is indexed.
+	uint channels;             ///< Number of channels of the read rows.
+	bool is_16bit;             ///< Whether the read rows have 16-bit samples.
+
+	/**
+	 * Prepare the conversion of the rows of a PNG file.
+	 * @param png_ptr The PNG file to load.
+	 * @param info_ptr Metadata about the loaded PNG, with the transformations applied.
+	 */
+	HeightmapPNGRowConverter(png_structp png_ptr, png_infop info_ptr)
+	{
+		this->has_palette = png_get_color_type(png_ptr, info_ptr) == PNG_COLOR_TYPE_PALETTE;
+		this->channels = png_get_channels(png_ptr, info_ptr);
+		this->is_16bit = png_get_bit_depth(png_ptr, info_ptr) == 16;
+
+		/* Get palette and convert it to greyscale */
+		if (this->has_palette) {
+			int i;
+			int palette_size;
+			png_color *palette;
+			bool all_gray = true;
+
+			png_get_PLTE(png_ptr, info_ptr, &palette, &palette_size);
+			for (i = 0; i < palette_size && (palette_size != 16 || all_gray); i++) {
+				all_gray &= palette[i].red == palette[i].green && palette[i].red == palette[i].blue;
+				this->gray_palette[i] = RGBToGreyscale(palette[i].red, palette[i].green, palette[i].blue);
+			}
+
+			/**
+			 * For a non-gray palette of size 16 we assume that
+			 * the order of the palette determines the height;
+			 * the first entry is the sea (level 0), the second one
+			 * level 1, etc.
+			 */
+			if (palette_size == 16 && !all_gray) {
+				for (i = 0; i < palette_size; i++) {
+					this->gray_palette[i] = 256 * i / palette_size;
+				}
 			}
 		}
 	}
 
-	row_pointers = png_get_rows(png_ptr, info_ptr);
+	/** Greyscale value of the highest points of the image. */
+	uint MaxValue() const
+	{
+		return this->is_16bit ? UINT16_MAX : UINT8_MAX;
+	}
 
-	/* Read the raw image data and convert in 8-bit greyscale */
-	for (x = 0; x < png_get_image_width(png_ptr, info_ptr); x++) {
-		for (y = 0; y < png_get_image_height(png_ptr, info_ptr); y++) {
-			uint8_t *pixel = &map[y * png_get_image_width(png_ptr, info_ptr) + x];
-			uint x_offset = x * channels;
-
-			if (has_palette) {
-				*pixel = gray_palette[row_pointers[y][x_offset]];
-			} else if (channels == 3) {
-				*pixel = RGBToGreyscale(row_pointers[y][x_offset + 0],
-						row_pointers[y][x_offset + 1], row_pointers[y][x_offset + 2]);
+	/**
+	 * Convert a raw image row to greyscale.
+	 * @param dst The greyscale values.
+	 * @param row The raw row data.
+	 */
+	void Convert(std::span<uint16_t> dst, png_const_bytep row) const
+	{
+		for (uint x = 0; x < dst.size(); x++) {
+			if (this->has_palette) {
+				dst[x] = this->gray_palette[row[x]];
+			} else if (this->is_16bit) {
+				/* Samples are big endian, 16-bit images are always greyscale. */
+				dst[x] = (row[x * 2] << 8) | row[(x * 2) + 1];
+			} else if (this->channels == 3) {
+				dst[x] = RGBToGreyscale(row[x * 3], row[(x * 3) + 1], row[(x * 3) + 2]);
 			} else {
-				*pixel = row_pointers[y][x_offset];
+				dst[x] = row[x];
 			}
 		}
 	}
+};
+
+/**
+ * Read rows of a PNG file.
+ * This is separate from the callers so that libpng errors do not skip any destructors.
+ * @param png_ptr The PNG file to load.
+ * @param rows Destination of the rows.
+ * @param count Number of rows, or 0 to read the whole (interlaced) image.
+ * @return Whether reading was successful.
+ */
+static bool ReadHeightmapPNGRows(png_structp png_ptr, png_bytepp rows, uint count)
+{
+	if (setjmp(png_jmpbuf(png_ptr))) return false;
+
+	if (count == 0) {
+		png_read_image(png_ptr, rows);
+	} else {
+		png_read_rows(png_ptr, rows, nullptr, count);
+	}
+	return true;
+}
+
+/**
+ * The PNG Heightmap loader.
+ * Non-interlaced images are read and scaled in bands of rows.
+ * @param png_ptr The PNG file to load.
+ * @param info_ptr Metadata about the loaded PNG, with the transformations applied.
+ * @return Whether reading was successful.
+ */
+static bool ReadHeightmapPNGImageData(png_structp png_ptr, png_infop info_ptr)
+{
+	/* Number of image rows which are read and scaled at once. */
+	static constexpr uint BAND_ROWS = 256;
+
+	const HeightmapPNGRowConverter converter(png_ptr, info_ptr);
+	const uint width = png_get_image_width(png_ptr, info_ptr);
+	const uint height = png_get_image_height(png_ptr, info_ptr);
+	const bool interlaced = png_get_interlace_type(png_ptr, info_ptr) != PNG_INTERLACE_NONE;
+	const size_t row_bytes = png_get_rowbytes(png_ptr, info_ptr);
+
+	/* Interlaced images need all rows to be present to read any of them. */
+	const uint band_rows = interlaced ? height : std::min(BAND_ROWS, height);
+
+	std::vector<png_byte> raw(row_bytes * band_rows);
+	std::vector<png_bytep> raw_rows(band_rows);
+	for (uint i = 0; i < band_rows; i++) raw_rows[i] = raw.data() + (i * row_bytes);
+	std::vector<uint16_t> band(static_cast<size_t>(width) * band_rows);
+
+	if (interlaced && !ReadHeightmapPNGRows(png_ptr, raw_rows.data(), 0)) return false;
+
+	HeightmapScaler scaler(width, height, converter.MaxValue());
+	for (uint band_start = 0; band_start < height; band_start += band_rows) {
+		const uint count = std::min(band_rows, height - band_start);
+		if (!interlaced && !ReadHeightmapPNGRows(png_ptr, raw_rows.data(), count)) return false;
+
+		for (uint i = 0; i < count; i++) {
+			const uint raw_row = interlaced ? band_start + i : i;
+			converter.Convert(std::span(band).subspan(static_cast<size_t>(i) * width, width), raw_rows[raw_row]);
+		}
+		scaler.AddRows<uint16_t>(band_start, std::span(band).first(static_cast<size_t>(count) * width));
+	}
+	scaler.Finish();
+
+	return true;
 }
 
 /**
  * Reads the heightmap and/or size of the heightmap from a PNG file.
- * If map == nullptr only the size of the PNG is read, otherwise a map
- * with greyscale pixels is allocated and assigned to *map.
+ * If load is set, the map is also set to the scaled heightmap.
  * @param filename Name of the file to load.
  * @param[out] x Length of the image.
  * @param[out] y Height of the image.
- * @param[in,out] map If not \c nullptr, destination to store the loaded block of image data.
+ * @param load Whether to load the heightmap onto the map.
  * @return Whether loading was successful.
  */
-static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::vector<uint8_t> *map)
+static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, bool load)
 {
 	png_structp png_ptr = nullptr;
 	png_infop info_ptr  = nullptr;
@@ -175,15 +413,21 @@ static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::v
 	}
 
 	png_init_io(png_ptr, *fp);
+	png_read_info(png_ptr, info_ptr);
 
-	/* Allocate memory and read image, without alpha or 16-bit samples
-	 * (result is either 8-bit indexed/greyscale or 24-bit RGB) */
+	/* Read without alpha, 16-bit samples are only kept for greyscale images
+	 * (result is either 8-bit indexed/greyscale, 16-bit greyscale or 24-bit RGB) */
 	png_set_packing(png_ptr);
-	png_read_png(png_ptr, info_ptr, PNG_TRANSFORM_PACKING | PNG_TRANSFORM_STRIP_ALPHA | PNG_TRANSFORM_STRIP_16, nullptr);
+	png_set_strip_alpha(png_ptr);
+	if ((png_get_color_type(png_ptr, info_ptr) & PNG_COLOR_MASK_COLOR) != 0) png_set_strip_16(png_ptr);
+	png_set_interlace_handling(png_ptr);
+	png_read_update_info(png_ptr, info_ptr);
 
 	/* Maps of wrong colour-depth are not used.
-	 * (this should have been taken care of by stripping alpha and 16-bit samples on load) */
-	if ((png_get_channels(png_ptr, info_ptr) != 1) && (png_get_channels(png_ptr, info_ptr) != 3) && (png_get_bit_depth(png_ptr, info_ptr) != 8)) {
+	 * (this should have been taken care of by the transformations) */
+	const uint channels = png_get_channels(png_ptr, info_ptr);
+	const uint bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+	if (!((channels == 1 || channels == 3) && bit_depth == 8) && !(channels == 1 && bit_depth == 16)) {
 		ShowErrorMessage(GetEncodedString(STR_ERROR_PNGMAP), GetEncodedString(STR_ERROR_PNGMAP_IMAGE_TYPE), WarningLevel::Error);
 		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
 		return false;
@@ -198,9 +442,10 @@ static bool ReadHeightmapPNG(std::string_view filename, uint *x, uint *y, std::v
 		return false;
 	}
 
-	if (map != nullptr) {
-		map->resize(static_cast<size_t>(width) * height);
-		ReadHeightmapPNGImageData(*map, png_ptr, info_ptr);
+	if (load && !ReadHeightmapPNGImageData(png_ptr, info_ptr)) {
+		ShowErrorMessage(GetEncodedString(STR_ERROR_PNGMAP), GetEncodedString(STR_ERROR_PNGMAP_MISC), WarningLevel::Error);
+		png_destroy_read_struct(&png_ptr, &info_ptr, nullptr);
+		return false;
 	}
 
 	*x = width;
@@ -271,15 +516,14 @@ static void ReadHeightmapBMPImageData(std::span<uint8_t> map, const BmpInfo &inf
 
 /**
  * Reads the heightmap and/or size of the heightmap from a BMP file.
- * If map == nullptr only the size of the BMP is read, otherwise a map
- * with greyscale pixels is allocated and assigned to *map.
+ * If load is set, the map is also set to the scaled heightmap.
  * @param filename Name of the file to load.
  * @param[out] x Length of the image.
  * @param[out] y Height of the image.
- * @param[in,out] map If not \c nullptr, destination to store the loaded block of image data.
+ * @param load Whether to load the heightmap onto the map.
  * @return Whether loading was successful.
  */
-static bool ReadHeightmapBMP(std::string_view filename, uint *x, uint *y, std::vector<uint8_t> *map)
+static bool ReadHeightmapBMP(std::string_view filename, uint *x, uint *y, bool load)
 {
 	auto f = FioFOpenFile(filename, "rb", Subdirectory::Heightmap);
 	if (!f.has_value()) {
@@ -301,14 +545,20 @@ static bool ReadHeightmapBMP(std::string_view filename, uint *x, uint *y, std::v
 		return false;
 	}
 
-	if (map != nullptr) {
+	if (load) {
 		if (!BmpReadBitmap(file, info, data)) {
 			ShowErrorMessage(GetEncodedString(STR_ERROR_BMPMAP), GetEncodedString(STR_ERROR_BMPMAP_IMAGE_TYPE), WarningLevel::Error);
 			return false;
 		}
 
-		map->resize(static_cast<size_t>(info.width) * info.height);
-		ReadHeightmapBMPImageData(*map, info, data);
+		/* BMP rows are usually stored bottom up, so the image is converted as a whole. */
+		std::vector<uint8_t> map(static_cast<size_t>(info.width) * info.height);
+		ReadHeightmapBMPImageData(map, info, data);
+		data = {};
+
+		HeightmapScaler scaler(info.width, info.height, UINT8_MAX);
+		scaler.AddRows<uint8_t>(0, map);
+		scaler.Finish();
 	}
 
 	*x = info.width;
@@ -317,105 +567,6 @@ static bool ReadHeightmapBMP(std::string_view filename, uint *x, uint *y, std::v
 	return true;
 }
 
-/**
- * Converts a given greyscale map to something that fits in OTTD map system
- * and create a map of that data.
- * @param img_width  the with of the image in pixels/tiles
- * @param img_height the height of the image in pixels/tiles
- * @param map        the input map
- */
-static void GreyscaleToMapHeights(uint img_width, uint img_height, std::span<const uint8_t> map)
-{
-	/* Defines the detail of the aspect ratio (to avoid doubles) */
-	const uint num_div = 16384;
-	/* Ensure multiplication with num_div does not cause overflows. */
-	static_assert(num_div <= std::numeric_limits<uint>::max() / MAX_HEIGHTMAP_SIDE_LENGTH_IN_PIXELS);
-
-	uint width, height;
-	uint row, col;
-	uint row_pad = 0, col_pad = 0;
-	uint img_scale;
-	uint img_row, img_col;
-	TileIndex tile;
-
-	/* Get map size and calculate scale and padding values */
-	switch (_settings_game.game_creation.heightmap_rotation) {
-		default: NOT_REACHED();
-		case HM_COUNTER_CLOCKWISE:
-			width   = Map::SizeX();
-			height  = Map::SizeY();
-			break;
-		case HM_CLOCKWISE:
-			width   = Map::SizeY();
-			height  = Map::SizeX();
-			break;
-	}
-
-	if ((img_width * num_div) / img_height > ((width * num_div) / height)) {
-		/* Image is wider than map - center vertically */
-		img_scale = (width * num_div) / img_width;
-		row_pad = (1 + height - ((img_height * img_scale) / num_div)) / 2;
-	} else {
-		/* Image is taller than map - center horizontally */
-		img_scale = (height * num_div) / img_height;
-		col_pad = (1 + width - ((img_width * img_scale) / num_div)) / 2;
-	}
-
-	if (_settings_game.construction.freeform_edges) {
-		for (uint x = 0; x < Map::SizeX(); x++) MakeVoid(TileXY(x, 0));
-		for (uint y = 0; y < Map::SizeY(); y++) MakeVoid(TileXY(0, y));
-	}
-
-	/* Form the landscape */
-	for (row = 0; row < height; row++) {
-		for (col = 0; col < width; col++) {
-			switch (_settings_game.game_creation.heightmap_rotation) {
-				default: NOT_REACHED();
-				case HM_COUNTER_CLOCKWISE: tile = TileXY(col, row); break;
-				case HM_CLOCKWISE:         tile = TileXY(row, col); break;
-			}
-
-			/* Check if current tile is within the 1-pixel map edge or padding regions */
-			if ((!_settings_game.construction.freeform_edges && DistanceFromEdge(tile) <= 1) ||
-					(row < row_pad) || (row >= (height - row_pad - (_settings_game.construction.freeform_edges ? 0 : 1))) ||
-					(col < col_pad) || (col >= (width  - col_pad - (_settings_game.construction.freeform_edges ? 0 : 1)))) {
-				SetTileHeight(tile, 0);
-			} else {
-				/* Use nearest neighbour resizing to scale map data.
-				 *  We rotate the map 45 degrees (counter)clockwise */
-				img_row = (((row - row_pad) * num_div) / img_scale);
-				switch (_settings_game.game_creation.heightmap_rotation) {
-					default: NOT_REACHED();
-					case HM_COUNTER_CLOCKWISE:
-						img_col = (((width - 1 - col - col_pad) * num_div) / img_scale);
-						break;
-					case HM_CLOCKWISE:
-						img_col = (((col - col_pad) * num_div) / img_scale);
-						break;
-				}
-
-				assert(img_row < img_height);
-				assert(img_col < img_width);
-
-				uint heightmap_height = map[img_row * img_width + img_col];
-
-				if (heightmap_height > 0) {
-					/* 0 is sea level.
-					 * Other grey scales are scaled evenly to the available height levels > 0.
-					 * (The coastline is independent from the number of height levels) */
-					heightmap_height = 1 + (heightmap_height - 1) * _settings_game.game_creation.heightmap_height / 255;
-				}
-
-				SetTileHeight(tile, heightmap_height);
-			}
-			/* Only clear the tiles within the map area. */
-			if (IsInnerTile(tile)) {
-				MakeClear(tile, ClearGround::Grass, 3);
-			}
-		}
-	}
-}
-
 /**
  * This function takes care of the fact that land in OpenTTD can never differ
  * more than 1 in height
@@ -500,10 +651,10 @@ void FixSlopes()
  * @param filename Name of the file to load.
  * @param[out] x Length of the image.
  * @param[out] y Height of the image.
- * @param[in,out] map If not \c nullptr, destination to store the loaded block of image data.
+ * @param load Whether to load the heightmap onto the map.
  * @return Whether loading was successful.
  */
-static bool ReadHeightMap(DetailedFileType dft, std::string_view filename, uint *x, uint *y, std::vector<uint8_t> *map)
+static bool ReadHeightMap(DetailedFileType dft, std::string_view filename, uint *x, uint *y, bool load)
 {
 	switch (dft) {
 		default:
@@ -511,11 +662,11 @@ static bool ReadHeightMap(DetailedFileType dft, std::string_view filename, uint
 
 #ifdef WITH_PNG
 		case DetailedFileType::HeightmapPng:
-			return ReadHeightmapPNG(filename, x, y, map);
+			return ReadHeightmapPNG(filename, x, y, load);
 #endif /* WITH_PNG */
 
 		case DetailedFileType::HeightmapBmp:
-			return ReadHeightmapBMP(filename, x, y, map);
+			return ReadHeightmapBMP(filename, x, y, load);
 	}
 }
 
@@ -529,7 +680,7 @@ static bool ReadHeightMap(DetailedFileType dft, std::string_view filename, uint
  */
 bool GetHeightmapDimensions(DetailedFileType dft, std::string_view filename, uint *x, uint *y)
 {
-	return ReadHeightMap(dft, filename, x, y, nullptr);
+	return ReadHeightMap(dft, filename, x, y, false);
 }
 
 /**
@@ -543,14 +694,11 @@ bool GetHeightmapDimensions(DetailedFileType dft, std::string_view filename, uin
 bool LoadHeightmap(DetailedFileType dft, std::string_view filename)
 {
 	uint x, y;
-	std::vector<uint8_t> map;
 
-	if (!ReadHeightMap(dft, filename, &x, &y, &map)) {
+	if (!ReadHeightMap(dft, filename, &x, &y, true)) {
 		return false;
 	}
 
-	GreyscaleToMapHeights(x, y, map);
-
 	FixSlopes();
 	MarkWholeScreenDirty();
 
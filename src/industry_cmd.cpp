@@ -1126,7 +1126,7 @@ static void PlantFarmField(TileIndex tile, IndustryID industry)
 		if (IsSuitableForFarmField(cur_tile, true, true)) {
 			MakeField(cur_tile, field_type, industry);
 			SetClearCounter(cur_tile, counter);
-			MarkTileDirtyByTile(cur_tile, VMDF_NOT_MAP_MODE);
+			MarkTileDirtyByTile(cur_tile, VMDF_NOT_MAP_MODE_NON_VEG);
 		}
 	}
 
@@ -641,6 +641,7 @@ public:
 		}
 
 		MarkWholeScreenDirty();
+		MarkAllViewportMapLandscapesDirty();
 	}
 
 	void OnClick(Point pt, WidgetID widget, int click_count) override
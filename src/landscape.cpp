@@ -40,6 +40,7 @@
 #include "terraform_cmd.h"
 #include "scope_info.h"
 #include "network/network_sync.h"
+#include "worker_thread.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "3rdparty/cpp-ring-buffer/ring_buffer.hpp"
 #include "3rdparty/robin_hood/robin_hood.h"
@@ -1004,24 +1005,49 @@ bool DesertOrRainforestProcessTiles(const std::pair<const Rect16 *, const Rect16
 	return true;
 }
 
-static void CreateDesertOrRainForest(uint desert_tropic_line)
+/**
+ * Set the tropic zone of each valid tile where no tile in the desert/rainforest area around it satisfies a predicate.
+ * The tiles are tested in parallel on the worker pool, and the zones of each quarter of the map are then set serially.
+ * Setting the tropic zone must not change the result of the predicate.
+ * @param desert_rainforest_data The area around each tile to test.
+ * @param zone The tropic zone to set.
+ * @param blocks_zone The predicate.
+ */
+template <typename F>
+static void SetTropicZoneWhereNoTileNearby(const std::pair<const Rect16 *, const Rect16 *> desert_rainforest_data, TropicZone zone, F blocks_zone)
 {
-	uint update_freq = Map::Size() / 4;
-
-	const std::pair<const Rect16 *, const Rect16 *> desert_rainforest_data = GetDesertOrRainforestData();
-
-	for (TileIndex tile(0); tile != Map::Size(); ++tile) {
-		if ((tile.base() % update_freq) == 0) IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
-
-		if (!IsValidTile(tile)) continue;
+	for (uint quarter = 0; quarter < 4; quarter++) {
+		IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
 
-		bool ok = DesertOrRainforestProcessTiles(desert_rainforest_data, tile, [&](TileIndex t) -> bool {
-			return (t != INVALID_TILE && (TileHeight(t) >= desert_tropic_line || IsTileType(t, TileType::Water)));
+		const uint y_start = Map::SizeY() * quarter / 4;
+		const uint y_end = Map::SizeY() * (quarter + 1) / 4;
+		/* Matching x coordinates of each row of this quarter only, so at most a quarter of the map is buffered. */
+		std::vector<std::vector<uint>> row_matches(y_end - y_start);
+		_general_worker_pool.ParallelFor(y_end - y_start, [&](uint row) {
+			const uint y = y_start + row;
+			for (uint x = 0; x < Map::SizeX(); x++) {
+				const TileIndex tile = TileXY(x, y);
+				if (!IsValidTile(tile)) continue;
+
+				if (DesertOrRainforestProcessTiles(desert_rainforest_data, tile, blocks_zone)) row_matches[row].push_back(x);
+			}
 		});
-		if (ok) {
-			SetTropicZone(tile, TropicZone::Desert);
+
+		for (uint y = y_start; y < y_end; y++) {
+			for (uint x : row_matches[y - y_start]) {
+				SetTropicZone(TileXY(x, y), zone);
+			}
 		}
 	}
+}
+
+static void CreateDesertOrRainForest(uint desert_tropic_line)
+{
+	const std::pair<const Rect16 *, const Rect16 *> desert_rainforest_data = GetDesertOrRainforestData();
+
+	SetTropicZoneWhereNoTileNearby(desert_rainforest_data, TropicZone::Desert, [&](TileIndex t) -> bool {
+		return (t != INVALID_TILE && (TileHeight(t) >= desert_tropic_line || IsTileType(t, TileType::Water)));
+	});
 
 	for (uint i = 0; i != TILE_UPDATE_FREQUENCY; i++) {
 		if ((i % 64) == 0) IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
@@ -1029,18 +1055,9 @@ static void CreateDesertOrRainForest(uint desert_tropic_line)
 		RunTileLoop();
 	}
 
-	for (TileIndex tile(0); tile != Map::Size(); ++tile) {
-		if ((tile.base() % update_freq) == 0) IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
-
-		if (!IsValidTile(tile)) continue;
-
-		bool ok = DesertOrRainforestProcessTiles(desert_rainforest_data, tile, [&](TileIndex t) -> bool {
-			return (t != INVALID_TILE && IsTileType(t, TileType::Clear) && IsClearGround(t, ClearGround::Desert));
-		});
-		if (ok) {
-			SetTropicZone(tile, TropicZone::Rainforest);
-		}
-	}
+	SetTropicZoneWhereNoTileNearby(desert_rainforest_data, TropicZone::Rainforest, [&](TileIndex t) -> bool {
+		return (t != INVALID_TILE && IsTileType(t, TileType::Clear) && IsClearGround(t, ClearGround::Desert));
+	});
 }
 
 /**
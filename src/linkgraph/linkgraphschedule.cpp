@@ -14,6 +14,7 @@
 #include "mcf.h"
 #include "flowmapper.h"
 #include "../framerate_type.h"
+#include "../debug_trace.h"
 #include "../command_func.h"
 #include "../misc_cmd.h"
 #include "../network/network.h"
@@ -153,6 +154,7 @@ void LinkGraphSchedule::JoinNext()
  */
 /* static */ void LinkGraphSchedule::Run(LinkGraphJob *job)
 {
+	TraceZone trace_zone("Link graph job");
 	for (const auto &handler : instance.handlers) {
 		if (job->IsJobAborted()) return;
 		handler->Run(*job);
@@ -78,6 +78,7 @@ NetworkRecvStatus NetworkAdminSocketHandler::HandlePacket(Packet &p)
 		case PacketAdminType::ServerPong: return this->ReceiveServerPong(p);
 		case PacketAdminType::ServerAuthenticationRequest: return this->ReceiveServerAuthenticationRequest(p);
 		case PacketAdminType::ServerEnableEncryption: return this->ReceiveServerEnableEncryption(p);
+		case PacketAdminType::ServerVehicleCpuStatistics: return this->ReceiveServerVehicleCpuStatistics(p);
 
 		default:
 			Debug(net, 0, "[tcp/admin] Received invalid packet type {} from '{}' ({})", type, this->admin_name, this->admin_version);
@@ -156,3 +157,4 @@ NetworkRecvStatus NetworkAdminSocketHandler::ReceiveServerRemoteConsoleCommandEn
 NetworkRecvStatus NetworkAdminSocketHandler::ReceiveServerPong(Packet &) { return this->ReceiveInvalidPacket(PacketAdminType::ServerPong); }
 NetworkRecvStatus NetworkAdminSocketHandler::ReceiveServerAuthenticationRequest(Packet &) { return this->ReceiveInvalidPacket(PacketAdminType::ServerAuthenticationRequest); }
 NetworkRecvStatus NetworkAdminSocketHandler::ReceiveServerEnableEncryption(Packet &) { return this->ReceiveInvalidPacket(PacketAdminType::ServerEnableEncryption); }
+NetworkRecvStatus NetworkAdminSocketHandler::ReceiveServerVehicleCpuStatistics(Packet &) { return this->ReceiveInvalidPacket(PacketAdminType::ServerVehicleCpuStatistics); }
@@ -63,6 +63,7 @@ enum class PacketAdminType : uint8_t {
 	ServerCommandLogging, ///< The server gives the admin copies of incoming command packets.
 	ServerAuthenticationRequest, ///< The server gives the admin the used authentication method and required parameters.
 	ServerEnableEncryption, ///< The server tells that authentication has completed and requests to enable encryption with the keys of the last \c PacketAdminType::AdminAuthenticationResponse.
+	ServerVehicleCpuStatistics, ///< The server gives the admin the sampled CPU costs of vehicles.
 };
 /** Mark PacketAdminType as a PacketType. */
 template <> struct IsEnumPacketType<PacketAdminType> {
@@ -89,6 +90,7 @@ enum AdminUpdateType : uint8_t {
 	ADMIN_UPDATE_CMD_NAMES,       ///< The admin would like a list of all DoCommand names.
 	ADMIN_UPDATE_CMD_LOGGING,     ///< The admin would like to have DoCommand information.
 	ADMIN_UPDATE_GAMESCRIPT,      ///< The admin would like to have gamescript messages.
+	ADMIN_UPDATE_VEHICLE_CPU_STATS, ///< The admin would like to have the sampled CPU costs of vehicles.
 	ADMIN_UPDATE_END,             ///< Must ALWAYS be on the end of this list!! (period)
 };
 
@@ -154,6 +156,7 @@ protected:
 	 * uint32_t  ID relevant to the packet type, e.g.
 	 *          - the client ID for #ADMIN_UPDATE_CLIENT_INFO. Use UINT32_MAX to show all clients.
 	 *          - the company ID for #ADMIN_UPDATE_COMPANY_INFO. Use UINT32_MAX to show all companies.
+	 *          - the company ID for #ADMIN_UPDATE_VEHICLE_CPU_STATS. Use UINT32_MAX to show the vehicles of all companies.
 	 * @param p The packet that was just received.
 	 * @return The state the network should have.
 	 */
@@ -523,6 +526,25 @@ protected:
 	 */
 	virtual NetworkRecvStatus ReceiveServerEnableEncryption(Packet &p);
 
+	/**
+	 * The sampled CPU costs of vehicles, see the 'dump_veh_cpu_stats' console command.
+	 * The costs are only sampled while enabled with that command.
+	 * uint64_t  Number of sampled ticks since the statistics were cleared.
+	 *
+	 * These eight fields are repeated until the packet is full:
+	 * bool      Data to follow.
+	 * uint32_t  ID of the front vehicle.
+	 * uint8_t   ID of the company owning the vehicle.
+	 * uint64_t  Nanoseconds spent ticking the vehicle, including pathfinding.
+	 * uint32_t  Number of measured ticks.
+	 * uint64_t  Nanoseconds spent in the pathfinder.
+	 * uint32_t  Number of measured pathfinder calls.
+	 * uint64_t  Number of nodes searched by the pathfinder.
+	 * @param p The packet that was just received.
+	 * @return The state the network should have.
+	 */
+	virtual NetworkRecvStatus ReceiveServerVehicleCpuStatistics(Packet &p);
+
 	/**
 	 * Send a ping-reply (pong) to the admin that sent us the ping packet.
 	 * uint32_t  Integer identifier - should be the same as read from the admins ping packet.
@@ -97,6 +97,7 @@ uint32_t _last_sync_frame;                              ///< Used in the server
 NetworkAddressList _broadcast_list;                     ///< List of broadcast addresses.
 uint32_t _sync_seed_1;                                  ///< Seed to compare during sync checks.
 uint64_t _sync_state_checksum;                          ///< State checksum to compare during sync checks.
+std::vector<WorldStateShardHash> _sync_world_hash_shards; ///< World state shard hashes to compare during sync checks.
 uint32_t _sync_frame;                                   ///< The frame to perform the sync check.
 EconTime::Date   _last_sync_date;                       ///< The game date of the last successfully received sync frame
 EconTime::DateFract _last_sync_date_fract;              ///< "
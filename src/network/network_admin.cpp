@@ -22,6 +22,8 @@
 #include "../map_func.h"
 #include "../rev.h"
 #include "../game/game.hpp"
+#include "../vehicle_base.h"
+#include "../vehicle_cpu_stats.h"
 
 #include "table/strings.h"
 
@@ -58,6 +60,7 @@ static const AdminUpdateFrequencies _admin_update_type_frequencies[] = {
 	{AdminUpdateFrequency::Poll,                                                                                                                                                          }, // ADMIN_UPDATE_CMD_NAMES
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_CMD_LOGGING
 	{                            AdminUpdateFrequency::Automatic,                                                                                                                         }, // ADMIN_UPDATE_GAMESCRIPT
+	{AdminUpdateFrequency::Poll,                              AdminUpdateFrequency::Weekly, AdminUpdateFrequency::Monthly, AdminUpdateFrequency::Quarterly, AdminUpdateFrequency::Annually}, // ADMIN_UPDATE_VEHICLE_CPU_STATS
 };
 /** Sanity check. */
 static_assert(lengthof(_admin_update_type_frequencies) == ADMIN_UPDATE_END);
@@ -461,6 +464,46 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::SendCompanyStats()
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
+/**
+ * Send the sampled CPU costs of the vehicles.
+ * @param company The company to send the vehicles of, or CompanyID::Invalid() for all companies.
+ * @return The new state the network.
+ */
+NetworkRecvStatus ServerNetworkAdminSocketHandler::SendVehicleCpuStats(CompanyID company)
+{
+	auto p = std::make_unique<Packet>(this, PacketAdminType::ServerVehicleCpuStatistics);
+	p->Send_uint64(GetVehicleCpuStatsSampledTicks());
+
+	for (const auto &[v, stats] : GetSampledVehicleCpuStats()) {
+		if (company != CompanyID::Invalid() && v->owner != company) continue;
+
+		/* Should COMPAT_MTU be exceeded, start a new packet
+		 * (magic 39: 1 bool "more data", 37 bytes of statistics and 1 bool "no more data"). */
+		if (!p->CanWriteToPacket(39)) {
+			p->Send_bool(false);
+			this->SendPacket(std::move(p));
+
+			p = std::make_unique<Packet>(this, PacketAdminType::ServerVehicleCpuStatistics);
+			p->Send_uint64(GetVehicleCpuStatsSampledTicks());
+		}
+
+		p->Send_bool(true);
+		p->Send_uint32(v->index.base());
+		p->Send_uint8(v->owner.base());
+		p->Send_uint64(stats.tick_ns);
+		p->Send_uint32(stats.ticks);
+		p->Send_uint64(stats.pathfinder_ns);
+		p->Send_uint32(stats.pathfinder_calls);
+		p->Send_uint64(stats.pathfinder_nodes);
+	}
+
+	/* Marker to notify the end of the packet has been reached. */
+	p->Send_bool(false);
+	this->SendPacket(std::move(p));
+
+	return NETWORK_RECV_STATUS_OKAY;
+}
+
 /**
  * Send a chat message.
  * @param action The action associated with the message.
@@ -782,6 +825,16 @@ NetworkRecvStatus ServerNetworkAdminSocketHandler::ReceiveAdminPoll(Packet &p)
 			this->SendCmdNames();
 			break;
 
+		case ADMIN_UPDATE_VEHICLE_CPU_STATS:
+			/* The admin is requesting the CPU costs of vehicles. */
+			if (d1 == UINT32_MAX) {
+				this->SendVehicleCpuStats(CompanyID::Invalid());
+			} else {
+				const Company *company = Company::GetIfValid(d1);
+				if (company != nullptr) this->SendVehicleCpuStats(company->index);
+			}
+			break;
+
 		default:
 			/* An unsupported "poll" update type. */
 			Debug(net, 1, "[admin] Not supported poll {} ({}) from '{}' ({}).", type, d1, this->admin_name, this->admin_version);
@@ -1139,6 +1192,10 @@ void NetworkAdminUpdate(AdminUpdateFrequency freq)
 						as->SendCompanyStats();
 						break;
 
+					case ADMIN_UPDATE_VEHICLE_CPU_STATS:
+						as->SendVehicleCpuStats(CompanyID::Invalid());
+						break;
+
 					default: NOT_REACHED();
 				}
 			}
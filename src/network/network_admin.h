@@ -69,6 +69,7 @@ public:
 	NetworkRecvStatus SendCompanyRemove(CompanyID company_id, AdminCompanyRemoveReason bcrr);
 	NetworkRecvStatus SendCompanyEconomy();
 	NetworkRecvStatus SendCompanyStats();
+	NetworkRecvStatus SendVehicleCpuStats(CompanyID company);
 
 	NetworkRecvStatus SendChat(NetworkAction action, NetworkChatDestinationType desttype, ClientID client_id, std::string_view msg, NetworkTextMessageData data);
 	NetworkRecvStatus SendRcon(uint16_t colour, std::string_view command);
@@ -313,10 +313,17 @@ void ClientNetworkGameSocketHandler::ClientError(NetworkRecvStatus res)
 	/* Check if we are in sync! */
 	if (_sync_frame != 0) {
 		if (_sync_frame == _frame_counter) {
-			if (_sync_seed_1 != _random.state[0] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK))) {
+			const WorldStateShardHash *world_hash_mismatch = FindWorldStateShardHashMismatch(_sync_world_hash_shards);
+			if (_sync_seed_1 != _random.state[0] || (_sync_state_checksum != _state_checksum.state && !HasChickenBit(DCBF_MP_NO_STATE_CSUM_CHECK)) || world_hash_mismatch != nullptr) {
 				DesyncExtraInfo info;
 				if (_sync_seed_1 != _random.state[0]) info.flags |= DesyncExtraInfo::DEIF_RAND;
 				if (_sync_state_checksum != _state_checksum.state) info.flags |= DesyncExtraInfo::DEIF_STATE;
+				if (world_hash_mismatch != nullptr) {
+					info.flags |= DesyncExtraInfo::DEIF_WORLD_HASH;
+					info.world_hash_mismatch = fmt::format("World state hash mismatch: {} {}", GetWorldStateHashPartName(world_hash_mismatch->part),
+							DescribeWorldStateHashShard(world_hash_mismatch->part, world_hash_mismatch->shard, WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG));
+					Debug(desync, 1, "sync_err: {}", info.world_hash_mismatch);
+				}
 
 				ShowNetworkError(STR_NETWORK_ERROR_DESYNC);
 				Debug(desync, 1, "sync_err: {} {{{:X}, {:X}}} != {{{:X}, {:X}}}",
@@ -1213,6 +1220,18 @@ NetworkRecvStatus ClientNetworkGameSocketHandler::ReceiveServerSync(Packet &p)
 	_sync_seed_1 = p.Recv_uint32();
 	_sync_state_checksum = p.Recv_uint64();
 
+	_sync_world_hash_shards.clear();
+	if (p.CanReadFromPacket(sizeof(uint8_t))) {
+		const uint count = p.Recv_uint8();
+		for (uint i = 0; i < count; i++) {
+			const uint8_t part = p.Recv_uint8();
+			const uint32_t shard = p.Recv_uint32();
+			const uint64_t hash = p.Recv_uint64();
+			if (part >= WSHP_END) return NETWORK_RECV_STATUS_MALFORMED_PACKET;
+			_sync_world_hash_shards.push_back({ static_cast<WorldStateHashPart>(part), shard, hash });
+		}
+	}
+
 	return NETWORK_RECV_STATUS_OKAY;
 }
 
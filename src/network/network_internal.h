@@ -17,6 +17,7 @@
 
 #include "../command_type.h"
 #include "../date_type.h"
+#include "../debug_desync.h"
 
 #include <array>
 #include <vector>
@@ -61,6 +62,7 @@ extern NetworkAddressList _broadcast_list;
 
 extern uint32_t _sync_seed_1;
 extern uint64_t _sync_state_checksum;
+extern std::vector<WorldStateShardHash> _sync_world_hash_shards;
 extern uint32_t _sync_frame;
 extern EconTime::Date _last_sync_date;
 extern EconTime::DateFract _last_sync_date_fract;
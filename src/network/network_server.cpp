@@ -772,6 +772,13 @@ NetworkRecvStatus ServerNetworkGameSocketHandler::SendSync()
 	p->Send_uint32(_sync_seed_1);
 
 	p->Send_uint64(_sync_state_checksum);
+
+	p->Send_uint8(static_cast<uint8_t>(_sync_world_hash_shards.size()));
+	for (const WorldStateShardHash &shard_hash : _sync_world_hash_shards) {
+		p->Send_uint8(shard_hash.part);
+		p->Send_uint32(shard_hash.shard);
+		p->Send_uint64(shard_hash.hash);
+	}
 	this->SendPacket(std::move(p));
 	return NETWORK_RECV_STATUS_OKAY;
 }
@@ -2106,6 +2113,7 @@ void NetworkServer_Tick(bool send_frame)
 	if (_frame_counter >= _last_sync_frame + _settings_client.network.sync_freq) {
 		_last_sync_frame = _frame_counter;
 		send_sync = true;
+		_sync_world_hash_shards = ComputeNextWorldStateShardHashes(_settings_client.network.sync_world_hash_shards);
 	}
 #endif
 
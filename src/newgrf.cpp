@@ -89,7 +89,7 @@ GrfMiscBits _misc_grf_features{};
 /** Indicates which are the newgrf features currently loaded ingame */
 GRFLoadedFeatures _loaded_newgrf_features;
 
-GrfProcessingState _cur_gps;
+thread_local GrfProcessingState _cur_gps; ///< Thread-local, such that the file scan stages can run on worker threads.
 GrfProcessingOptimiserState _cur_grf_optimise_state;
 
 /** Clear temporary data before processing the next file in the current loading stage */
@@ -656,6 +656,7 @@ void ResetNewGRFData()
 
 	InitializeSoundPool();
 	_spritegroup_pool.CleanPool();
+	ClearNewGRFCallbackMemo();
 	ResetCallbacks(false);
 	_deterministic_sg_shadows.clear();
 	_randomized_sg_shadows.clear();
@@ -1818,6 +1819,10 @@ static void AfterLoadGRFs()
 
 	ReleaseVarAction2OptimisationCaches();
 
+	/* All deterministic sprite groups are now final. */
+	CompileDeterministicSpriteGroups();
+	MarkCallbackMemoisableSpriteGroups();
+
 	FinaliseStringMapping();
 
 	/* Clear the action 6 override sprites. */
@@ -1993,6 +1998,16 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 
 	_cur_gps.spriteid = load_index;
 
+	/* Scanning the sprite sections only depends on the file contents, so do this for all files in parallel up front. */
+	{
+		std::vector<std::pair<std::string, Subdirectory>> files;
+		for (const auto &c : _grfconfig) {
+			if (c->status == GRFStatus::Disabled || c->status == GRFStatus::NotFound) continue;
+			files.emplace_back(c->filename, files.size() < num_baseset ? Subdirectory::Baseset : Subdirectory::NewGrf);
+		}
+		PrefetchGRFSpriteOffsets(files);
+	}
+
 	/* Load newgrf sprites
 	 * in each loading stage, (try to) open each file specified in the config
 	 * and load information from it. */
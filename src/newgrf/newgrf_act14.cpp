@@ -133,7 +133,7 @@ static bool ChangeGRFMinVersion(size_t len, ByteReader &buf)
 	return true;
 }
 
-static GRFParameterInfo *_cur_parameter; ///< The parameter which info is currently changed by the newgrf.
+static thread_local GRFParameterInfo *_cur_parameter; ///< The parameter which info is currently changed by the newgrf.
 
 /** Callback function for 'INFO'->'PARAM'->param_num->'NAME' to set the name of a parameter. @copydoc TextHandler */
 static bool ChangeGRFParamName(uint8_t langid, std::string_view str)
@@ -678,6 +678,7 @@ static void NewSpriteGroup(ByteReader &buf)
 
 			OptimiseVarAction2DeterministicSpriteGroup(va2_opt_state, info, group, current_adjusts);
 			current_adjusts.clear();
+			group->Compile();
 			break;
 		}
 
@@ -16,7 +16,7 @@
 
 btree::btree_map<GRFLocation, std::pair<SpriteID, uint16_t>> _grm_sprites;
 GRFLineToSpriteOverride _grf_line_to_action6_sprite_override;
-bool _action6_override_active = false;
+thread_local bool _action6_override_active = false;
 
 /* Action 0x06 */
 static void CfgApply(ByteReader &buf)
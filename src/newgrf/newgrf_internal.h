@@ -211,7 +211,7 @@ public:
 
 using SpriteSetInfo = GrfProcessingState::SpriteSetInfo;
 
-extern GrfProcessingState _cur_gps;
+extern thread_local GrfProcessingState _cur_gps;
 
 struct GRFLocation {
 	uint32_t grfid;
@@ -234,7 +234,7 @@ using GRFLineToSpriteOverride = btree::btree_map<GRFLocation, std::unique_ptr<ui
 
 extern btree::btree_map<GRFLocation, std::pair<SpriteID, uint16_t>> _grm_sprites;
 extern GRFLineToSpriteOverride _grf_line_to_action6_sprite_override;
-extern bool _action6_override_active;
+extern thread_local bool _action6_override_active;
 
 extern GrfMiscBits _misc_grf_features;
 
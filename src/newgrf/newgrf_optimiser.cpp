@@ -812,6 +812,8 @@ void OptimiseVarAction2Adjust(VarAction2OptimiseState &state, const VarAction2Ad
 {
 	if (unlikely(HasGrfOptimiserFlag(NGOF_NO_OPT_VARACT2))) return;
 
+	group->InvalidateCompiled();
+
 	auto guard = scope_guard([&]() {
 		if (!group->adjusts.empty()) {
 			const DeterministicSpriteGroupAdjust &adjust = group->adjusts.back();
@@ -2766,6 +2768,8 @@ void OptimiseVarAction2DeterministicSpriteGroup(VarAction2OptimiseState &state,
 {
 	if (unlikely(HasGrfOptimiserFlag(NGOF_NO_OPT_VARACT2))) return;
 
+	group->InvalidateCompiled();
+
 	bool possible_callback_handler = false;
 	for (DeterministicSpriteGroupAdjust &adjust : group->adjusts) {
 		if (adjust.variable == 0x7D) adjust.parameter &= 0xFF; // Clear temporary version tags
@@ -3331,6 +3335,7 @@ void HandleVarAction2OptimisationPasses()
 	CheckDeterministicSpriteGroupOutputVarBitsProcedureHandler::HandleDeferredGroups();
 
 	for (DeterministicSpriteGroup *group : _cur_grf_optimise_state.dead_store_elimination_candidates) {
+		group->InvalidateCompiled();
 		VarAction2GroupVariableTracking *var_tracking = _cur_grf_optimise_state.GetVarAction2GroupVariableTracking(group, false);
 		if (!group->IsCalculatedResult()) {
 			/* Add bits from any groups previously marked with DSGF_VAR_TRACKING_PENDING which should now be correctly updated after DSE */
@@ -3381,6 +3386,7 @@ void HandleVarAction2OptimisationPasses()
 		}
 
 		group->adjusts.shrink_to_fit();
+		group->Compile();
 	}
 }
 
@@ -3428,3 +3434,166 @@ void ReleaseVarAction2OptimisationCaches()
 	CheckDeterministicSpriteGroupOutputVarBitsProcedureHandler::ReleaseCaches();
 	VarAction2OptimiseState::ReleaseCaches();
 }
+
+/**
+ * Check whether a global variable cannot change during a tick, other than by a change of the calendar date.
+ * @param variable Variable number.
+ * @return True if the variable is stable.
+ */
+static bool IsTickStableGlobalVariable(uint16_t variable)
+{
+	switch (variable) {
+		case 0x00: // current date
+		case 0x01: // current year
+		case 0x02: // detailed date information
+		case 0x03: // climate
+		case 0x0B: // TTDPatch version
+		case 0x0D: // TTD version
+		case 0x12: // game mode
+		case 0x1D: // TTD platform
+		case 0x21: // OpenTTD version
+		case 0x23: // long format date
+		case 0x24: // long format year
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+/**
+ * Set #SGF_CALLBACK_MEMO on deterministic sprite groups whose callback result only depends on the callback parameters,
+ * the GRF parameters and tick-stable global variables.
+ * That is, groups which do not read object-specific or random variables, do not store to temporary or persistent storage,
+ * and do not reach randomised or real sprite groups.
+ * Reads of the vehicle variables which are kept in the NewGRFCache of the vehicle of the SELF scope are allowed too,
+ * such groups also get #SGF_CALLBACK_MEMO_SELF so that their results are memoised per vehicle and cache generation.
+ * Groups which are cheap to evaluate are not marked, as the memo lookup would cost more than it saves.
+ */
+void MarkCallbackMemoisableSpriteGroups()
+{
+	if (HasGrfOptimiserFlag(NGOF_NO_CALLBACK_MEMO)) return;
+
+	static constexpr uint MIN_MEMO_COST = 8; ///< Minimum number of adjusts which must be evaluated for a group to be worth memoising.
+
+	enum class State : uint8_t {
+		InProgress,
+		Pure,
+		Impure,
+	};
+	struct GroupState {
+		State state;
+		uint cost;
+		bool reads_self = false; ///< Whether the cached NewGRF variables of the vehicle of the SELF scope are read.
+	};
+	robin_hood::unordered_flat_map<const SpriteGroup *, GroupState> states;
+
+	auto check_group = y_combinator([&](auto check_group, const SpriteGroup *sg) -> GroupState {
+		if (sg == nullptr) return { State::Pure, 0 };
+
+		switch (sg->type) {
+			case SGT_CALLBACK:
+			case SGT_CALCULATED_RESULT:
+			case SGT_RESULT:
+			case SGT_TILELAYOUT:
+			case SGT_INDUSTRY_PRODUCTION:
+				return { State::Pure, 0 };
+
+			case SGT_DETERMINISTIC:
+				break;
+
+			default:
+				return { State::Impure, 0 };
+		}
+
+		auto iter = states.find(sg);
+		if (iter != states.end()) {
+			/* Recursion is not expected, but is not handled either */
+			if (iter->second.state == State::InProgress) return { State::Impure, 0 };
+			return iter->second;
+		}
+		states[sg] = { State::InProgress, 0 };
+
+		const DeterministicSpriteGroup *dsg = static_cast<const DeterministicSpriteGroup *>(sg);
+		GroupState result = { State::Pure, (uint)dsg->adjusts.size() };
+		auto merge = [&](GroupState child) {
+			if (child.state != State::Pure) result.state = State::Impure;
+			result.cost += child.cost;
+			result.reads_self |= child.reads_self;
+		};
+
+		for (const DeterministicSpriteGroupAdjust &adjust : dsg->adjusts) {
+			switch (adjust.operation) {
+				case DSGA_OP_STO:
+				case DSGA_OP_STO_NC:
+				case DSGA_OP_STOP:
+					result.state = State::Impure;
+					break;
+
+				default:
+					break;
+			}
+
+			switch (adjust.variable) {
+				case 0x0C:
+				case 0x10:
+				case 0x18:
+				case 0x1A:
+				case 0x1C:
+				case 0x7D:
+				case 0x7F:
+					break;
+
+				case 0x7E:
+					merge(check_group(adjust.subroutine));
+					break;
+
+				case 0x40: // Position in consist and length
+				case 0x41: // Position and length of run of the same vehicle
+				case 0x42: // Consist cargo information
+				case 0x43: // Company information
+				case 0x4D: // Position within articulated vehicle
+					/* These vehicle variables are cached in the NewGRFCache, a change of them invalidates the cache */
+					switch (dsg->var_scope == VSG_SCOPE_SELF ? dsg->feature : GrfSpecFeature::Invalid) {
+						case GrfSpecFeature::Trains:
+						case GrfSpecFeature::RoadVehicles:
+						case GrfSpecFeature::Ships:
+						case GrfSpecFeature::Aircraft:
+							result.reads_self = true;
+							break;
+
+						default:
+							result.state = State::Impure;
+							break;
+					}
+					break;
+
+				default:
+					if (!IsTickStableGlobalVariable(adjust.variable)) result.state = State::Impure;
+					break;
+			}
+			if (result.state != State::Pure) break;
+		}
+
+		if (result.state == State::Pure && !dsg->IsCalculatedResult()) {
+			merge(check_group(dsg->default_group));
+			merge(check_group(dsg->error_group));
+			for (const auto &range : dsg->ranges) {
+				if (result.state != State::Pure) break;
+				merge(check_group(range.group));
+			}
+		}
+
+		states[sg] = result;
+		return result;
+	});
+
+	for (SpriteGroup *group : SpriteGroup::Iterate()) {
+		if (group->type != SGT_DETERMINISTIC) continue;
+		GroupState state = check_group(group);
+		if (state.state == State::Pure && state.cost >= MIN_MEMO_COST) {
+			group->sg_flags |= SGF_CALLBACK_MEMO;
+			if (state.reads_self) group->sg_flags |= SGF_CALLBACK_MEMO_SELF;
+		}
+	}
+}
@@ -244,5 +244,6 @@ void OptimiseVarAction2Adjust(VarAction2OptimiseState &state, const VarAction2Ad
 void OptimiseVarAction2DeterministicSpriteGroup(VarAction2OptimiseState &state, const VarAction2AdjustInfo info, DeterministicSpriteGroup *group, std::vector<DeterministicSpriteGroupAdjust> &saved_adjusts);
 void HandleVarAction2OptimisationPasses();
 void ReleaseVarAction2OptimisationCaches();
+void MarkCallbackMemoisableSpriteGroups();
 
 #endif /* NEWGRF_OPTIMISER_INTERNAL_H */
@@ -10,7 +10,7 @@
 #ifndef NEWGRF_CACHE_CHECK_H
 #define NEWGRF_CACHE_CHECK_H
 
-extern bool _sprite_group_resolve_check_veh_check;
-extern bool _sprite_group_resolve_check_veh_curvature_check;
+extern thread_local bool _sprite_group_resolve_check_veh_check;
+extern thread_local bool _sprite_group_resolve_check_veh_curvature_check;
 
 #endif /* NEWGRF_CACHE_CHECK_H */
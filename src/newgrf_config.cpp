@@ -17,6 +17,7 @@
 #include "window_func.h"
 #include "progress.h"
 #include "video/video_driver.hpp"
+#include "worker_thread.h"
 #include "string_func.h"
 #include "strings_func.h"
 #include "textfile_gui.h"
@@ -590,6 +591,11 @@ class GRFFileScanner : FileScanner {
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
 	std::vector<std::unique_ptr<GRFConfig>> grfs;
+	std::vector<std::unique_ptr<GRFConfig>> pending; ///< Files found but not yet scanned, when scanning on the worker threads.
+	bool parallel = false; ///< Whether the files are scanned on the worker threads.
+
+	void FileScanned(const GRFConfig &config);
+	void ScanPending();
 
 public:
 	GRFFileScanner() : num_scanned(0)
@@ -610,11 +616,20 @@ public:
 			return 0;
 		}
 
-		CalcGRFMD5ThreadingStart();
 		GRFFileScanner fs;
 		fs.grfs.clear();
-		int ret = fs.Scan(".grf", Subdirectory::NewGrf);
-		CalcGRFMD5ThreadingEnd();
+
+		/* The file scan stages and the MD5 sum only depend on the file itself, so when there are worker threads,
+		 * the files found are scanned in batches on the worker threads, including the MD5 sum. */
+		fs.parallel = _general_worker_pool.GetWorkerCount() > 0;
+		if (!fs.parallel) CalcGRFMD5ThreadingStart();
+		fs.Scan(".grf", Subdirectory::NewGrf);
+		if (fs.parallel) {
+			fs.ScanPending();
+		} else {
+			CalcGRFMD5ThreadingEnd();
+		}
+		uint ret = static_cast<uint>(fs.grfs.size());
 
 		for (std::unique_ptr<GRFConfig> &c : fs.grfs) {
 			if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c->ident.grfid == gc->ident.grfid && c->ident.md5sum == gc->ident.md5sum; })) {
@@ -629,24 +644,55 @@ public:
 	}
 };
 
+/**
+ * Update the scan status after a file has been scanned.
+ * @param config The scanned file.
+ */
+void GRFFileScanner::FileScanned(const GRFConfig &config)
+{
+	this->num_scanned++;
+
+	std::string name{config.GetName()};
+	UpdateNewGRFScanStatus(this->num_scanned, std::move(name));
+	VideoDriver::GetInstance()->GameLoopPause();
+}
+
+/**
+ * Scan the pending files on the worker threads.
+ */
+void GRFFileScanner::ScanPending()
+{
+	std::vector<uint8_t> added(this->pending.size());
+	_general_worker_pool.ParallelFor(static_cast<uint>(this->pending.size()), [&](uint i) {
+		if (!_exit_game) added[i] = FillGRFDetails(*this->pending[i], false);
+	});
+
+	for (size_t i = 0; i < this->pending.size(); i++) {
+		this->FileScanned(*this->pending[i]);
+		if (added[i] != 0) this->grfs.push_back(std::move(this->pending[i]));
+	}
+	this->pending.clear();
+}
+
 bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &)
 {
 	/* Abort if the user stopped the game during a scan. */
 	if (_exit_game) return false;
 
 	auto c = std::make_unique<GRFConfig>(filename.substr(basepath_length));
-	GRFConfig *grfconfig = c.get();
+
+	if (this->parallel) {
+		this->pending.push_back(std::move(c));
+		if (this->pending.size() >= (_general_worker_pool.GetWorkerCount() + 1) * 4) this->ScanPending();
+		return true;
+	}
+
 	bool added = FillGRFDetails(*c, false);
+	this->FileScanned(*c);
 	if (added) {
 		this->grfs.push_back(std::move(c));
 	}
 
-	this->num_scanned++;
-
-	std::string name{grfconfig->GetName()};
-	UpdateNewGRFScanStatus(this->num_scanned, std::move(name));
-	VideoDriver::GetInstance()->GameLoopPause();
-
 	return added;
 }
 
@@ -37,8 +37,8 @@
 
 #include "safeguards.h"
 
-bool _sprite_group_resolve_check_veh_check = false;
-bool _sprite_group_resolve_check_veh_curvature_check = false;
+thread_local bool _sprite_group_resolve_check_veh_check = false;
+thread_local bool _sprite_group_resolve_check_veh_curvature_check = false;
 
 void SetWagonOverrideSprites(EngineID engine, CargoType cargo, const SpriteGroup *group, std::span<EngineID> engine_ids)
 {
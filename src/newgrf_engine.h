@@ -68,6 +68,7 @@ struct VehicleResolverObject : public SpecializedResolverObject<VehicleRandomTri
 
 	GrfSpecFeature GetFeature() const override;
 	uint32_t GetDebugID() const override;
+	const Vehicle *GetCallbackMemoSelfVehicle() const override { return this->self_scope.v; }
 };
 
 static const uint TRAININFO_DEFAULT_VEHICLE_WIDTH   = 29;
@@ -56,6 +56,7 @@ void NewGRFProfiler::BeginResolve(const ResolverObject &resolver)
 	this->cur_call.cb = resolver.callback;
 	this->cur_call.feat = resolver.GetFeature();
 	this->cur_call.item = resolver.GetDebugID();
+	this->cur_call.memoised = false;
 }
 
 /**
@@ -88,6 +89,20 @@ void NewGRFProfiler::RecursiveResolve()
 	this->cur_call.subs += 1;
 }
 
+/**
+ * Capture a callback resolution which was answered from the callback memo.
+ * @param resolver Data about sprite group being resolved
+ * @param result Result of the callback
+ */
+void NewGRFProfiler::MemoisedResolve(const ResolverObject &resolver, uint16_t result)
+{
+	this->BeginResolve(resolver);
+	this->cur_call.time = 0;
+	this->cur_call.result = result;
+	this->cur_call.memoised = true;
+	this->calls.push_back(this->cur_call);
+}
+
 void NewGRFProfiler::Start()
 {
 	this->Abort();
@@ -116,9 +131,9 @@ uint32_t NewGRFProfiler::Finish()
 	if (!f.has_value()) {
 		IConsolePrint(CC_ERROR, "Failed to open '{}' for writing.", filename);
 	} else {
-		fmt_print_no_system_error(*f, "Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result\n");
+		fmt_print_no_system_error(*f, "Tick,Sprite,Feature,Item,CallbackID,Microseconds,Depth,Result,Memoised\n");
 		for (const Call &c : this->calls) {
-			fmt_print_no_system_error(*f, "{},{},0x{:X},{},0x{:X},{},{},{}\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result);
+			fmt_print_no_system_error(*f, "{},{},0x{:X},{},0x{:X},{},{},{},{}\n", c.tick, c.root_sprite, c.feat, c.item, (uint)c.cb, c.time, c.subs, c.result, c.memoised ? 1 : 0);
 			total_microseconds += c.time;
 		}
 	}
@@ -29,6 +29,7 @@ struct NewGRFProfiler {
 	void BeginResolve(const ResolverObject &resolver);
 	void EndResolve(const SpriteGroup *result);
 	void RecursiveResolve();
+	void MemoisedResolve(const ResolverObject &resolver, uint16_t result);
 
 	void Start();
 	uint32_t Finish();
@@ -49,6 +50,7 @@ struct NewGRFProfiler {
 		uint64_t tick;         ///< Game tick
 		CallbackID cb;         ///< Callback ID
 		GrfSpecFeature feat;   ///< GRF feature being resolved for
+		bool memoised;         ///< Result was taken from the callback memo
 	};
 
 	const GRFFile *grffile = nullptr; ///< Which GRF is being profiled
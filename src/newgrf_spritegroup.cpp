@@ -14,23 +14,28 @@
 #include "newgrf/newgrf_optimiser_internal.h"
 #include "newgrf_profiling.h"
 #include "core/pool_func.hpp"
-#include "vehicle_type.h"
+#include "vehicle_base.h"
 #include "newgrf_cache_check.h"
 #include "string_func.h"
 #include "newgrf_extension.h"
 #include "scope.h"
 #include "debug_settings.h"
 #include "newgrf_engine.h"
+#include "newgrf_station.h"
 #include "newgrf_dump.h"
 #include "core/format.hpp"
+#include "date_func.h"
+#include "thread.h"
+#include <atomic>
 #include <bit>
+#include <typeinfo>
 
 #include "safeguards.h"
 
 SpriteGroupPool _spritegroup_pool("SpriteGroup");
 INSTANTIATE_POOL_METHODS(SpriteGroup)
 
-TemporaryStorageArray<int32_t, 0x110> _temp_store;
+thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 
 robin_hood::unordered_node_map<const DeterministicSpriteGroup *, DeterministicSpriteGroupShadowCopy> _deterministic_sg_shadows;
 robin_hood::unordered_flat_map<const RandomizedSpriteGroup *, RandomizedSpriteGroupShadowCopy> _randomized_sg_shadows;
@@ -72,7 +77,8 @@ GrfSpecFeature GetGrfSpecFeatureForParentScope(GrfSpecFeature feature)
 	const GRFFile *grf = object.grffile;
 	auto profiler = std::ranges::find(_newgrf_profilers, grf, &NewGRFProfiler::grffile);
 
-	if (profiler == _newgrf_profilers.end() || !profiler->active) {
+	/* The profilers are not thread-safe, resolves on other threads are not profiled */
+	if (profiler == _newgrf_profilers.end() || !profiler->active || !IsMainThread()) {
 		if (top_level) _temp_store.ClearChanges();
 		return group->Resolve(object);
 	} else if (top_level) {
@@ -176,10 +182,10 @@ static inline uint32_t GetVariable(const ResolverObject &object, ScopeResolver *
 	return &this->default_scope;
 }
 
-/* Evaluate an adjustment for a variable of the given size.
- * U is the unsigned type and S is the signed type to use. */
-template <typename U, typename S>
-static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, U last_value, uint32_t value, const DeterministicSpriteGroupAdjust **adjust_iter = nullptr)
+/* Shift, mask and adjust the value of a variable of the given size.
+ * S is the signed type to use, T is either DeterministicSpriteGroupAdjust or DeterministicSpriteGroupOp. */
+template <typename S, typename T>
+static uint32_t EvalAdjustValueT(const T &adjust, uint32_t value)
 {
 	value >>= adjust.shift_num;
 	value  &= adjust.and_mask;
@@ -192,10 +198,19 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_TYPE_NONE: break;
 	}
 
+	return value;
+}
+
+/* Apply operation OP to an already adjusted value of the given size.
+ * U is the unsigned type and S is the signed type to use.
+ * The switch is on a template parameter, so each instantiation only contains the code of its own operation. */
+template <typename U, typename S, DeterministicSpriteGroupAdjustOperation OP>
+static U EvalOperationT(const DeterministicSpriteGroupOp &op, ScopeResolver *scope, U last_value, uint32_t value, const DeterministicSpriteGroupOp **op_iter)
+{
 	auto handle_jump = [&](bool jump, U jump_return_value) -> U {
-		if (jump && adjust_iter != nullptr) {
+		if (jump && op_iter != nullptr) {
 			/* Jump */
-			(*adjust_iter) += adjust.jump;
+			(*op_iter) += op.jump;
 			return jump_return_value;
 		} else {
 			/* Don't jump */
@@ -203,7 +218,7 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		}
 	};
 
-	switch (adjust.operation) {
+	switch (OP) {
 		case DSGA_OP_ADD:  return last_value + value;
 		case DSGA_OP_SUB:  return last_value - value;
 		case DSGA_OP_SMIN: return std::min<S>(last_value, value);
@@ -227,14 +242,14 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 		case DSGA_OP_SHL:  return (uint32_t)(U)last_value << ((U)value & 0x1F); // Same behaviour as in ParamSet, mask 'value' to 5 bits, which should behave the same on all architectures.
 		case DSGA_OP_SHR:  return (uint32_t)(U)last_value >> ((U)value & 0x1F);
 		case DSGA_OP_SAR:  return (int32_t)(S)last_value >> ((U)value & 0x1F);
-		case DSGA_OP_TERNARY: return (last_value != 0) ? value : adjust.add_val;
+		case DSGA_OP_TERNARY: return (last_value != 0) ? value : op.add_val;
 		case DSGA_OP_EQ:   return (last_value == value) ? 1 : 0;
 		case DSGA_OP_SLT:  return ((S)last_value <  (S)value) ? 1 : 0;
 		case DSGA_OP_SGE:  return ((S)last_value >= (S)value) ? 1 : 0;
 		case DSGA_OP_SLE:  return ((S)last_value <= (S)value) ? 1 : 0;
 		case DSGA_OP_SGT:  return ((S)last_value >  (S)value) ? 1 : 0;
 		case DSGA_OP_RSUB: return value - last_value;
-		case DSGA_OP_STO_NC: _temp_store.StoreValue(adjust.divmod_val, (S)value); return last_value;
+		case DSGA_OP_STO_NC: _temp_store.StoreValue(op.divmod_val, (S)value); return last_value;
 		case DSGA_OP_ABS:  return ((S)last_value < 0) ? -((S)last_value) : (S)last_value;
 		case DSGA_OP_JZ:     return handle_jump(value == 0, value);
 		case DSGA_OP_JNZ:    return handle_jump(value != 0, value);
@@ -245,113 +260,508 @@ static U EvalAdjustT(const DeterministicSpriteGroupAdjust &adjust, ScopeResolver
 	}
 }
 
-uint32_t EvaluateDeterministicSpriteGroupAdjust(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32_t last_value, uint32_t value)
+/* Handler of operation OP for a variable of the given size, see #DeterministicSpriteGroupOpHandler.
+ * U is the unsigned type and S is the signed type to use, ADJUST_VALUE is false if the value has already been shifted, masked and adjusted. */
+template <typename U, typename S, DeterministicSpriteGroupAdjustOperation OP, bool ADJUST_VALUE>
+static uint32_t DeterministicSpriteGroupOpHandlerT(const DeterministicSpriteGroupOp &op, ScopeResolver *scope, uint32_t last_value, uint32_t value, const DeterministicSpriteGroupOp **op_iter)
+{
+	if constexpr (ADJUST_VALUE) value = EvalAdjustValueT<S>(op, value);
+	return EvalOperationT<U, S, OP>(op, scope, (U)last_value, value, op_iter);
+}
+
+/* Make the table of handlers of the operations from FIRST onwards. */
+template <typename U, typename S, bool ADJUST_VALUE, uint8_t FIRST, size_t... I>
+static constexpr std::array<DeterministicSpriteGroupOpHandler, sizeof...(I)> MakeDeterministicSpriteGroupOpHandlerTable(std::index_sequence<I...>)
+{
+	return { &DeterministicSpriteGroupOpHandlerT<U, S, static_cast<DeterministicSpriteGroupAdjustOperation>(FIRST + I), ADJUST_VALUE>... };
+}
+
+/* Get the handler of an operation for a variable of the given size, U is the unsigned type and S is the signed type to use. */
+template <typename U, typename S, bool ADJUST_VALUE>
+static DeterministicSpriteGroupOpHandler GetDeterministicSpriteGroupOpHandlerT(DeterministicSpriteGroupAdjustOperation operation)
+{
+	static constexpr auto basic = MakeDeterministicSpriteGroupOpHandlerTable<U, S, ADJUST_VALUE, 0>(std::make_index_sequence<DSGA_OP_END>());
+	static constexpr auto special = MakeDeterministicSpriteGroupOpHandlerTable<U, S, ADJUST_VALUE, DSGA_OP_TERNARY>(std::make_index_sequence<DSGA_OP_SPECIAL_END - DSGA_OP_TERNARY>());
+
+	if (operation < DSGA_OP_END) return basic[operation];
+	if (operation >= DSGA_OP_TERNARY && operation < DSGA_OP_SPECIAL_END) return special[operation - DSGA_OP_TERNARY];
+
+	/* Unknown operations return the value */
+	return &DeterministicSpriteGroupOpHandlerT<U, S, DSGA_OP_END, ADJUST_VALUE>;
+}
+
+/**
+ * Get the handler of an operation.
+ * @param size The variable size of the group.
+ * @param operation The operation.
+ * @param adjust_value Whether the handler has to shift, mask and adjust the value, this is false for pre-evaluated constants.
+ * @return The handler.
+ */
+static DeterministicSpriteGroupOpHandler GetDeterministicSpriteGroupOpHandler(DeterministicSpriteGroupSize size, DeterministicSpriteGroupAdjustOperation operation, bool adjust_value)
 {
 	switch (size) {
-		case DSG_SIZE_BYTE:  return EvalAdjustT<uint8_t,  int8_t> (adjust, scope, last_value, value); break;
-		case DSG_SIZE_WORD:  return EvalAdjustT<uint16_t, int16_t>(adjust, scope, last_value, value); break;
-		case DSG_SIZE_DWORD: return EvalAdjustT<uint32_t, int32_t>(adjust, scope, last_value, value); break;
+		case DSG_SIZE_BYTE:  return adjust_value ? GetDeterministicSpriteGroupOpHandlerT<uint8_t,  int8_t,  true>(operation) : GetDeterministicSpriteGroupOpHandlerT<uint8_t,  int8_t,  false>(operation);
+		case DSG_SIZE_WORD:  return adjust_value ? GetDeterministicSpriteGroupOpHandlerT<uint16_t, int16_t, true>(operation) : GetDeterministicSpriteGroupOpHandlerT<uint16_t, int16_t, false>(operation);
+		case DSG_SIZE_DWORD: return adjust_value ? GetDeterministicSpriteGroupOpHandlerT<uint32_t, int32_t, true>(operation) : GetDeterministicSpriteGroupOpHandlerT<uint32_t, int32_t, false>(operation);
 		default: NOT_REACHED();
 	}
 }
 
-static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint32_t value)
+/**
+ * Copy the fields of an adjust to an op, other than the load and the handler.
+ * @param op The op to fill in.
+ * @param adjust The adjust.
+ */
+static void CopyDeterministicSpriteGroupAdjustToOp(DeterministicSpriteGroupOp &op, const DeterministicSpriteGroupAdjust &adjust)
 {
-	return range.high < value;
+	op.operation = adjust.operation;
+	op.type = adjust.type;
+	op.adjust_flags = adjust.adjust_flags;
+	op.shift_num = adjust.shift_num;
+	op.variable = adjust.variable;
+	op.parameter = adjust.parameter;
+	op.and_mask = adjust.and_mask;
+	op.add_val = adjust.add_val;
+	op.divmod_val = adjust.divmod_val;
+	if (adjust.variable == 0x7E) {
+		op.subroutine = adjust.subroutine;
+	} else {
+		op.jump = adjust.jump;
+	}
 }
 
-const SpriteGroup *DeterministicSpriteGroup::HandleResultGroup(const SpriteGroup *group, ResolverObject &object) const
+uint32_t EvaluateDeterministicSpriteGroupAdjust(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32_t last_value, uint32_t value)
 {
-	if (group != nullptr && group->type == SGT_CALCULATED_RESULT) {
-		static CallbackResultSpriteGroup nvarzero(0);
-		nvarzero.result = GB(object.last_value, 0, 15);
-		return &nvarzero;
-	}
-
-	return SpriteGroup::Resolve(group, object, false);
+	DeterministicSpriteGroupOp op;
+	CopyDeterministicSpriteGroupAdjustToOp(op, adjust);
+	return GetDeterministicSpriteGroupOpHandler(size, adjust.operation, true)(op, scope, last_value, value, nullptr);
 }
 
-const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+/**
+ * Resolve a procedure call (variable 0x7E) of a deterministic sprite group.
+ * @param group The calling group.
+ * @param subroutine The group to call.
+ * @param object The resolver object.
+ * @return The callback result of the procedure, or UINT16_MAX on failure.
+ */
+static uint32_t ResolveDeterministicSpriteGroupProcedure(const DeterministicSpriteGroup &group, const SpriteGroup *subroutine, ResolverObject &object)
 {
-	if ((this->sg_flags & SGF_SKIP_CB) != 0 && object.callback > 1) {
-		static CallbackResultSpriteGroup cbfail(CALLBACK_FAILED);
-		return &cbfail;
+	const Vehicle *relative_scope_vehicle = nullptr;
+	VarSpriteGroupScopeOffset relative_scope_cached_count = 0;
+	if (group.var_scope == VSG_SCOPE_RELATIVE) {
+		/* Save relative scope vehicle in case it will be changed during the procedure */
+		VehicleResolverObject *veh_object = dynamic_cast<VehicleResolverObject *>(&object);
+		if (veh_object != nullptr) {
+			relative_scope_vehicle = veh_object->relative_scope.v;
+			relative_scope_cached_count = veh_object->cached_relative_count;
+		}
 	}
 
-	uint32_t last_value = 0;
-	uint32_t value = 0;
+	uint32_t value;
+	const SpriteGroup *result = SpriteGroup::Resolve(subroutine, object, false);
+	if (result == nullptr) {
+		value = UINT16_MAX;
+	} else {
+		value = result->GetCallbackResult();
+		if (value == CALLBACK_FAILED) value = UINT16_MAX;
+	}
 
-	ScopeResolver *scope = object.GetScope(this->var_scope, this->var_scope_count);
+	if (relative_scope_vehicle != nullptr) {
+		/* Reset relative scope vehicle in case it was changed during the procedure */
+		VehicleResolverObject *veh_object = static_cast<VehicleResolverObject *>(&object);
+		veh_object->relative_scope.v = relative_scope_vehicle;
+		veh_object->cached_relative_count = relative_scope_cached_count;
+	}
 
-	const DeterministicSpriteGroupAdjust *end = this->adjusts.data() + this->adjusts.size();
-	for (const DeterministicSpriteGroupAdjust *iter = this->adjusts.data(); iter != end; ++iter) {
-		const DeterministicSpriteGroupAdjust &adjust = *iter;
+	return value;
+}
 
-		if ((adjust.adjust_flags & DSGAF_SKIP_ON_ZERO) && (last_value == 0)) continue;
-		if ((adjust.adjust_flags & DSGAF_SKIP_ON_LSB_SET) && (last_value & 1) != 0) continue;
+/**
+ * Execute the compiled ops of a deterministic sprite group.
+ * TScope is the type of the scope resolver if the scope variables are read directly, or ScopeResolver to use the virtual ScopeResolver::GetVariable.
+ * @param group The group.
+ * @param object The resolver object.
+ * @param scope The scope resolver of the group, this must be exactly of type TScope unless that is ScopeResolver.
+ * @param[out] result The resulting value, only valid if true is returned.
+ * @return False if a variable was not available.
+ */
+template <typename TScope>
+static bool ExecuteDeterministicSpriteGroupOps(const DeterministicSpriteGroup &group, ResolverObject &object, ScopeResolver *scope, uint32_t &result)
+{
+	uint32_t last_value = 0;
+
+	const DeterministicSpriteGroupOp *end = group.ops.data() + group.ops.size();
+	for (const DeterministicSpriteGroupOp *iter = group.ops.data(); iter != end; ++iter) {
+		const DeterministicSpriteGroupOp &op = *iter;
+
+		if ((op.adjust_flags & DSGAF_SKIP_ON_ZERO) && (last_value == 0)) continue;
+		if ((op.adjust_flags & DSGAF_SKIP_ON_LSB_SET) && (last_value & 1) != 0) continue;
 
 		/* Try to get the variable. We shall assume it is available, unless told otherwise. */
-		GetVariableExtra extra(adjust.and_mask << adjust.shift_num);
-		if (adjust.variable == 0x7E) {
-			const Vehicle *relative_scope_vehicle = nullptr;
-			VarSpriteGroupScopeOffset relative_scope_cached_count = 0;
-			if (this->var_scope == VSG_SCOPE_RELATIVE) {
-				/* Save relative scope vehicle in case it will be changed during the procedure */
-				VehicleResolverObject *veh_object = dynamic_cast<VehicleResolverObject *>(&object);
-				if (veh_object != nullptr) {
-					relative_scope_vehicle = veh_object->relative_scope.v;
-					relative_scope_cached_count = veh_object->cached_relative_count;
+		uint32_t value;
+		switch (op.load) {
+			case DSGOL_CONSTANT:        value = op.parameter; break; // Already shifted, masked and adjusted, the handler does not do so again
+			case DSGOL_CALLBACK:        value = object.callback; break;
+			case DSGOL_CALLBACK_PARAM1: value = object.callback_param1; break;
+			case DSGOL_CALLBACK_PARAM2: value = object.callback_param2; break;
+			case DSGOL_LAST_VALUE:      value = object.last_value; break;
+			case DSGOL_RANDOM:          value = (scope->GetRandomBits() << 8) | scope->GetRandomTriggers(); break;
+			case DSGOL_TEMP_STORE:      value = _temp_store.GetValue(op.parameter); break;
+			case DSGOL_GRF_PARAM:       value = (object.grffile == nullptr) ? 0 : object.grffile->GetParam(op.parameter); break;
+
+			case DSGOL_PROCEDURE:
+				/* Note: 'last_value' and 'reseed' are shared between the main chain and the procedure */
+				value = ResolveDeterministicSpriteGroupProcedure(group, op.subroutine, object);
+				break;
+
+			case DSGOL_INDIRECT: {
+				_sprite_group_resolve_check_veh_check = false;
+				GetVariableExtra extra(op.and_mask << op.shift_num);
+				value = GetVariable(object, scope, op.parameter, last_value, extra);
+				if (!extra.available) return false;
+				break;
+			}
+
+			case DSGOL_GLOBAL:
+				if (GetGlobalVariable(op.variable, &value, object.grffile)) break;
+				[[fallthrough]];
+
+			case DSGOL_SCOPE: {
+				GetVariableExtra extra(op.and_mask << op.shift_num);
+				if constexpr (std::is_same_v<TScope, ScopeResolver>) {
+					value = scope->GetVariable(op.variable, op.parameter, extra);
+				} else {
+					/* Non-virtual call, the type of the scope has been checked by the caller */
+					value = static_cast<const TScope *>(scope)->TScope::GetVariable(op.variable, op.parameter, extra);
 				}
+				if (!extra.available) return false;
+				break;
 			}
 
-			const SpriteGroup *subgroup = SpriteGroup::Resolve(adjust.subroutine, object, false);
-			if (subgroup == nullptr) {
-				value = UINT16_MAX;
-			} else {
-				value = subgroup->GetCallbackResult();
-				if (value == CALLBACK_FAILED) value = UINT16_MAX;
+			default: NOT_REACHED();
+		}
+
+		last_value = op.handler(op, scope, last_value, value, &iter);
+	}
+
+	result = last_value;
+	return true;
+}
+
+/* Pre-evaluate the adjusted value of variable 0x1A for a variable of the given size, S is the signed type to use.
+ * This is not done when the adjustment would fail at run time, so that it still fails at the same point. */
+template <typename S>
+static bool EvalConstantAdjustValueT(const DeterministicSpriteGroupAdjust &adjust, uint32_t &value)
+{
+	if ((adjust.type == DSGA_TYPE_DIV || adjust.type == DSGA_TYPE_MOD) && ((S)adjust.divmod_val == 0 || (S)adjust.divmod_val == -1)) return false;
+
+	value = EvalAdjustValueT<S>(adjust, UINT_MAX);
+	return true;
+}
+
+static constexpr size_t DSG_RANGE_TABLE_MAX_SIZE = 256; ///< Maximum number of values covered by DeterministicSpriteGroup::range_table.
+
+/**
+ * Compile #adjusts into #ops, and #ranges into #range_table where they cover a small enough span of values.
+ * This must be called after the adjusts or ranges have been changed (see #InvalidateCompiled), before the group is resolved.
+ */
+void DeterministicSpriteGroup::Compile()
+{
+	this->ops.clear();
+	this->ops.reserve(this->adjusts.size());
+
+	for (const DeterministicSpriteGroupAdjust &adjust : this->adjusts) {
+		DeterministicSpriteGroupOp &op = this->ops.emplace_back();
+		CopyDeterministicSpriteGroupAdjustToOp(op, adjust);
+
+		switch (adjust.variable) {
+			case 0x0C: op.load = DSGOL_CALLBACK; break;
+			case 0x10: op.load = DSGOL_CALLBACK_PARAM1; break;
+			case 0x18: op.load = DSGOL_CALLBACK_PARAM2; break;
+			case 0x1C: op.load = DSGOL_LAST_VALUE; break;
+			case 0x5F: op.load = DSGOL_RANDOM; break;
+			case 0x7B: op.load = DSGOL_INDIRECT; break;
+			case 0x7D: op.load = DSGOL_TEMP_STORE; break;
+			case 0x7E: op.load = DSGOL_PROCEDURE; break;
+			case 0x7F: op.load = DSGOL_GRF_PARAM; break;
+
+			case 0x1A: {
+				/* Variable 0x1A is always UINT_MAX, so the adjusted value can be calculated now */
+				bool is_constant;
+				switch (this->size) {
+					case DSG_SIZE_BYTE:  is_constant = EvalConstantAdjustValueT<int8_t> (adjust, op.parameter); break;
+					case DSG_SIZE_WORD:  is_constant = EvalConstantAdjustValueT<int16_t>(adjust, op.parameter); break;
+					case DSG_SIZE_DWORD: is_constant = EvalConstantAdjustValueT<int32_t>(adjust, op.parameter); break;
+					default: NOT_REACHED();
+				}
+				op.load = is_constant ? DSGOL_CONSTANT : DSGOL_GLOBAL;
+				break;
 			}
 
-			if (relative_scope_vehicle != nullptr) {
-				/* Reset relative scope vehicle in case it was changed during the procedure */
-				VehicleResolverObject *veh_object = static_cast<VehicleResolverObject *>(&object);
-				veh_object->relative_scope.v = relative_scope_vehicle;
-				veh_object->cached_relative_count = relative_scope_cached_count;
+			default:
+				op.load = (adjust.variable < 0x40) ? DSGOL_GLOBAL : DSGOL_SCOPE;
+				break;
+		}
+
+		op.handler = GetDeterministicSpriteGroupOpHandler(this->size, op.operation, op.load != DSGOL_CONSTANT);
+	}
+
+	/* The ranges are sorted and do not overlap, a table is only used where a binary search would otherwise be needed */
+	this->range_table.clear();
+	this->range_table_base = 0;
+	if (this->ranges.size() > 4 && this->ranges.size() < UINT8_MAX) {
+		const uint32_t low = this->ranges.front().low;
+		const uint32_t high = this->ranges.back().high;
+		if (high - low < DSG_RANGE_TABLE_MAX_SIZE) {
+			this->range_table_base = low;
+			this->range_table.resize(high - low + 1, 0);
+			for (size_t i = 0; i < this->ranges.size(); i++) {
+				const DeterministicSpriteGroupRange &range = this->ranges[i];
+				for (uint32_t offset = range.low - low; offset <= range.high - low; offset++) {
+					this->range_table[offset] = static_cast<uint8_t>(i + 1);
+				}
 			}
+		}
+	}
 
-			/* Note: 'last_value' and 'reseed' are shared between the main chain and the procedure */
-		} else if (adjust.variable == 0x7B) {
-			_sprite_group_resolve_check_veh_check = false;
-			value = GetVariable(object, scope, adjust.parameter, last_value, extra);
-		} else {
-			value = GetVariable(object, scope, adjust.variable, adjust.parameter, extra);
+	/* Scope variables of the most used features are read without a virtual call when the scope resolver has the expected type */
+	switch (GetGrfSpecFeatureForScope(this->feature, this->var_scope)) {
+		case GrfSpecFeature::Trains:
+		case GrfSpecFeature::RoadVehicles:
+		case GrfSpecFeature::Ships:
+		case GrfSpecFeature::Aircraft:
+			this->scope_binding = DSGSB_VEHICLE;
+			break;
+
+		case GrfSpecFeature::Stations:
+			this->scope_binding = DSGSB_STATION;
+			break;
+
+		default:
+			this->scope_binding = DSGSB_NONE;
+			break;
+	}
+
+	this->dsg_flags |= DSGF_COMPILED;
+}
+
+/**
+ * Compile all deterministic sprite groups, this is done once all NewGRFs have been loaded and optimised.
+ */
+void CompileDeterministicSpriteGroups()
+{
+	for (SpriteGroup *group : SpriteGroup::Iterate()) {
+		if (group->type == SGT_DETERMINISTIC) static_cast<DeterministicSpriteGroup *>(group)->Compile();
+	}
+}
+
+/** Key of a memoised callback result. */
+struct CallbackMemoKey {
+	const SpriteGroup *root_spritegroup;
+	const GRFFile *grffile;
+	CallbackID callback;
+	uint32_t callback_param1;
+	uint32_t callback_param2;
+	uint64_t self_generation; ///< Vehicle::newgrf_cache_generation of the vehicle of the SELF scope for #SGF_CALLBACK_MEMO_SELF, otherwise 0.
+
+	bool operator==(const CallbackMemoKey &other) const = default;
+};
+
+struct CallbackMemoKeyHash {
+	size_t operator()(const CallbackMemoKey &key) const noexcept
+	{
+		uint64_t hash = reinterpret_cast<uintptr_t>(key.root_spritegroup);
+		hash = (hash * 0x9E3779B97F4A7C15ULL) ^ reinterpret_cast<uintptr_t>(key.grffile);
+		hash = (hash * 0x9E3779B97F4A7C15ULL) ^ ((static_cast<uint64_t>(key.callback) << 32) | key.callback_param1);
+		hash = (hash * 0x9E3779B97F4A7C15ULL) ^ key.callback_param2;
+		hash = (hash * 0x9E3779B97F4A7C15ULL) ^ key.self_generation;
+		return robin_hood::hash_int(hash);
+	}
+};
+
+/** Memoised callback result. */
+struct CallbackMemoValue {
+	uint32_t last_value;
+	uint16_t result;
+	VehicleID self_vehicle; ///< Vehicle of the SELF scope for #SGF_CALLBACK_MEMO_SELF, for checking the memo.
+};
+
+static constexpr size_t CALLBACK_MEMO_MAX_ENTRIES = 1 << 16; ///< The memo is cleared when it reaches this size.
+
+/** Memo of callback results, each thread which resolves callbacks has its own. */
+struct CallbackMemo {
+	robin_hood::unordered_flat_map<CallbackMemoKey, CallbackMemoValue, CallbackMemoKeyHash> entries;
+	StateTicks state_ticks;  ///< Value of _state_ticks that the entries are valid for.
+	CalTime::Date cal_date; ///< Calendar date that the entries are valid for.
+	uint32_t generation = 0; ///< Value of _callback_memo_generation that the entries are valid for.
+};
+
+static thread_local CallbackMemo _callback_memo;
+static std::atomic<uint32_t> _callback_memo_generation = 1; ///< Incremented whenever the memos of all threads must be invalidated.
+
+/**
+ * Check whether the callback memo of this thread is valid for the current sprite groups, tick and date.
+ * @return True if the memo can be used as is.
+ */
+static bool IsNewGRFCallbackMemoValid()
+{
+	return _callback_memo.generation == _callback_memo_generation.load(std::memory_order_relaxed) &&
+			_callback_memo.state_ticks == _state_ticks && _callback_memo.cal_date == CalTime::CurDate();
+}
+
+/**
+ * Clear the callback memos of all threads.
+ * This must be called whenever the sprite groups are freed or changed.
+ */
+void ClearNewGRFCallbackMemo()
+{
+	_callback_memo.entries.clear();
+	_callback_memo_generation++;
+}
+
+/**
+ * Resolve a callback of a root sprite group with #SGF_CALLBACK_MEMO set.
+ * The result of these groups is a pure function of the callback ID and parameters, the GRF parameters,
+ * and of global variables which do not change during a tick, so results are memoised until the tick or the calendar date changes.
+ * With #SGF_CALLBACK_MEMO_SELF the result also depends on the cached NewGRF variables of the vehicle of the SELF scope,
+ * so results are additionally keyed by the generation of that cache, which changes whenever it is invalidated.
+ * The resolver state is left as if the group had been resolved.
+ * @return Callback result.
+ */
+uint16_t ResolverObject::ResolveMemoisedCallback()
+{
+	auto resolve = [&]() -> uint16_t {
+		const SpriteGroup *result = this->Resolve();
+		return result != nullptr ? result->GetCallbackResult() : CALLBACK_FAILED;
+	};
+
+	uint64_t self_generation = 0;
+	VehicleID self_vehicle = VehicleID::Invalid();
+	if (this->root_spritegroup->sg_flags & SGF_CALLBACK_MEMO_SELF) {
+		const Vehicle *v = this->GetCallbackMemoSelfVehicle();
+		if (v == nullptr) return resolve();
+		self_generation = v->newgrf_cache_generation;
+		self_vehicle = v->index;
+	}
+
+	if (!IsNewGRFCallbackMemoValid() || _callback_memo.entries.size() >= CALLBACK_MEMO_MAX_ENTRIES) {
+		_callback_memo.entries.clear();
+		_callback_memo.state_ticks = _state_ticks;
+		_callback_memo.cal_date = CalTime::CurDate();
+		_callback_memo.generation = _callback_memo_generation.load(std::memory_order_relaxed);
+	}
+
+	const CallbackMemoKey key{ this->root_spritegroup, this->grffile, this->callback, this->callback_param1, this->callback_param2, self_generation };
+	auto iter = _callback_memo.entries.find(key);
+	if (iter != _callback_memo.entries.end()) {
+		this->ResetState();
+		_temp_store.ClearChanges();
+		this->last_value = iter->second.last_value;
+
+		/* The profilers are not thread-safe, resolves on other threads are not profiled */
+		if (IsMainThread()) {
+			auto profiler = std::ranges::find(_newgrf_profilers, this->grffile, &NewGRFProfiler::grffile);
+			if (profiler != _newgrf_profilers.end() && profiler->active) profiler->MemoisedResolve(*this, iter->second.result);
 		}
+		return iter->second.result;
+	}
+
+	uint16_t result = resolve();
+	_callback_memo.entries.emplace(key, CallbackMemoValue{ this->last_value, result, self_vehicle });
+	return result;
+}
 
-		if (!extra.available) {
-			/* Unsupported variable: skip further processing and return either
-			 * the group from the first range or the default group. */
-			return SpriteGroup::Resolve(this->error_group, object, false);
+/**
+ * Check that all entries in the callback memo match the result of resolving the callback again.
+ * @param log Output for mismatches.
+ */
+void NewGRFCallbackMemoCheckCaches(std::function<void(std::string_view)> log)
+{
+	if (!IsNewGRFCallbackMemoValid()) return;
+
+	auto check = [&](ResolverObject &object, const CallbackMemoKey &key, const CallbackMemoValue &value) {
+		object.grffile = key.grffile;
+		object.root_spritegroup = key.root_spritegroup;
+		const SpriteGroup *group = object.Resolve();
+		uint16_t result = group != nullptr ? group->GetCallbackResult() : CALLBACK_FAILED;
+		if (result != value.result || object.last_value != value.last_value) {
+			log(fmt::format("NewGRF callback memo mismatch: group {}, callback 0x{:X}, param1 0x{:X}, param2 0x{:X}, vehicle {}, (memo: {:X}/{:X}, resolved: {:X}/{:X})",
+					key.root_spritegroup->nfo_line, (uint)key.callback, key.callback_param1, key.callback_param2, value.self_vehicle, value.result, value.last_value, result, object.last_value));
 		}
+	};
 
-		switch (this->size) {
-			case DSG_SIZE_BYTE:  value = EvalAdjustT<uint8_t,  int8_t> (adjust, scope, last_value, value, &iter); break;
-			case DSG_SIZE_WORD:  value = EvalAdjustT<uint16_t, int16_t>(adjust, scope, last_value, value, &iter); break;
-			case DSG_SIZE_DWORD: value = EvalAdjustT<uint32_t, int32_t>(adjust, scope, last_value, value, &iter); break;
-			default: NOT_REACHED();
+	for (const auto &[key, value] : _callback_memo.entries) {
+		if (key.self_generation == 0) {
+			ResolverObject object(key.grffile, key.callback, key.callback_param1, key.callback_param2);
+			check(object, key, value);
+		} else {
+			/* Entries of vehicles which have been deleted or whose cache has been invalidated since can not be hit any more */
+			const Vehicle *v = Vehicle::GetIfValid(value.self_vehicle);
+			if (v == nullptr || v->newgrf_cache_generation != key.self_generation) continue;
+			VehicleResolverObject object(v->engine_type, v, VehicleResolverObject::WagonOverride::None, false, key.callback, key.callback_param1, key.callback_param2);
+			check(object, key, value);
 		}
-		last_value = value;
 	}
+}
 
-	object.last_value = last_value;
+static bool RangeHighComparator(const DeterministicSpriteGroupRange &range, uint32_t value)
+{
+	return range.high < value;
+}
+
+const SpriteGroup *DeterministicSpriteGroup::HandleResultGroup(const SpriteGroup *group, ResolverObject &object) const
+{
+	if (group != nullptr && group->type == SGT_CALCULATED_RESULT) {
+		static thread_local CallbackResultSpriteGroup nvarzero(0);
+		nvarzero.result = GB(object.last_value, 0, 15);
+		return &nvarzero;
+	}
+
+	return SpriteGroup::Resolve(group, object, false);
+}
+
+const SpriteGroup *DeterministicSpriteGroup::Resolve(ResolverObject &object) const
+{
+	if ((this->sg_flags & SGF_SKIP_CB) != 0 && object.callback > 1) {
+		static CallbackResultSpriteGroup cbfail(CALLBACK_FAILED);
+		return &cbfail;
+	}
+
+	assert_msg(this->dsg_flags & DSGF_COMPILED, "Deterministic sprite group {} resolved without being compiled", this->nfo_line);
+
+	ScopeResolver *scope = object.GetScope(this->var_scope, this->var_scope_count);
+
+	uint32_t value = 0;
+	bool available;
+	if (this->scope_binding == DSGSB_VEHICLE && typeid(*scope) == typeid(VehicleScopeResolver)) {
+		available = ExecuteDeterministicSpriteGroupOps<VehicleScopeResolver>(*this, object, scope, value);
+	} else if (this->scope_binding == DSGSB_STATION && typeid(*scope) == typeid(StationScopeResolver)) {
+		available = ExecuteDeterministicSpriteGroupOps<StationScopeResolver>(*this, object, scope, value);
+	} else {
+		available = ExecuteDeterministicSpriteGroupOps<ScopeResolver>(*this, object, scope, value);
+	}
+
+	if (!available) {
+		/* Unsupported variable: skip further processing and return either
+		 * the group from the first range or the default group. */
+		return SpriteGroup::Resolve(this->error_group, object, false);
+	}
+
+	object.last_value = value;
 
 	if (this->IsCalculatedResult()) {
 		/* nvar == 0 is a special case -- we turn our value into a callback result */
-		static CallbackResultSpriteGroup nvarzero(0);
+		static thread_local CallbackResultSpriteGroup nvarzero(0);
 		nvarzero.result = GB(value, 0, 15);
 		return &nvarzero;
 	}
 
-	if (this->ranges.size() > 4) {
+	if (!this->range_table.empty()) {
+		const uint32_t offset = value - this->range_table_base;
+		if (offset < this->range_table.size() && this->range_table[offset] != 0) {
+			return this->HandleResultGroup(this->ranges[this->range_table[offset] - 1].group, object);
+		}
+	} else if (this->ranges.size() > 4) {
 		const auto &lower = std::lower_bound(this->ranges.begin(), this->ranges.end(), value, RangeHighComparator);
 		if (lower != this->ranges.end() && lower->low <= value) {
 			assert(lower->low <= value && value <= lower->high);
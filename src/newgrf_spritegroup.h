@@ -15,11 +15,13 @@
 #include "engine_type.h"
 #include "house_type.h"
 #include "industry_type.h"
+#include "vehicle_type.h"
 
 #include "newgrf_callbacks.h"
 #include "newgrf_generic.h"
 #include "newgrf_storage.h"
 #include "newgrf_commons.h"
+#include "debug_trace.h"
 
 #include "3rdparty/svector/svector.h"
 
@@ -34,13 +36,13 @@
  */
 inline uint32_t GetRegister(uint i)
 {
-	extern TemporaryStorageArray<int32_t, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 	return _temp_store.GetValue(i);
 }
 
 inline const std::span<const int32_t> GetRegisterRange(uint start)
 {
-	extern TemporaryStorageArray<int32_t, 0x110> _temp_store;
+	extern thread_local TemporaryStorageArray<int32_t, 0x110> _temp_store;
 	return _temp_store.GetValueRange(start);
 }
 
@@ -58,6 +60,7 @@ enum SpriteGroupType : uint8_t {
 
 struct SpriteGroup;
 struct ResolverObject;
+struct ScopeResolver;
 
 /* SPRITE_WIDTH is 24. ECS has roughly 30 sprite groups per real sprite.
  * Adding an 'extra' margin would be assuming 64 sprite groups per real
@@ -72,6 +75,8 @@ enum SpriteGroupFlags : uint8_t {
 	SGF_ACTION6                  = 1 << 0,
 	SGF_INLINING                 = 1 << 1,
 	SGF_SKIP_CB                  = 1 << 2,
+	SGF_CALLBACK_MEMO            = 1 << 3, ///< Callback results only depend on the callback parameters and tick-stable state, see ResolverObject::ResolveMemoisedCallback.
+	SGF_CALLBACK_MEMO_SELF       = 1 << 4, ///< With #SGF_CALLBACK_MEMO, callback results also depend on the cached NewGRF variables of the vehicle of the SELF scope.
 };
 DECLARE_ENUM_AS_BIT_SET(SpriteGroupFlags)
 
@@ -507,6 +512,65 @@ struct DeterministicSpriteGroupAdjust {
 	};
 };
 
+/** Source of the input value of a #DeterministicSpriteGroupOp. */
+enum DeterministicSpriteGroupOpLoad : uint8_t {
+	DSGOL_CONSTANT,        ///< Constant value, already shifted, masked and adjusted, this is stored in DeterministicSpriteGroupOp::parameter.
+	DSGOL_CALLBACK,        ///< Variable 0x0C.
+	DSGOL_CALLBACK_PARAM1, ///< Variable 0x10.
+	DSGOL_CALLBACK_PARAM2, ///< Variable 0x18.
+	DSGOL_LAST_VALUE,      ///< Variable 0x1C.
+	DSGOL_RANDOM,          ///< Variable 0x5F.
+	DSGOL_INDIRECT,        ///< Variable 0x7B.
+	DSGOL_TEMP_STORE,      ///< Variable 0x7D.
+	DSGOL_PROCEDURE,       ///< Variable 0x7E.
+	DSGOL_GRF_PARAM,       ///< Variable 0x7F.
+	DSGOL_GLOBAL,          ///< Other variables below 0x40, these are global variables or else scope variables.
+	DSGOL_SCOPE,           ///< Other variables, these are scope variables.
+};
+
+struct DeterministicSpriteGroupOp;
+
+/**
+ * Implementation of the shift, mask, adjustment and operation of a #DeterministicSpriteGroupOp,
+ * specialised for the operation and for the variable size of the group.
+ * @param op The op.
+ * @param scope The scope resolver of the group.
+ * @param last_value The value of the previous op.
+ * @param value The loaded value.
+ * @param[in,out] op_iter The current op, jumps move this forward. If this is \c nullptr, jumps are not taken.
+ * @return The new value.
+ */
+using DeterministicSpriteGroupOpHandler = uint32_t (*)(const DeterministicSpriteGroupOp &op, ScopeResolver *scope, uint32_t last_value, uint32_t value, const DeterministicSpriteGroupOp **op_iter);
+
+/**
+ * Compiled form of a #DeterministicSpriteGroupAdjust, as executed by DeterministicSpriteGroup::Resolve.
+ * The source of the value is decoded up front, and constant values are pre-evaluated.
+ */
+struct DeterministicSpriteGroupOp {
+	DeterministicSpriteGroupOpHandler handler = nullptr;
+	DeterministicSpriteGroupOpLoad load{};
+	DeterministicSpriteGroupAdjustOperation operation{};
+	DeterministicSpriteGroupAdjustType type{};
+	DeterministicSpriteGroupAdjustFlags adjust_flags = DSGAF_NONE;
+	uint8_t shift_num = 0;
+	uint16_t variable = 0;
+	uint32_t parameter = 0;
+	uint32_t and_mask = 0;
+	uint32_t add_val = 0;
+	uint32_t divmod_val = 0;
+	union {
+		const SpriteGroup *subroutine = nullptr;
+		uint32_t jump;
+	};
+};
+
+/** Scope resolver types whose variables are read directly instead of through the virtual ScopeResolver::GetVariable. */
+enum DeterministicSpriteGroupScopeBinding : uint8_t {
+	DSGSB_NONE,    ///< Any scope resolver.
+	DSGSB_VEHICLE, ///< VehicleScopeResolver.
+	DSGSB_STATION, ///< StationScopeResolver.
+};
+
 struct DeterministicSpriteGroupRange {
 	const SpriteGroup *group = nullptr;
 	uint32_t low = 0;
@@ -524,6 +588,7 @@ enum DeterministicSpriteGroupFlags : uint16_t {
 	DSGF_CB_HANDLER              = 1 << 6,
 	DSGF_INLINE_CANDIDATE        = 1 << 7,
 	DSGF_CALCULATED_RESULT       = 1 << 8,
+	DSGF_COMPILED                = 1 << 9, ///< The ops and range table are up to date with the adjusts and ranges, see DeterministicSpriteGroup::Compile.
 };
 DECLARE_ENUM_AS_BIT_SET(DeterministicSpriteGroupFlags)
 
@@ -537,7 +602,11 @@ struct DeterministicSpriteGroup final : SpecializedSpriteGroup<DeterministicSpri
 	DeterministicSpriteGroupSize size{};
 	DeterministicSpriteGroupFlags dsg_flags = DSGF_NONE;
 	std::vector<DeterministicSpriteGroupAdjust> adjusts{};
+	std::vector<DeterministicSpriteGroupOp> ops{};         ///< Compiled adjusts, see #Compile.
 	std::vector<DeterministicSpriteGroupRange> ranges{}; // Dynamically allocated
+	std::vector<uint8_t> range_table{};                    ///< Compiled ranges, for each value from #range_table_base the index in #ranges plus one, or 0 for the default group. Empty if the ranges are not compiled to a table.
+	uint32_t range_table_base = 0;                         ///< First value of #range_table.
+	DeterministicSpriteGroupScopeBinding scope_binding{};  ///< Expected type of the scope resolver, see #Compile.
 
 	/* Dynamically allocated, this is the sole owner */
 	const SpriteGroup *default_group = nullptr;
@@ -549,6 +618,14 @@ struct DeterministicSpriteGroup final : SpecializedSpriteGroup<DeterministicSpri
 
 	bool IsCalculatedResult() const { return this->dsg_flags & DSGF_CALCULATED_RESULT; }
 
+	void Compile();
+
+	/**
+	 * Mark the compiled ops and range table as out of date, this must be called before changing the adjusts or ranges.
+	 * The group must be compiled again before it is resolved.
+	 */
+	void InvalidateCompiled() { this->dsg_flags &= ~DSGF_COMPILED; }
+
 protected:
 	const SpriteGroup *Resolve(ResolverObject &object) const override;
 
@@ -707,6 +784,12 @@ struct ScopeResolver {
  *
  * Using this interface #SpriteGroup-chains (action 1-2-3 chains) can be resolved,
  * to get the results of callbacks, rerandomisations or normal sprite lookups.
+ *
+ * Resolvers may be used concurrently on different threads: the temporary storage (registers)
+ * and the callback memo are thread-local, and the random trigger state is held in the resolver.
+ * However, scope variables which fill object caches on first use (e.g. the vehicle #NewGRFCache)
+ * must not be evaluated concurrently for the same object, and persistent storage must only be
+ * written from the game loop.
  */
 struct ResolverObject {
 	/**
@@ -747,6 +830,7 @@ public:
 	template <typename TSpriteGroup = SpriteGroup>
 	const TSpriteGroup *Resolve()
 	{
+		TraceZone trace_zone("NewGRF resolve", _trace_newgrf_enabled);
 		this->ResetState();
 		const SpriteGroup *sg = SpriteGroup::Resolve(this->root_spritegroup, *this);
 		if constexpr (!std::is_same_v<TSpriteGroup, SpriteGroup>) {
@@ -777,6 +861,7 @@ public:
 	 */
 	uint16_t ResolveCallback()
 	{
+		if (this->root_spritegroup != nullptr && (this->root_spritegroup->sg_flags & SGF_CALLBACK_MEMO) != 0) return this->ResolveMemoisedCallback();
 		const SpriteGroup *result = this->Resolve();
 		return result != nullptr ? result->GetCallbackResult() : CALLBACK_FAILED;
 	}
@@ -831,6 +916,12 @@ public:
 	 */
 	virtual uint32_t GetDebugID() const { return 0; }
 
+	/**
+	 * Get the vehicle of the SELF scope, whose cached NewGRF variables are read by groups with #SGF_CALLBACK_MEMO_SELF.
+	 * @return The vehicle, or nullptr if there is none.
+	 */
+	virtual const Vehicle *GetCallbackMemoSelfVehicle() const { return nullptr; }
+
 private:
 	/**
 	 * Resets the dynamic state of the resolver object.
@@ -843,6 +934,8 @@ private:
 		this->used_random_triggers = 0;
 		this->reseed.fill(0);
 	}
+
+	uint16_t ResolveMemoisedCallback();
 };
 
 /**
@@ -874,5 +967,7 @@ struct SpecializedResolverObject : public ResolverObject {
 };
 
 uint32_t EvaluateDeterministicSpriteGroupAdjust(DeterministicSpriteGroupSize size, const DeterministicSpriteGroupAdjust &adjust, ScopeResolver *scope, uint32_t last_value, uint32_t value);
+void CompileDeterministicSpriteGroups();
+void ClearNewGRFCallbackMemo();
 
 #endif /* NEWGRF_SPRITEGROUP_H */
@@ -1037,6 +1037,7 @@ int openttd_main(std::span<char * const> arguments)
 
 	VideoDriver::GetInstance()->MainLoop();
 
+	StopSpriteCachePreload();
 	_general_worker_pool.Stop();
 
 	PostMainLoop();
@@ -1819,6 +1820,7 @@ void GameLoop()
 		if (_exit_game) return;
 	}
 
+	UpdateSpriteCachePreload();
 	IncreaseSpriteLRU();
 
 	/* Check for UDP stuff */
@@ -1202,6 +1202,8 @@ private:
 
 	std::vector<DispatchSchedule> dispatch_schedules{}; ///< Scheduled dispatch schedules
 
+	uint64_t departure_state_generation = 0; ///< NOSAVE: Generation of the timetable and dispatch state which departure boards are computed from.
+
 public:
 	/**
 	 * Default constructor producing an invalid order list.
@@ -1399,6 +1401,18 @@ public:
 	 */
 	inline Ticks GetTotalDuration() const { return this->total_duration; }
 
+	/**
+	 * Gets the generation of the timetable and dispatch state of this list, which cached departure lists are keyed on.
+	 * @return the generation.
+	 */
+	inline uint64_t GetDepartureStateGeneration() const { return this->departure_state_generation; }
+
+	/**
+	 * Sets the generation of the timetable and dispatch state of this list.
+	 * @param generation the new generation, which must not have been used by any order list before.
+	 */
+	inline void SetDepartureStateGeneration(uint64_t generation) { this->departure_state_generation = generation; }
+
 	/**
 	 * Must be called if an order's timetable is changed to update internal book keeping.
 	 * @param delta By how many ticks has the timetable duration changed
@@ -326,6 +326,14 @@ void SetCurrentThreadName([[maybe_unused]] const std::string &thread_name)
 #endif /* defined(__APPLE__) */
 }
 
+void SetCurrentThreadLowPriority()
+{
+#if defined(__linux__) && defined(SCHED_IDLE)
+	sched_param param{};
+	pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif /* defined(__linux__) && defined(SCHED_IDLE) */
+}
+
 void GetCurrentThreadName(format_target &buf)
 {
 #if !defined(NO_THREADS) && defined(__GLIBC__)
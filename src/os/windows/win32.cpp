@@ -809,6 +809,11 @@ static void Win32SetThreadName(uint id, std::string_view name)
 	_thread_name_map[id] = name;
 }
 
+void SetCurrentThreadLowPriority()
+{
+	SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+}
+
 void GetCurrentThreadName(format_target &buffer)
 {
 	std::lock_guard<std::mutex> lock(_thread_name_map_mutex);
@@ -12,6 +12,7 @@
 
 #include "../../debug.h"
 #include "../../settings_type.h"
+#include "../../vehicle_cpu_stats.h"
 #include "yapf_type.hpp"
 
 /**
@@ -182,6 +183,8 @@ public:
 
 		const bool destination_found = (this->best_dest_node != nullptr);
 
+		VehiclePathfinderCostMeasurer::AddNodes(this->num_steps);
+
 		if (GetDebugLevel(DebugLevelID::yapf) >= 3) {
 			const UnitID veh_idx = (this->vehicle != nullptr) ? this->vehicle->unitnumber : 0;
 			const char ttc = Yapf().TransportTypeChar();
@@ -18,6 +18,7 @@
 #include "../../newgrf_station.h"
 #include "../../tracerestrict.h"
 #include "../../debug.h"
+#include "../../debug_trace.h"
 #include "../../misc/dbg_helpers.h"
 
 #include "../../safeguards.h"
@@ -798,6 +799,7 @@ struct CYapfAnySafeTileRailNo90 : CYapfRailBase<CYapfRail_TypesT<CYapfAnySafeTil
 
 Track YapfTrainChooseTrack(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool reserve_track, PBSTileInfo *target, TileIndex *dest)
 {
+	TraceZone trace_zone("YAPF train choose track");
 	Trackdir td_ret = _settings_game.pf.forbid_90_deg
 		? CYapfRailNo90::stChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest)
 		: CYapfRail::stChooseRailTrack(v, tile, enterdir, tracks, path_found, reserve_track, target, dest);
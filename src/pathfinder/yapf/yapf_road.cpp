@@ -12,6 +12,8 @@
 #include "yapf_node_road.hpp"
 #include "../../roadstop_base.h"
 #include "../../vehicle_func.h"
+#include "../../debug_trace.h"
+#include "../../vehicle_cpu_stats.h"
 
 #include "../../safeguards.h"
 
@@ -544,6 +546,8 @@ struct CYapfRoadAnyDepot : CYapfRoadCommon<CYapfRoad_TypesT<CYapfRoadAnyDepot, C
 
 Trackdir YapfRoadVehicleChooseTrack(const RoadVehicle *v, TileIndex tile, DiagDirection enterdir, TrackdirBits trackdirs, bool &path_found, RoadVehPathCache &path_cache)
 {
+	TraceZone trace_zone("YAPF road vehicle choose track");
+	VehiclePathfinderCostMeasurer cost(v->index);
 	Trackdir td_ret = CYapfRoad::stChooseRoadTrack(v, tile, enterdir, path_found, path_cache);
 
 	return (td_ret != INVALID_TRACKDIR) ? td_ret : (Trackdir)FindFirstBit(trackdirs);
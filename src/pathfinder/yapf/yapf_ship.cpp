@@ -10,6 +10,8 @@
 #include "../../stdafx.h"
 #include "../../ship.h"
 #include "../../vehicle_func.h"
+#include "../../debug_trace.h"
+#include "../../vehicle_cpu_stats.h"
 
 #include "yapf.hpp"
 #include "yapf_node_ship.hpp"
@@ -435,6 +437,8 @@ struct CYapfShip : CYapfT<CYapfShip_TypesT<CYapfShip>> {
 
 Track YapfShipChooseTrack(const Ship *v, TileIndex tile, bool &path_found, ShipPathCache &path_cache)
 {
+	TraceZone trace_zone("YAPF ship choose track");
+	VehiclePathfinderCostMeasurer cost(v->index);
 	Trackdir best_origin_dir = INVALID_TRACKDIR;
 	const TrackdirBits origin_dirs = TrackdirToTrackdirBits(v->GetVehicleTrackdir());
 	const Trackdir td_ret = CYapfShip::ChooseShipTrack(v, tile, origin_dirs, TRACKDIR_BIT_NONE, path_found, path_cache, best_origin_dir);
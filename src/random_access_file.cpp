@@ -15,6 +15,14 @@
 #include "fileio_func.h"
 #include "string_func.h"
 
+#if defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#elif defined(UNIX) && !defined(__EMSCRIPTEN__)
+#include <sys/mman.h>
+#define WITH_RANDOM_ACCESS_FILE_MMAP
+#endif
+
 #include "safeguards.h"
 
 /**
@@ -25,7 +33,7 @@
 RandomAccessFile::RandomAccessFile(std::string_view filename, Subdirectory subdir) : filename(filename)
 {
 	size_t file_size;
-	this->file_handle = FioFOpenFile(filename, "rb", subdir, &file_size);
+	this->file_handle = FioFOpenFile(filename, "rb", subdir, &file_size, &this->disk_filename);
 	if (!this->file_handle.has_value()) UserError("Cannot open file '{}'", filename);
 
 	/* When files are in a tar-file, the begin of the file might not be at 0. */
@@ -36,6 +44,15 @@ RandomAccessFile::RandomAccessFile(std::string_view filename, Subdirectory subdi
 	this->start_pos = pos;
 	this->end_pos = this->start_pos + file_size;
 
+	/* For files within a tar file, the name of the file is appended to the name of the tar file. */
+	if (this->start_pos != 0) {
+		if (this->disk_filename.ends_with(filename) && this->disk_filename.size() > filename.size()) {
+			this->disk_filename.resize(this->disk_filename.size() - filename.size() - 1);
+		} else {
+			this->disk_filename.clear();
+		}
+	}
+
 	/* Store the filename without path and extension */
 	auto t = filename.rfind(PATHSEPCHAR);
 	std::string name_without_path{filename.substr(t != std::string::npos ? t + 1 : 0)};
@@ -45,6 +62,56 @@ RandomAccessFile::RandomAccessFile(std::string_view filename, Subdirectory subdi
 	this->SeekToIntl(static_cast<size_t>(pos), SEEK_SET);
 }
 
+RandomAccessFile::~RandomAccessFile()
+{
+	if (this->mapped_data == nullptr) return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(this->mapped_data);
+#elif defined(WITH_RANDOM_ACCESS_FILE_MMAP)
+	munmap(this->mapped_data, this->end_pos);
+#endif
+}
+
+/**
+ * Map the file into memory, such that reads are served directly from the mapping instead of copying the data via the read buffer.
+ * This keeps the current position, when mapping is not possible the file continues to be read via the read buffer.
+ * @return True iff the file is now memory mapped.
+ */
+bool RandomAccessFile::MapIntoMemory()
+{
+	if (this->mapped_data != nullptr) return true;
+	if (this->end_pos == 0) return false;
+
+	/* Map from the start of the underlying file, as the start of a file within a tar file is not page aligned. */
+#if defined(_WIN32)
+	HANDLE mapping = CreateFileMapping(reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(*this->file_handle))), nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) return false;
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, this->end_pos);
+	/* The view keeps a reference to the mapping object. */
+	CloseHandle(mapping);
+	if (data == nullptr) {
+		Debug(misc, 1, "Memory mapping {} failed", this->filename);
+		return false;
+	}
+#elif defined(WITH_RANDOM_ACCESS_FILE_MMAP)
+	void *data = mmap(nullptr, this->end_pos, PROT_READ, MAP_PRIVATE, fileno(*this->file_handle), 0);
+	if (data == MAP_FAILED) {
+		Debug(misc, 1, "Memory mapping {} failed", this->filename);
+		return false;
+	}
+#else
+	return false;
+#endif
+
+#if defined(_WIN32) || defined(WITH_RANDOM_ACCESS_FILE_MMAP)
+	size_t pos = this->GetPos();
+	this->mapped_data = static_cast<uint8_t *>(data);
+	this->SeekToIntl(pos, SEEK_SET);
+	return true;
+#endif
+}
+
 /**
  * Get the filename of the opened file with the path from the SubDirectory and the extension.
  * @return Name of the file.
@@ -64,6 +131,15 @@ const std::string &RandomAccessFile::GetSimplifiedFilename() const
 	return this->simplified_filename;
 }
 
+/**
+ * Get the full path of the file on disk. For files within a tar file this is the path of the tar file.
+ * @return Path of the file, or an empty string if it is not known.
+ */
+const std::string &RandomAccessFile::GetDiskFilename() const
+{
+	return this->disk_filename;
+}
+
 /**
  * Get position in the file.
  * @return Position in the file.
@@ -89,6 +165,12 @@ bool RandomAccessFile::AtEndOfFile() const
  */
 void RandomAccessFile::SeekTo(size_t pos, int mode)
 {
+	if (this->mapped_data != nullptr) {
+		/* Seeking within a mapped file only moves the buffer pointer. */
+		this->SeekToIntl(pos, mode);
+		return;
+	}
+
 	if (mode == SEEK_CUR) {
 		if (this->buffer + pos <= this->buffer_end) {
 			/* Seeking within existing buffer, no need to clear and re-read buffer */
@@ -115,6 +197,14 @@ void RandomAccessFile::SeekToIntl(size_t pos, int mode)
 {
 	if (mode == SEEK_CUR) pos += this->GetPos();
 
+	if (this->mapped_data != nullptr) {
+		/* The whole remainder of the file is the read buffer. */
+		this->pos = this->end_pos;
+		this->buffer = this->mapped_data + std::min(pos, this->end_pos);
+		this->buffer_end = this->mapped_data + this->end_pos;
+		return;
+	}
+
 	this->pos = pos;
 	if (fseek(*this->file_handle, this->pos, SEEK_SET) < 0) {
 		Debug(misc, 0, "Seeking in {} failed", this->filename);
@@ -131,6 +221,9 @@ void RandomAccessFile::SeekToIntl(size_t pos, int mode)
 uint8_t RandomAccessFile::ReadByteIntl()
 {
 	if (this->buffer == this->buffer_end) {
+		/* For a mapped file this means the end of the file is reached. */
+		if (this->mapped_data != nullptr) return 0;
+
 		this->buffer = this->buffer_start;
 		size_t size = fread(this->buffer, 1, RandomAccessFile::BUFFER_SIZE, *this->file_handle);
 		this->pos += size;
@@ -177,6 +270,9 @@ void RandomAccessFile::ReadBlock(void *ptr, size_t size)
 		ptr = ((char *)ptr) + to_copy;
 	}
 
+	/* For a mapped file the buffer extends to the end of the file, so there is nothing more to read. */
+	if (this->mapped_data != nullptr) return;
+
 	/* Reset the buffer, so the next ReadByte will read bytes from the file. */
 	this->buffer = this->buffer_end = this->buffer_start;
 
@@ -28,6 +28,7 @@ class RandomAccessFile {
 
 	std::string filename;            ///< Full name of the file; relative path to subdir plus the extension of the file.
 	std::string simplified_filename; ///< Simplified lowercase name of the file; only the name, no path or extension.
+	std::string disk_filename;       ///< Full path of the file on disk, or of the tar file containing it; empty if unknown.
 
 	std::optional<FileHandle> file_handle; ///< File handle of the open file.
 	size_t pos;                      ///< Position in the file of the end of the read buffer.
@@ -38,6 +39,8 @@ class RandomAccessFile {
 	uint8_t *buffer_end;                ///< Last valid byte of buffer.
 	uint8_t buffer_start[BUFFER_SIZE];  ///< Local buffer when read from file.
 
+	uint8_t *mapped_data = nullptr;     ///< Memory mapping of the file up to #end_pos, when mapped the read buffer points directly into it.
+
 	uint8_t ReadByteIntl();
 	uint16_t ReadWordIntl();
 	uint32_t ReadDwordIntl();
@@ -49,10 +52,11 @@ public:
 	RandomAccessFile(const RandomAccessFile&) = delete;
 	void operator=(const RandomAccessFile&) = delete;
 
-	virtual ~RandomAccessFile() = default;
+	virtual ~RandomAccessFile();
 
 	const std::string &GetFilename() const;
 	const std::string &GetSimplifiedFilename() const;
+	const std::string &GetDiskFilename() const;
 
 	size_t GetPos() const;
 	size_t GetStartPos() const { return this->start_pos; }
@@ -60,6 +64,14 @@ public:
 	void SeekTo(size_t pos, int mode);
 	bool AtEndOfFile() const;
 
+	bool MapIntoMemory();
+
+	/**
+	 * Whether the file is read through a memory mapping.
+	 * @return True when the file is memory mapped.
+	 */
+	bool IsMemoryMapped() const { return this->mapped_data != nullptr; }
+
 	inline uint8_t ReadByte()
 	{
 		if (likely(this->buffer != this->buffer_end)) return *this->buffer++;
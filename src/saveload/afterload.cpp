@@ -78,12 +78,14 @@
 #include "../timer/timer_game_tick.h"
 #include "../picker_func.h"
 #include "../pathfinder/water_regions.h"
+#include "../worker_thread.h"
 
 
 #include "../sl/saveload_internal.h"
 
 #include <signal.h>
 #include <algorithm>
+#include <initializer_list>
 
 #include "table/strings.h"
 
@@ -657,6 +659,18 @@ void IterateVehicleAndOrderListOrders(F func)
 	}
 }
 
+/**
+ * Run cache rebuilds concurrently on the worker pool.
+ * None of the tasks may write state which is read or written by another of the tasks.
+ * @param tasks The tasks to run.
+ */
+static void RunIndependentAfterLoadTasks(std::initializer_list<void(*)()> tasks)
+{
+	_general_worker_pool.ParallelFor(static_cast<uint>(tasks.size()), [&](uint i) {
+		tasks.begin()[i]();
+	});
+}
+
 /**
  * Perform a (large) amount of savegame conversion *magic* in order to
  * load older savegames and to fill the caches for various purposes.
@@ -4619,15 +4633,17 @@ bool AfterLoadGame()
 
 	InitializeRoadGUI();
 
-	/* This needs to be done after conversion. */
-	RebuildViewportKdtree();
-	ViewportMapBuildTunnelCache();
-	AddIndustriesToLocationCaches();
-
 	/* Road stops is 'only' updating some caches */
 	AfterLoadRoadStops();
 	AfterLoadLabelMaps();
-	AfterLoadCompanyStats();
+
+	/* These need to be done after conversion, and only write their own caches. */
+	RunIndependentAfterLoadTasks({
+		RebuildViewportKdtree,
+		ViewportMapBuildTunnelCache,
+		AddIndustriesToLocationCaches,
+		AfterLoadCompanyStats, // Needs to be after AfterLoadLabelMaps
+	});
 	AfterLoadStoryBook();
 
 	InitializeRailGUI(); // Needs to be after AfterLoadCompanyStats
@@ -27,6 +27,7 @@
 #include "company_func.h"
 #include "date_func.h"
 #include "date_gui.h"
+#include "departures_func.h"
 #include "vehicle_gui.h"
 #include "settings_type.h"
 #include "viewport_func.h"
@@ -2249,6 +2250,7 @@ void ShowScheduledDispatchAddSlotsWindow(SchdispatchWindow *parent, WindowNumber
 
 void SchdispatchInvalidateWindows(const Vehicle *v)
 {
+	InvalidateDepartureScheduleState(v);
 	if (_pause_mode.Any()) InvalidateWindowClassesData(WindowClass::DepartureBoard);
 
 	if (!HaveWindowByClass(WindowClass::VehicleTimetable) && !HaveWindowByClass(WindowClass::ScheduledDispatchSlots) && !HaveWindowByClass(WindowClass::VehicleOrders)) return;
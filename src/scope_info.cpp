@@ -25,7 +25,7 @@
 
 #if !defined(DISABLE_SCOPE_INFO)
 
-ScopeStackRecord *_scope_stack_head = nullptr;
+thread_local ScopeStackRecord *_scope_stack_head = nullptr; ///< Per thread, so that worker threads can also push scope records.
 
 void WriteScopeLog(struct format_target &buffer)
 {
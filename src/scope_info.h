@@ -21,7 +21,7 @@ struct ScopeStackRecord {
 	ScopeStackRecord *next;
 };
 
-extern ScopeStackRecord *_scope_stack_head;
+extern thread_local ScopeStackRecord *_scope_stack_head;
 
 template <typename T>
 struct FunctorScopeStackRecord : public ScopeStackRecord {
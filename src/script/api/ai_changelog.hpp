@@ -19,6 +19,14 @@
  *
  * This version is not yet released. The following changes are not set in stone yet.
  *
+ * API additions:
+ * \li AITile::TileProperty
+ * \li AITile::ValuateList
+ * \li AITile::ValuateListCargoAcceptance
+ * \li AIVehicle::VehicleProperty
+ * \li AIVehicle::ValuateList
+ * \li AIVehicle::ValuateListCargoLoad
+ *
  * \b 15.0
  *
  * API additions:
@@ -529,6 +529,18 @@ void ScriptList::AddToItemValue(SQInteger item, SQInteger value)
 	}
 }
 
+void ScriptList::SetAllValues(const std::function<SQInteger(SQInteger)> &valuator)
+{
+	this->modifications++;
+
+	this->DropValues();
+	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); ++iter) {
+		this->SetIterValue(iter, valuator(iter->first));
+	}
+
+	ScriptController::DecreaseOps(static_cast<int>(this->items.size()));
+}
+
 void ScriptList::AddItem(SQInteger item, SQInteger value)
 {
 	this->modifications++;
@@ -592,14 +604,36 @@ void ScriptList::RemoveItem(SQInteger item)
 
 void ScriptList::InitValues()
 {
-	btree::btree_set<std::pair<SQInteger, SQInteger>> new_values;
+	/* Sort a flat copy first, such that the index can be built by appending in order. */
+	std::vector<std::pair<SQInteger, SQInteger>> flat_values;
+	flat_values.reserve(this->items.size());
 	for (const auto &iter : this->items.unprotected_view()) {
-		new_values.insert(std::make_pair(iter.second, iter.first));
+		flat_values.emplace_back(iter.second, iter.first);
+	}
+	std::sort(flat_values.begin(), flat_values.end());
+
+	btree::btree_set<std::pair<SQInteger, SQInteger>> new_values;
+	for (const auto &value : flat_values) {
+		new_values.insert(new_values.end(), value);
 	}
 	this->values.swap(new_values);
 	this->values_inited = true;
 }
 
+/**
+ * Drop the value index, such that bulk changes of the values do not have to maintain it.
+ * It is rebuilt in one go when it is needed again.
+ * This is not done while iterating the list sorted by value, as the sorter depends on the index.
+ */
+void ScriptList::DropValues()
+{
+	if (!this->values_inited) return;
+	if (this->initialized && this->sorter_type == SORT_BY_VALUE && !this->sorter->IsEnd()) return;
+
+	this->values.clear();
+	this->values_inited = false;
+}
+
 void ScriptList::InitSorter()
 {
 	if (this->sorter == nullptr) {
@@ -1180,6 +1214,9 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
+	/* Valuating changes the values of all items, rebuilding the value index afterwards is cheaper than updating it for each item. */
+	this->DropValues();
+
 	ScriptListMap::iterator begin;
 	if (disabler.GetOriginalValue() && this->resume_item.has_value()) {
 		begin = this->items.lower_bound(this->resume_item.value());
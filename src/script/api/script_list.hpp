@@ -15,6 +15,7 @@
 #include "script_controller.hpp"
 #include "../../3rdparty/cpp-btree/safe_btree_set.h"
 #include "../../3rdparty/cpp-btree/safe_btree_map.h"
+#include <functional>
 
 /** Maximum number of operations allowed for valuating a list. */
 static const int MAX_VALUATE_OPS = 1000000;
@@ -55,6 +56,7 @@ private:
 	std::optional<SQInteger> resume_item; ///< Item to use on valuation start.
 
 	void InitValues();
+	void DropValues();
 	void InitSorter();
 	void SetIterValue(ScriptListMap::iterator item_iter, SQInteger value);
 	ScriptListMap::iterator RemoveIter(ScriptListMap::iterator item_iter);
@@ -247,6 +249,13 @@ public:
 	 */
 	void AddToItemValue(SQInteger item, SQInteger value_to_add);
 
+	/**
+	 * Set the value of every item natively, for the batched valuation functions of the API.
+	 * @param valuator Function returning the value of an item.
+	 * @api -all
+	 */
+	void SetAllValues(const std::function<SQInteger(SQInteger)> &valuator);
+
 	/**
 	 * Remove a single item from the list.
 	 * @param item the item to remove. If not existing, it is ignored.
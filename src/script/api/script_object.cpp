@@ -54,7 +54,7 @@ static ScriptStorage &GetStorage()
 }
 
 
-/* static */ ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
+/* static */ thread_local ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
 
 ScriptObject::ActiveInstance::ActiveInstance(ScriptInstance &instance) : alc_scope(instance.engine.get())
 {
@@ -300,6 +300,34 @@ ScriptObject::DisableDoCommandScope::DisableDoCommandScope()
 	});
 #endif
 
+	if (!estimate_only && !asynchronous && IsRunningScriptsParallel()) {
+		/* Other scripts are running concurrently, only test the command now.
+		 * It is executed once all scripts have finished their tick, in company order. */
+		CommandCost res = ::DoCommandPScript(cmd, tile, payload, CommandCallback::None, 0, intl_flags, true, false);
+		if (res.Failed()) {
+			SetLastError(ScriptError::StringToError(res.GetErrorMessage()));
+			return false;
+		}
+		GetActiveInstance().DeferCommand(cmd, tile, payload.Clone(), callback, intl_flags);
+		throw Script_Suspend(0, nullptr);
+	}
+
+	return ScriptObject::DoCommandExecute(cmd, tile, payload, callback, intl_flags, estimate_only, asynchronous);
+}
+
+/**
+ * Execute or estimate a command for the active script, after all checks have been done.
+ * @param cmd The command to execute.
+ * @param tile The tile to execute the command on.
+ * @param payload The command payload.
+ * @param callback The callback to call when the script resumes, must not be nullptr.
+ * @param intl_flags Internal command flags.
+ * @param estimate_only Whether only the costs should be estimated.
+ * @param asynchronous Whether the command should be executed asynchronously.
+ * @return False if the command failed, true if it succeeded and the script does not need to be suspended.
+ */
+/* static */ bool ScriptObject::DoCommandExecute(Commands cmd, TileIndex tile, const CommandPayloadBase &payload, Script_SuspendCallbackProc *callback, DoCommandIntlFlag intl_flags, bool estimate_only, bool asynchronous)
+{
 	/* Rolling identifier for script callback identification */
 	static CallbackParameter _last_cb_param = 0;
 	CallbackParameter cb_param = ++_last_cb_param;
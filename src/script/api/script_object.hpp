@@ -86,7 +86,7 @@ protected:
 		ScriptInstance *last_active;    ///< The active instance before we go instantiated.
 		ScriptAllocatorScope alc_scope; ///< Keep the correct allocator for the script instance activated
 
-		static ScriptInstance *active;  ///< The global current active instance.
+		static thread_local ScriptInstance *active; ///< The current active instance of this thread.
 	};
 
 	class DisableDoCommandScope : public AutoRestoreBackup<bool> {
@@ -153,6 +153,7 @@ public:
 
 private:
 	static bool DoCommandImplementation(Commands cmd, TileIndex tile, CommandPayloadBase &&payload, Script_SuspendCallbackProc *callback, DoCommandIntlFlag intl_flags);
+	static bool DoCommandExecute(Commands cmd, TileIndex tile, const CommandPayloadBase &payload, Script_SuspendCallbackProc *callback, DoCommandIntlFlag intl_flags, bool estimate_only, bool asynchronous);
 
 protected:
 	template <Commands cmd>
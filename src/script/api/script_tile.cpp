@@ -345,3 +345,40 @@
 		default: return -1;
 	}
 }
+
+/* static */ bool ScriptTile::ValuateList(ScriptList *list, TileProperty property)
+{
+	EnforcePrecondition(false, list != nullptr);
+
+	auto valuate = [&](auto get_value) {
+		list->SetAllValues([&](SQInteger item) -> SQInteger {
+			return get_value(::TileIndex((uint32_t)(int32_t)item));
+		});
+	};
+
+	switch (property) {
+		case TP_MIN_HEIGHT:     valuate([](TileIndex tile) -> SQInteger { return GetMinHeight(tile); }); break;
+		case TP_MAX_HEIGHT:     valuate([](TileIndex tile) -> SQInteger { return GetMaxHeight(tile); }); break;
+		case TP_SLOPE:          valuate([](TileIndex tile) -> SQInteger { return GetSlope(tile); }); break;
+		case TP_BUILDABLE:      valuate([](TileIndex tile) -> SQInteger { return IsBuildable(tile) ? 1 : 0; }); break;
+		case TP_WATER:          valuate([](TileIndex tile) -> SQInteger { return IsWaterTile(tile) ? 1 : 0; }); break;
+		case TP_COAST:          valuate([](TileIndex tile) -> SQInteger { return IsCoastTile(tile) ? 1 : 0; }); break;
+		case TP_OWNER:          valuate([](TileIndex tile) -> SQInteger { return GetOwner(tile); }); break;
+		case TP_TERRAIN_TYPE:   valuate([](TileIndex tile) -> SQInteger { return GetTerrainType(tile); }); break;
+		case TP_TOWN_AUTHORITY: valuate([](TileIndex tile) -> SQInteger { return GetTownAuthority(tile).base(); }); break;
+		case TP_CLOSEST_TOWN:   valuate([](TileIndex tile) -> SQInteger { return GetClosestTown(tile).base(); }); break;
+		default:
+			ScriptObject::SetLastError(ScriptError::ERR_PRECONDITION_FAILED);
+			return false;
+	}
+	return true;
+}
+
+/* static */ void ScriptTile::ValuateListCargoAcceptance(ScriptList *list, CargoType cargo_type, SQInteger width, SQInteger height, SQInteger radius)
+{
+	if (list == nullptr) return;
+
+	list->SetAllValues([&](SQInteger item) -> SQInteger {
+		return GetCargoAcceptance(::TileIndex((uint32_t)(int32_t)item), cargo_type, width, height, radius);
+	});
+}
@@ -12,6 +12,7 @@
 
 #include "script_error.hpp"
 #include "script_company.hpp"
+#include "script_list.hpp"
 #include "../../cargo_type.h"
 #include "../../slope_type.h"
 #include "../../town_type.h"
@@ -139,6 +140,22 @@ public:
 		TERRAIN_SNOW        ///< A tile on or above the snowline level.
 	};
 
+	/**
+	 * Properties of tiles which can be valuated in bulk, see #ValuateList.
+	 */
+	enum TileProperty {
+		TP_MIN_HEIGHT,     ///< The value of #GetMinHeight.
+		TP_MAX_HEIGHT,     ///< The value of #GetMaxHeight.
+		TP_SLOPE,          ///< The value of #GetSlope.
+		TP_BUILDABLE,      ///< 1 if #IsBuildable, 0 otherwise.
+		TP_WATER,          ///< 1 if #IsWaterTile, 0 otherwise.
+		TP_COAST,          ///< 1 if #IsCoastTile, 0 otherwise.
+		TP_OWNER,          ///< The value of #GetOwner.
+		TP_TERRAIN_TYPE,   ///< The value of #GetTerrainType.
+		TP_TOWN_AUTHORITY, ///< The value of #GetTownAuthority.
+		TP_CLOSEST_TOWN,   ///< The value of #GetClosestTown.
+	};
+
 	/**
 	 * Check if this tile is buildable, i.e. no things on it that needs
 	 *  demolishing.
@@ -532,6 +549,36 @@ public:
 	 */
 	static TownID GetClosestTown(TileIndex tile);
 
+	/**
+	 * Set the value of all tiles in a list to one of their properties.
+	 * This gives the same result as valuating the list with the function of the
+	 *  property, but is a lot faster and costs fewer operations.
+	 * @param list The list of tiles to valuate.
+	 * @param property The property to use as value.
+	 * @pre list != null
+	 * @pre property is a valid TileProperty.
+	 * @return True if the list has been valuated, false if a precondition failed.
+	 * @note Example:
+	 * @code
+	 *  ScriptTile.ValuateList(tile_list, ScriptTile.TP_MIN_HEIGHT);
+	 *  // equivalent to: tile_list.Valuate(ScriptTile.GetMinHeight);
+	 * @endcode
+	 */
+	static bool ValuateList(ScriptList *list, TileProperty property);
+
+	/**
+	 * Set the value of all tiles in a list to their cargo acceptance, see #GetCargoAcceptance.
+	 * This gives the same result as valuating the list with #GetCargoAcceptance,
+	 *  but is a lot faster and costs fewer operations.
+	 * @param list The list of tiles to valuate.
+	 * @param cargo_type Which cargo to check the acceptance of.
+	 * @param width The width of the station.
+	 * @param height The height of the station.
+	 * @param radius The radius of the station.
+	 * @pre list != null
+	 */
+	static void ValuateListCargoAcceptance(ScriptList *list, CargoType cargo_type, SQInteger width, SQInteger height, SQInteger radius);
+
 	/**
 	 * Get the baseprice of building/clearing various tile-related things.
 	 * @param build_type the type to build
@@ -437,6 +437,45 @@
 	return amount;
 }
 
+/* static */ bool ScriptVehicle::ValuateList(ScriptList *list, VehicleProperty property)
+{
+	EnforcePrecondition(false, list != nullptr);
+
+	auto valuate = [&](auto get_value) {
+		list->SetAllValues([&](SQInteger item) -> SQInteger {
+			return get_value(VehicleID{static_cast<VehicleID::BaseType>(item)});
+		});
+	};
+
+	switch (property) {
+		case VP_LOCATION:         valuate([](VehicleID v) -> SQInteger { return (int32_t)GetLocation(v).base(); }); break;
+		case VP_STATE:            valuate([](VehicleID v) -> SQInteger { return GetState(v); }); break;
+		case VP_AGE:              valuate([](VehicleID v) -> SQInteger { return GetAge(v); }); break;
+		case VP_AGE_LEFT:         valuate([](VehicleID v) -> SQInteger { return GetAgeLeft(v); }); break;
+		case VP_RELIABILITY:      valuate([](VehicleID v) -> SQInteger { return GetReliability(v); }); break;
+		case VP_CURRENT_SPEED:    valuate([](VehicleID v) -> SQInteger { return GetCurrentSpeed(v); }); break;
+		case VP_PROFIT_THIS_YEAR: valuate([](VehicleID v) -> SQInteger { return GetProfitThisYear(v); }); break;
+		case VP_PROFIT_LAST_YEAR: valuate([](VehicleID v) -> SQInteger { return GetProfitLastYear(v); }); break;
+		case VP_CURRENT_VALUE:    valuate([](VehicleID v) -> SQInteger { return GetCurrentValue(v); }); break;
+		case VP_ENGINE_TYPE:      valuate([](VehicleID v) -> SQInteger { return GetEngineType(v).base(); }); break;
+		case VP_GROUP_ID:         valuate([](VehicleID v) -> SQInteger { return GetGroupID(v).base(); }); break;
+		case VP_IN_DEPOT:         valuate([](VehicleID v) -> SQInteger { return IsInDepot(v) ? 1 : 0; }); break;
+		default:
+			ScriptObject::SetLastError(ScriptError::ERR_PRECONDITION_FAILED);
+			return false;
+	}
+	return true;
+}
+
+/* static */ void ScriptVehicle::ValuateListCargoLoad(ScriptList *list, CargoType cargo)
+{
+	if (list == nullptr) return;
+
+	list->SetAllValues([&](SQInteger item) -> SQInteger {
+		return GetCargoLoad(VehicleID{static_cast<VehicleID::BaseType>(item)}, cargo);
+	});
+}
+
 /* static */ GroupID ScriptVehicle::GetGroupID(VehicleID vehicle_id)
 {
 	if (!IsPrimaryVehicle(vehicle_id)) return ScriptGroup::GROUP_INVALID;
@@ -11,6 +11,7 @@
 #define SCRIPT_VEHICLE_HPP
 
 #include "script_road.hpp"
+#include "script_list.hpp"
 #include "../../engine_type.h"
 #include "../../group_type.h"
 #include <optional>
@@ -96,6 +97,24 @@ public:
 		VS_INVALID = 0xFF, ///< An invalid vehicle state.
 	};
 
+	/**
+	 * Properties of vehicles which can be valuated in bulk, see #ValuateList.
+	 */
+	enum VehicleProperty {
+		VP_LOCATION,          ///< The value of #GetLocation.
+		VP_STATE,             ///< The value of #GetState.
+		VP_AGE,               ///< The value of #GetAge.
+		VP_AGE_LEFT,          ///< The value of #GetAgeLeft.
+		VP_RELIABILITY,       ///< The value of #GetReliability.
+		VP_CURRENT_SPEED,     ///< The value of #GetCurrentSpeed.
+		VP_PROFIT_THIS_YEAR,  ///< The value of #GetProfitThisYear.
+		VP_PROFIT_LAST_YEAR,  ///< The value of #GetProfitLastYear.
+		VP_CURRENT_VALUE,     ///< The value of #GetCurrentValue.
+		VP_ENGINE_TYPE,       ///< The value of #GetEngineType.
+		VP_GROUP_ID,          ///< The value of #GetGroupID.
+		VP_IN_DEPOT,          ///< 1 if #IsInDepot, 0 otherwise.
+	};
+
 	static constexpr VehicleID VEHICLE_INVALID = ::VehicleID::Invalid(); ///< Invalid VehicleID.
 
 	/**
@@ -570,6 +589,33 @@ public:
 	 */
 	static SQInteger GetCargoLoad(VehicleID vehicle_id, CargoType cargo);
 
+	/**
+	 * Set the value of all vehicles in a list to one of their properties.
+	 * This gives the same result as valuating the list with the function of the
+	 *  property, but is a lot faster and costs fewer operations.
+	 * @param list The list of vehicles to valuate.
+	 * @param property The property to use as value.
+	 * @pre list != null
+	 * @pre property is a valid VehicleProperty.
+	 * @return True if the list has been valuated, false if a precondition failed.
+	 * @note Example:
+	 * @code
+	 *  ScriptVehicle.ValuateList(vehicle_list, ScriptVehicle.VP_PROFIT_LAST_YEAR);
+	 *  // equivalent to: vehicle_list.Valuate(ScriptVehicle.GetProfitLastYear);
+	 * @endcode
+	 */
+	static bool ValuateList(ScriptList *list, VehicleProperty property);
+
+	/**
+	 * Set the value of all vehicles in a list to the amount of a cargo they are carrying, see #GetCargoLoad.
+	 * This gives the same result as valuating the list with #GetCargoLoad,
+	 *  but is a lot faster and costs fewer operations.
+	 * @param list The list of vehicles to valuate.
+	 * @param cargo The cargo to check.
+	 * @pre list != null
+	 */
+	static void ValuateListCargoLoad(ScriptList *list, CargoType cargo);
+
 	/**
 	 * Get the group of a given vehicle.
 	 * @param vehicle_id The vehicle to get the group from.
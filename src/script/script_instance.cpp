@@ -26,6 +26,7 @@
 
 #include "../company_base.h"
 #include "../company_func.h"
+#include "../core/backup_type.hpp"
 #include "../fileio_func.h"
 #include "../league_type.h"
 #include "../goal_type.h"
@@ -286,6 +287,31 @@ void ScriptInstance::GameLoop() noexcept
 	}
 }
 
+void ScriptInstance::ExecuteDeferredCommand() noexcept
+{
+	if (!this->deferred_command.has_value()) return;
+
+	DeferredCommand deferred = std::move(*this->deferred_command);
+	this->deferred_command.reset();
+	if (this->IsDead()) return;
+
+	ScriptObject::ActiveInstance active(*this);
+	AutoRestoreBackup cur_company(_current_company, ScriptObject::GetCompany());
+
+	try {
+		if (!ScriptObject::DoCommandExecute(deferred.cmd, deferred.tile, *deferred.payload, deferred.callback, deferred.intl_flags, false, false)) {
+			/* The script has already been suspended, report the failure like a command failing in multiplayer. */
+			ScriptObject::SetLastCommandRes(false);
+			ScriptObject::ClearLastCommandResultData();
+			this->suspend  = ScriptObject::GetDoCommandDelay();
+			this->callback = deferred.callback;
+		}
+	} catch (Script_Suspend &e) {
+		this->suspend  = e.GetSuspendTime();
+		this->callback = e.GetSuspendCallback();
+	}
+}
+
 void ScriptInstance::CollectGarbage() noexcept
 {
 	if (this->is_started && !this->IsDead()) {
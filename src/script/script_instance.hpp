@@ -12,6 +12,7 @@
 
 #include <variant>
 #include <list>
+#include <optional>
 #include <squirrel.h>
 #include "squirrel.hpp"
 #include "script_suspend.hpp"
@@ -86,6 +87,12 @@ public:
 	 */
 	void GameLoop() noexcept;
 
+	/**
+	 * Execute the command deferred during a parallel run of the GameLoop, if any.
+	 * @see RunScriptsParallel
+	 */
+	void ExecuteDeferredCommand() noexcept;
+
 	/**
 	 * Let the VM collect any garbage.
 	 */
@@ -314,6 +321,15 @@ protected:
 	virtual void LoadDummyScript() = 0;
 
 private:
+	/** A command tested while scripts were running in parallel, to be executed afterwards. */
+	struct DeferredCommand {
+		Commands cmd;                          ///< The command.
+		TileIndex tile;                        ///< The tile to execute the command on.
+		CommandPayloadBaseUniquePtr payload;   ///< The command payload.
+		Script_SuspendCallbackProc *callback;  ///< Callback to call once the command has been executed.
+		DoCommandIntlFlag intl_flags;          ///< Internal command flags.
+	};
+
 	std::unique_ptr<class ScriptStorage> storage; ///< Some global information for each running script.
 	std::unique_ptr<class ScriptController> controller; ///< The script main class.
 	std::unique_ptr<SQObject> instance; ///< Squirrel-pointer to the script main class.
@@ -329,6 +345,20 @@ private:
 	std::string_view api_name{};                    ///< Name of the API used for this squirrel.
 	ScriptType script_type{};                       ///< Script type.
 	bool allow_text_param_mismatch = false;         ///< Whether ScriptText parameter mismatches are allowed
+	std::optional<DeferredCommand> deferred_command; ///< Command waiting to be executed after a parallel run.
+
+	/**
+	 * Store a command to execute once all scripts running in parallel have finished their tick.
+	 * @param cmd The command.
+	 * @param tile The tile to execute the command on.
+	 * @param payload The command payload.
+	 * @param callback Callback to call once the command has been executed.
+	 * @param intl_flags Internal command flags.
+	 */
+	void DeferCommand(Commands cmd, TileIndex tile, CommandPayloadBaseUniquePtr payload, Script_SuspendCallbackProc *callback, DoCommandIntlFlag intl_flags)
+	{
+		this->deferred_command.emplace(cmd, tile, std::move(payload), callback, intl_flags);
+	}
 
 	/**
 	 * Call the script Load function if it exists and data was loaded
@@ -19,6 +19,11 @@
 #include <../squirrel/sqvm.h>
 #include "../core/alloc_func.hpp"
 #include "../core/string_consumer.hpp"
+#include "../company_func.h"
+#include "../core/backup_type.hpp"
+#include "../thread.h"
+#include "../worker_thread.h"
+#include <mutex>
 
 /**
  * In the memory allocator for Squirrel we want to directly use malloc/realloc, so when the OS
@@ -165,7 +170,7 @@ static const size_t SAFE_LIMIT = 0x8000000; ///< 128 MiB, a safe choice for almo
  */
 #include "../safeguards.h"
 
-ScriptAllocator *_squirrel_allocator = nullptr;
+thread_local ScriptAllocator *_squirrel_allocator = nullptr; ///< Per thread, as script VMs may run in parallel, see #RunScriptsParallel.
 
 /* See 3rdparty/squirrel/squirrel/sqmem.cpp for the default allocator implementation, which this overrides */
 #ifndef SQUIRREL_DEFAULT_ALLOCATOR
@@ -185,8 +190,87 @@ void Squirrel::SetMemoryAllocationLimit(size_t limit) noexcept
 }
 
 
+/** State of a thread running scripts in parallel, see #RunScriptsParallel. */
+struct ScriptParallelThreadState {
+	std::unique_lock<std::mutex> lock; ///< Lock of #_script_native_mutex, held except while executing script code.
+	CompanyID current_company;         ///< Value of #_current_company for this thread while the lock is not held.
+};
+
+static std::mutex _script_native_mutex; ///< Serialises game code executed on behalf of scripts running in parallel.
+static thread_local ScriptParallelThreadState *_script_parallel_state = nullptr;
+
+ScriptNativeScope::ScriptNativeScope()
+{
+	ScriptParallelThreadState *state = _script_parallel_state;
+	this->locked = state != nullptr && !state->lock.owns_lock();
+	if (this->locked) {
+		state->lock.lock();
+		_current_company = state->current_company;
+	}
+}
+
+ScriptNativeScope::~ScriptNativeScope()
+{
+	if (this->locked) {
+		ScriptParallelThreadState *state = _script_parallel_state;
+		state->current_company = _current_company;
+		state->lock.unlock();
+	}
+}
+
+ScriptVMScope::ScriptVMScope()
+{
+	ScriptParallelThreadState *state = _script_parallel_state;
+	this->unlocked = state != nullptr && state->lock.owns_lock();
+	if (this->unlocked) {
+		state->current_company = _current_company;
+		state->lock.unlock();
+	}
+}
+
+ScriptVMScope::~ScriptVMScope()
+{
+	if (this->unlocked) {
+		ScriptParallelThreadState *state = _script_parallel_state;
+		state->lock.lock();
+		_current_company = state->current_company;
+	}
+}
+
+/**
+ * Check whether the calling thread is running a script in parallel with others, see #RunScriptsParallel.
+ * @return True iff running scripts in parallel.
+ */
+bool IsRunningScriptsParallel()
+{
+	return _script_parallel_state != nullptr;
+}
+
+/**
+ * Run scripts in parallel on the general worker pool.
+ * Only the code of the script VMs runs concurrently. All game code executed on behalf of the scripts, i.e. everything
+ * outside of a #ScriptVMScope, is serialised by a single lock. The caller must ensure that the scripts do not change the
+ * game state while running in parallel, such that the results do not depend on the order in which the threads take the lock.
+ * @param count Number of scripts.
+ * @param func Function running the script with the given index.
+ */
+void RunScriptsParallel(uint count, std::function<void(uint)> func)
+{
+	assert(IsMainThread() && _script_parallel_state == nullptr);
+
+	Backup<CompanyID> cur_company(_current_company, FILE_LINE);
+	_general_worker_pool.ParallelFor(count, [&](uint i) {
+		ScriptParallelThreadState state{ std::unique_lock<std::mutex>(_script_native_mutex), _current_company };
+		_script_parallel_state = &state;
+		func(i);
+		_script_parallel_state = nullptr;
+	});
+	cur_company.Restore();
+}
+
 void Squirrel::CompileError(HSQUIRRELVM vm, std::string_view desc, std::string_view source, SQInteger line, SQInteger column)
 {
+	ScriptNativeScope native_scope;
 	std::string msg = fmt::format("Error {}:{}/{}: {}", source, line, column, desc);
 
 	/* Check if we have a custom print function */
@@ -202,6 +286,7 @@ void Squirrel::CompileError(HSQUIRRELVM vm, std::string_view desc, std::string_v
 
 void Squirrel::ErrorPrintFunc(HSQUIRRELVM vm, std::string_view s)
 {
+	ScriptNativeScope native_scope;
 	/* Check if we have a custom print function */
 	SQPrintFunc *func = ((Squirrel *)sq_getforeignptr(vm))->print_func;
 	if (func == nullptr) {
@@ -213,6 +298,7 @@ void Squirrel::ErrorPrintFunc(HSQUIRRELVM vm, std::string_view s)
 
 void Squirrel::RunError(HSQUIRRELVM vm, std::string_view error)
 {
+	ScriptNativeScope native_scope;
 	/* Set the print function to something that prints to stderr */
 	SQPRINTFUNCTION pf = sq_getprintfunc(vm);
 	sq_setprintfunc(vm, &Squirrel::ErrorPrintFunc);
@@ -250,6 +336,7 @@ SQInteger Squirrel::_RunError(HSQUIRRELVM vm)
 
 void Squirrel::PrintFunc(HSQUIRRELVM vm, std::string_view s)
 {
+	ScriptNativeScope native_scope;
 	/* Check if we have a custom print function */
 	SQPrintFunc *func = ((Squirrel *)sq_getforeignptr(vm))->print_func;
 	if (func == nullptr) {
@@ -399,7 +486,10 @@ bool Squirrel::Resume(int suspend)
 		suspend = -this->overdrawn_ops;
 	}
 
-	this->crashed = !sq_resumecatch(this->vm, suspend);
+	{
+		ScriptVMScope vm_scope;
+		this->crashed = !sq_resumecatch(this->vm, suspend);
+	}
 	this->overdrawn_ops = -this->vm->_ops_till_suspend;
 	this->allocator.CheckLimit();
 	return this->vm->_suspended != 0;
@@ -441,7 +531,10 @@ bool Squirrel::CallMethod(HSQOBJECT instance, std::string_view method_name, HSQO
 	}
 	/* Call the method */
 	sq_pushobject(this->vm, instance);
-	if (SQ_FAILED(sq_call(this->vm, 1, ret == nullptr ? SQFalse : SQTrue, SQTrue, suspend))) return false;
+	{
+		ScriptVMScope vm_scope;
+		if (SQ_FAILED(sq_call(this->vm, 1, ret == nullptr ? SQFalse : SQTrue, SQTrue, suspend))) return false;
+	}
 	if (ret != nullptr) sq_getstackobj(vm, -1, ret);
 	/* Reset the top, but don't do so for the script main function, as we need
 	 *  a correct stack when resuming. */
@@ -17,6 +17,7 @@
  */
 
 #include <squirrel.h>
+#include <functional>
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 #	include <map>
 #endif
@@ -475,7 +476,7 @@ public:
 };
 
 
-extern ScriptAllocator *_squirrel_allocator;
+extern thread_local ScriptAllocator *_squirrel_allocator;
 
 class ScriptAllocatorScope {
 	ScriptAllocator *old_allocator;
@@ -494,6 +495,35 @@ public:
 	}
 };
 
+/**
+ * Scope in which the calling thread executes game code on behalf of a script, such as an API function.
+ * When scripts are run in parallel by #RunScriptsParallel, only one thread at a time can be in such a scope.
+ * Otherwise this does nothing.
+ */
+class ScriptNativeScope {
+	bool locked; ///< Whether this scope acquired the lock.
+
+public:
+	ScriptNativeScope();
+	~ScriptNativeScope();
+};
+
+/**
+ * Scope in which the calling thread only executes the code of its own script VM.
+ * When scripts are run in parallel by #RunScriptsParallel, this lets other threads enter a #ScriptNativeScope meanwhile.
+ * Otherwise this does nothing.
+ */
+class ScriptVMScope {
+	bool unlocked; ///< Whether this scope released the lock.
+
+public:
+	ScriptVMScope();
+	~ScriptVMScope();
+};
+
+bool IsRunningScriptsParallel();
+void RunScriptsParallel(uint count, std::function<void(uint)> func);
+
 void Squirrel::IncreaseAllocatedSize(size_t bytes)
 {
 	_squirrel_allocator->allocated_size += bytes;
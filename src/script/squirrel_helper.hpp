@@ -253,6 +253,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod, ScriptType Ttype>
 	inline SQInteger DefSQNonStaticCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -299,6 +301,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod, ScriptType Ttype>
 	inline SQInteger DefSQAdvancedNonStaticCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -345,6 +349,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod>
 	inline SQInteger DefSQStaticCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -373,6 +379,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod>
 	inline SQInteger DefSQAdvancedStaticCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		/* Find the amount of params we got */
 		int nparam = sq_gettop(vm);
 		SQUserPointer ptr = nullptr;
@@ -400,6 +408,8 @@ namespace SQConvert {
 	template <typename Tcls>
 	static SQInteger DefSQDestructorCallback(SQUserPointer p, SQInteger)
 	{
+		ScriptNativeScope native_scope;
+
 		/* Remove the real instance too */
 		if (p != nullptr) ((Tcls *)p)->Release();
 		return 0;
@@ -415,6 +425,8 @@ namespace SQConvert {
 	template <typename Tcls, typename Tmethod>
 	inline SQInteger DefSQConstructorCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		try {
 			/* Find the amount of params we got */
 			int nparam = sq_gettop(vm);
@@ -439,6 +451,8 @@ namespace SQConvert {
 	template <typename Tcls>
 	inline SQInteger DefSQAdvancedConstructorCallback(HSQUIRRELVM vm)
 	{
+		ScriptNativeScope native_scope;
+
 		try {
 			/* Find the amount of params we got */
 			int nparam = sq_gettop(vm);
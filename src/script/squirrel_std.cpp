@@ -41,6 +41,8 @@ SQInteger SquirrelStd::max(HSQUIRRELVM vm)
 
 SQInteger SquirrelStd::require(HSQUIRRELVM vm)
 {
+	ScriptNativeScope native_scope;
+
 	SQInteger top = sq_gettop(vm);
 	std::string_view filename;
 
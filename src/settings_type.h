@@ -340,6 +340,7 @@ struct GUISettings : public TimeSettings {
 	uint8_t     date_format_in_default_names;                    ///< should the default savegame/screenshot name use long dates (31th Dec 2008), short dates (31-12-2008) or ISO dates (2008-12-31)
 	uint8_t     max_num_autosaves;                               ///< controls how many autosavegames are made before the game starts to overwrite (names them 0 to max_num_autosaves - 1)
 	uint8_t     max_num_lt_autosaves;                            ///< controls how many long-term autosavegames are made before the game starts to overwrite (names them 0 to max_num_lt_autosaves - 1)
+	uint8_t     differential_autosaves;                          ///< number of differential autosaves between two full autosaves (0 = off)
 	uint8_t     savegame_overwrite_confirm;                      ///< Mode for when to warn about overwriting an existing savegame
 	bool        population_in_label;                             ///< show the population of a town in its label?
 	bool        city_in_label;                                   ///< show cities in label?
@@ -552,6 +553,7 @@ struct NewsSettings {
 /** All settings related to the network. */
 struct NetworkSettings {
 	uint16_t      sync_freq;                              ///< how often do we check whether we are still in-sync
+	uint8_t       sync_world_hash_shards;                 ///< number of world state shard hashes the server sends with each sync, to localise desyncs
 	uint8_t       frame_freq;                             ///< how often do we send commands to the clients
 	uint16_t      commands_per_frame;                     ///< how many commands may be sent each frame_freq frames?
 	uint16_t      commands_per_frame_server;              ///< how many commands may be sent each frame_freq frames? (server-originating commands)
@@ -19,6 +19,7 @@
 
 #include "saveload.h"
 #include "saveload_buffer.h"
+#include "map_sl_transpose.h"
 
 #include "../safeguards.h"
 
@@ -55,15 +56,96 @@ static void Check_MAPS()
 	_load_check_data.map_size_y = _map_dim_y;
 }
 
-static void Load_MAPT()
+/**
+ * Description of the map field stored in one of the classic per-field map chunks.
+ * @tparam TField Type of the field.
+ * @tparam TTile Tile struct containing the field.
+ * @tparam TOffset Offset of the field in the tile struct.
+ */
+template <typename TField, typename TTile, size_t TOffset>
+struct MapChunkField {
+	using Transposer = MapFieldTransposer<TField, sizeof(TTile), TOffset>;
+	static constexpr size_t FIELD_SIZE = sizeof(TField);
+};
+
+struct MAPT : MapChunkField<uint8_t, Tile, offsetof(Tile, type)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAPH : MapChunkField<uint8_t, Tile, offsetof(Tile, height)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP1 : MapChunkField<uint8_t, Tile, offsetof(Tile, m1)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP2 : MapChunkField<uint16_t, Tile, offsetof(Tile, m2)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP3 : MapChunkField<uint8_t, Tile, offsetof(Tile, m3)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP4 : MapChunkField<uint8_t, Tile, offsetof(Tile, m4)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP5 : MapChunkField<uint8_t, Tile, offsetof(Tile, m5)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_m.tile_data); }
+};
+
+struct MAP6 : MapChunkField<uint8_t, TileExtended, offsetof(TileExtended, m6)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_me.tile_data); }
+};
+
+struct MAP7 : MapChunkField<uint8_t, TileExtended, offsetof(TileExtended, m7)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_me.tile_data); }
+};
+
+struct MAP8 : MapChunkField<uint16_t, TileExtended, offsetof(TileExtended, m8)> {
+	static uint8_t *GetTiles() { return reinterpret_cast<uint8_t *>(_me.tile_data); }
+};
+
+/**
+ * Load a classic per-field map chunk into the map arrays.
+ * @tparam T Description of the field.
+ */
+template <typename T>
+static void LoadMapField()
 {
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->type = val;
-		m++;
+	uint8_t *tiles = T::GetTiles();
+	ReadBuffer::GetCurrent()->ReadItemsToSpanHandler(Map::Size(), T::FIELD_SIZE, [&](const uint8_t *src, size_t count) {
+		T::Transposer::Scatter(tiles, src, count);
+		tiles += count * T::Transposer::STRIDE;
+	});
+}
+
+/**
+ * Save a classic per-field map chunk from the map arrays.
+ * @tparam T Description of the field.
+ */
+template <typename T>
+static void Save_MAP()
+{
+	assert(_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 0);
+
+	const uint32_t size = Map::Size();
+	SlSetLength(size * T::FIELD_SIZE);
+
+	const uint8_t *tiles = T::GetTiles();
+	MemoryDumper::GetCurrent()->WriteItemsFromSpanHandler(size, T::FIELD_SIZE, [&](uint8_t *dst, size_t count) {
+		T::Transposer::Gather(dst, tiles, count);
+		tiles += count * T::Transposer::STRIDE;
 	});
 }
 
+static void Load_MAPT()
+{
+	LoadMapField<MAPT>();
+}
+
 static void Check_MAPH_common()
 {
 	if (_sl_maybe_chillpp && (SlGetFieldLength() == 0 || SlGetFieldLength() == (size_t)_map_dim_x * (size_t)_map_dim_y * 2)) {
@@ -95,20 +177,12 @@ static void Load_MAPH()
 		return;
 	}
 
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->height = val;
-		m++;
-	});
+	LoadMapField<MAPH>();
 }
 
 static void Load_MAP1()
 {
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->m1 = val;
-		m++;
-	});
+	LoadMapField<MAP1>();
 }
 
 static void Load_MAP2()
@@ -121,38 +195,23 @@ static void Load_MAP2()
 			m++;
 		});
 	} else {
-		ReadBuffer::GetCurrent()->ReadUint16sToHandler(Map::Size(), [&](uint16_t val) {
-			m->m2 = val;
-			m++;
-		});
+		LoadMapField<MAP2>();
 	}
 }
 
 static void Load_MAP3()
 {
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->m3 = val;
-		m++;
-	});
+	LoadMapField<MAP3>();
 }
 
 static void Load_MAP4()
 {
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->m4 = val;
-		m++;
-	});
+	LoadMapField<MAP4>();
 }
 
 static void Load_MAP5()
 {
-	Tile *m = _m.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		m->m5 = val;
-		m++;
-	});
+	LoadMapField<MAP5>();
 }
 
 static void Load_MAP6()
@@ -169,29 +228,18 @@ static void Load_MAP6()
 			me += 4;
 		});
 	} else {
-		ReadBuffer::GetCurrent()->ReadBytesToHandler(size, [&](uint8_t val) {
-			me->m6 = val;
-			me++;
-		});
+		LoadMapField<MAP6>();
 	}
 }
 
 static void Load_MAP7()
 {
-	TileExtended *me = _me.tile_data;
-	ReadBuffer::GetCurrent()->ReadBytesToHandler(Map::Size(), [&](uint8_t val) {
-		me->m7 = val;
-		me++;
-	});
+	LoadMapField<MAP7>();
 }
 
 static void Load_MAP8()
 {
-	TileExtended *me = _me.tile_data;
-	ReadBuffer::GetCurrent()->ReadUint16sToHandler(Map::Size(), [&](uint16_t val) {
-		me->m8 = val;
-		me++;
-	});
+	LoadMapField<MAP8>();
 }
 
 static void Load_WMAP()
@@ -287,92 +335,6 @@ static void Save_WMAP()
 	}
 }
 
-struct MapTileReader {
-	Tile *m;
-
-	MapTileReader() { this->m = _m.tile_data; }
-	Tile *Next() { return this->m++; }
-};
-
-struct MapTileExtendedReader {
-	TileExtended *me;
-
-	MapTileExtendedReader() { this->me = _me.tile_data; }
-	TileExtended *Next() { return this->me++; }
-};
-
-struct MAPT : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->type; }
-};
-
-struct MAPH : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->height; }
-};
-
-struct MAP1 : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m1; }
-};
-
-struct MAP2 : MapTileReader {
-	typedef uint16_t FieldT;
-	FieldT GetNextField() { return this->Next()->m2; }
-};
-
-struct MAP3 : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m3; }
-};
-
-struct MAP4 : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m4; }
-};
-
-struct MAP5 : MapTileReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m5; }
-};
-
-struct MAP6 : MapTileExtendedReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m6; }
-};
-
-struct MAP7 : MapTileExtendedReader {
-	typedef uint8_t FieldT;
-	FieldT GetNextField() { return this->Next()->m7; }
-};
-
-struct MAP8 : MapTileExtendedReader {
-	typedef uint16_t FieldT;
-	FieldT GetNextField() { return this->Next()->m8; }
-};
-
-template <typename T>
-static void Save_MAP()
-{
-	assert(_sl_xv_feature_versions[XSLFI_WHOLE_MAP_CHUNK] == 0);
-
-	static_assert(std::is_same_v<typename T::FieldT, uint8_t> || std::is_same_v<typename T::FieldT, uint16_t>);
-
-	const uint32_t size = Map::Size();
-	SlSetLength(size * sizeof(typename T::FieldT));
-
-	T map_reader{};
-	if constexpr (std::is_same_v<typename T::FieldT, uint8_t>) {
-		MemoryDumper::GetCurrent()->WriteBytesFromHandler(size, [&]() -> uint8_t {
-			return map_reader.GetNextField();
-		});
-	} else {
-		MemoryDumper::GetCurrent()->WriteUint16sFromHandler(size, [&]() -> uint16_t {
-			return map_reader.GetNextField();
-		});
-	}
-}
-
 static ChunkSaveLoadSpecialOpResult Special_WMAP(uint32_t chunk_id, ChunkSaveLoadSpecialOp op)
 {
 	switch (op) {
@@ -0,0 +1,182 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file map_sl_transpose.h Conversion between the map tile arrays and the per-field streams of the map chunks. */
+
+#ifndef SL_MAP_SL_TRANSPOSE_H
+#define SL_MAP_SL_TRANSPOSE_H
+
+#include "../core/bitmath_func.hpp"
+
+#include <cstring>
+#include <type_traits>
+
+#if defined(WITH_SSE) && defined(POINTER_IS_64BIT)
+/* SSE2 is always available on x86-64 */
+#	define MAP_SL_TRANSPOSE_SSE2
+#	include <emmintrin.h>
+#endif
+
+/**
+ * Scatter/gather one field of an array of tile structs from/to the stream of that field in a map chunk.
+ * Streams of uint16_t fields are in savegame (big endian) byte order.
+ * @tparam TField Type of the field, uint8_t or uint16_t.
+ * @tparam TStride Size of the tile struct.
+ * @tparam TOffset Offset of the field in the tile struct.
+ */
+template <typename TField, size_t TStride, size_t TOffset>
+struct MapFieldTransposer {
+	static_assert(std::is_same_v<TField, uint8_t> || std::is_same_v<TField, uint16_t>);
+	static_assert(TStride == 4 || TStride == 8);
+	static_assert(TOffset % sizeof(TField) == 0 && TOffset + sizeof(TField) <= TStride);
+
+	static constexpr size_t FIELD_SIZE = sizeof(TField);
+	static constexpr size_t STRIDE = TStride;
+
+	/**
+	 * Copy a stream of field values into consecutive tile structs, leaving the other fields unchanged.
+	 * @param tiles Start of the tile structs.
+	 * @param src Stream of field values.
+	 * @param count Number of values.
+	 */
+	static void Scatter(uint8_t *tiles, const uint8_t *src, size_t count)
+	{
+		size_t i = 0;
+#ifdef MAP_SL_TRANSPOSE_SSE2
+		constexpr size_t VALUES_PER_LOAD = 16 / FIELD_SIZE;
+		for (; i + VALUES_PER_LOAD <= count; i += VALUES_PER_LOAD) {
+			__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + (i * FIELD_SIZE)));
+			if constexpr (FIELD_SIZE == 2) values = ByteSwap16(values);
+			ScatterExpanded<FIELD_SIZE>(tiles + (i * TStride), values);
+		}
+#endif
+		for (; i < count; i++) {
+			if constexpr (FIELD_SIZE == 1) {
+				tiles[(i * TStride) + TOffset] = src[i];
+			} else {
+				const uint16_t value = (src[i * 2] << 8) | src[(i * 2) + 1];
+				std::memcpy(tiles + (i * TStride) + TOffset, &value, sizeof(value));
+			}
+		}
+	}
+
+	/**
+	 * Copy one field of consecutive tile structs into a stream of field values.
+	 * @param dst Stream of field values.
+	 * @param tiles Start of the tile structs.
+	 * @param count Number of values.
+	 */
+	static void Gather(uint8_t *dst, const uint8_t *tiles, size_t count)
+	{
+		size_t i = 0;
+#ifdef MAP_SL_TRANSPOSE_SSE2
+		constexpr size_t VALUES_PER_STORE = 16 / FIELD_SIZE;
+		for (; i + VALUES_PER_STORE <= count; i += VALUES_PER_STORE) {
+			__m128i values = GatherPacked<FIELD_SIZE>(tiles + (i * TStride));
+			if constexpr (FIELD_SIZE == 2) values = ByteSwap16(values);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + (i * FIELD_SIZE)), values);
+		}
+#endif
+		for (; i < count; i++) {
+			if constexpr (FIELD_SIZE == 1) {
+				dst[i] = tiles[(i * TStride) + TOffset];
+			} else {
+				uint16_t value;
+				std::memcpy(&value, tiles + (i * TStride) + TOffset, sizeof(value));
+				dst[i * 2] = GB(value, 8, 8);
+				dst[(i * 2) + 1] = GB(value, 0, 8);
+			}
+		}
+	}
+
+#ifdef MAP_SL_TRANSPOSE_SSE2
+private:
+	static __m128i ByteSwap16(__m128i values)
+	{
+		return _mm_or_si128(_mm_slli_epi16(values, 8), _mm_srli_epi16(values, 8));
+	}
+
+	/**
+	 * Widen the low or high half of the elements of a vector to twice their size, zero extending them.
+	 * @tparam TWidth Width of the elements of \a values in bytes.
+	 * @tparam THigh Whether to widen the high half of the elements.
+	 */
+	template <size_t TWidth, bool THigh>
+	static __m128i Widen(__m128i values)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		if constexpr (TWidth == 1) return THigh ? _mm_unpackhi_epi8(values, zero) : _mm_unpacklo_epi8(values, zero);
+		if constexpr (TWidth == 2) return THigh ? _mm_unpackhi_epi16(values, zero) : _mm_unpacklo_epi16(values, zero);
+		if constexpr (TWidth == 4) return THigh ? _mm_unpackhi_epi32(values, zero) : _mm_unpacklo_epi32(values, zero);
+	}
+
+	/**
+	 * Narrow the elements of two vectors to half their size, the values must fit in the narrower elements.
+	 * @tparam TWidth Width of the elements of \a lo and \a hi in bytes.
+	 */
+	template <size_t TWidth>
+	static __m128i Narrow(__m128i lo, __m128i hi)
+	{
+		if constexpr (TWidth == 2) return _mm_packus_epi16(lo, hi);
+		if constexpr (TWidth == 4) {
+			/* There is no unsigned saturating 32 to 16 bit pack in SSE2, sign extend the low halves so that the signed pack is exact */
+			return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(lo, 16), 16), _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16));
+		}
+		if constexpr (TWidth == 8) {
+			lo = _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 1, 2, 0));
+			hi = _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 1, 2, 0));
+			return _mm_unpacklo_epi64(lo, hi);
+		}
+	}
+
+	/** Mask of the field within each tile sized element. */
+	static __m128i FieldMask()
+	{
+		constexpr uint64_t field_mask = ((1ULL << (FIELD_SIZE * 8)) - 1) << (TOffset * 8);
+		if constexpr (TStride == 8) return _mm_set1_epi64x(field_mask);
+		if constexpr (TStride == 4) return _mm_set1_epi32(static_cast<int>(field_mask));
+	}
+
+	/**
+	 * Widen values from \a TWidth byte elements until they are tile sized, and merge them into the tiles.
+	 * @tparam TWidth Current width of the elements of \a values in bytes.
+	 */
+	template <size_t TWidth>
+	static void ScatterExpanded(uint8_t *tiles, __m128i values)
+	{
+		if constexpr (TWidth == TStride) {
+			__m128i *ptr = reinterpret_cast<__m128i *>(tiles);
+			if constexpr (TStride == 8) values = _mm_slli_epi64(values, TOffset * 8);
+			if constexpr (TStride == 4) values = _mm_slli_epi32(values, TOffset * 8);
+			const __m128i tile = _mm_loadu_si128(ptr);
+			_mm_storeu_si128(ptr, _mm_or_si128(_mm_andnot_si128(FieldMask(), tile), values));
+		} else {
+			ScatterExpanded<TWidth * 2>(tiles, Widen<TWidth, false>(values));
+			ScatterExpanded<TWidth * 2>(tiles + (8 * TStride / TWidth), Widen<TWidth, true>(values));
+		}
+	}
+
+	/**
+	 * Extract the field of the tiles covered by a vector of \a TWidth byte elements, packed into the low FIELD_SIZE bytes of each element.
+	 * @tparam TWidth Width of the elements of the result in bytes.
+	 */
+	template <size_t TWidth>
+	static __m128i GatherPacked(const uint8_t *tiles)
+	{
+		if constexpr (TWidth == TStride) {
+			const __m128i tile = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tiles));
+			const __m128i field = _mm_and_si128(tile, FieldMask());
+			if constexpr (TStride == 8) return _mm_srli_epi64(field, TOffset * 8);
+			if constexpr (TStride == 4) return _mm_srli_epi32(field, TOffset * 8);
+		} else {
+			return Narrow<TWidth * 2>(GatherPacked<TWidth * 2>(tiles), GatherPacked<TWidth * 2>(tiles + (8 * TStride / TWidth)));
+		}
+	}
+#endif /* MAP_SL_TRANSPOSE_SSE2 */
+};
+
+#endif /* SL_MAP_SL_TRANSPOSE_H */
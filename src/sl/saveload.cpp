@@ -22,6 +22,7 @@
 
 #include "../stdafx.h"
 #include "../debug.h"
+#include "../debug_trace.h"
 #include "../station_base.h"
 #include "../thread.h"
 #include "../town.h"
@@ -49,8 +50,10 @@
 #include "../newgrf_railtype.h"
 #include "../newgrf_roadtype.h"
 #include "../3rdparty/cpp-ring-buffer/ring_buffer.hpp"
+#include "../3rdparty/md5/md5.h"
 #include "../timer/timer_game_tick.h"
 #include <atomic>
+#include <deque>
 #include <string>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -300,6 +303,8 @@ struct SaveLoadParams {
 
 	bool saveinprogress;                 ///< Whether there is currently a save in progress.
 	SaveModeFlags save_flags;            ///< Save mode flags
+	std::string save_name;               ///< Name of the file being saved, for differential saves.
+	std::vector<std::pair<size_t, size_t>> chunk_ranges; ///< Start and end offsets of the saved chunks in the dumper, for differential saves.
 };
 
 static SaveLoadParams _sl; ///< Parameters used for/at saveload.
@@ -3029,8 +3034,16 @@ static void SlSaveChunk(const ChunkHandler &ch)
 /** Save all chunks */
 static void SlSaveChunks()
 {
+	TraceZone trace_zone("Save chunks");
 	for (auto &ch : ChunkHandlers()) {
-		SlSaveChunk(ch);
+		if (_sl.save_flags & SMF_DIFFERENTIAL) {
+			const size_t start = _sl.dumper->GetSize();
+			SlSaveChunk(ch);
+			const size_t end = _sl.dumper->GetSize();
+			if (end > start) _sl.chunk_ranges.emplace_back(start, end);
+		} else {
+			SlSaveChunk(ch);
+		}
 	}
 
 	/* Terminator */
@@ -3052,6 +3065,7 @@ static const ChunkHandler *SlFindChunkHandler(uint32_t id)
 /** Load all chunks */
 static void SlLoadChunks()
 {
+	TraceZone trace_zone("Load chunks");
 	if (_sl_upstream_mode) {
 		upstream_sl::SlLoadChunks();
 		return;
@@ -3879,6 +3893,8 @@ static inline void ClearSaveLoadState()
 	_sl.reader = nullptr;
 	_sl.lf = nullptr;
 	_sl.save_flags = SMF_NONE;
+	_sl.save_name.clear();
+	_sl.chunk_ranges.clear();
 	_sl.current_chunk_id = 0;
 	_sl.chunk_block_modes.clear();
 
@@ -3932,12 +3948,509 @@ static void SaveFileError()
 	SaveFileDone();
 }
 
+/*
+ * Differential autosaves.
+ *
+ * A differential savegame starts with the tag 'OTDF', the savegame version, the identity of the savegame and the
+ * identity of its base (0 when it does not have a base), followed by the header of its compression format and the
+ * compressed payload. The payload lists the saved chunks, each as its ID and number of segments, and for each segment
+ * whether it is stored literally or refers to the segment with the same index of the same chunk in the base, its hash
+ * and its length, followed by the data of literal segments. The list is terminated by a chunk ID of 0.
+ *
+ * A differential autosave without base is copied to a base file named after its identity, which later differential
+ * autosaves refer to. Loading rebuilds the plain chunk stream of the savegame from the segments of it and its base.
+ */
+
+static const uint32_t DIFFERENTIAL_SAVEGAME_TAG = TO_BE32('OTDF');
+static const size_t DIFFERENTIAL_SAVEGAME_SEGMENT_SIZE = 1024 * 1024; ///< Size of the hashed segments of the chunks, for the map arrays this is a band of rows.
+
+/** The base of the differential autosaves, only accessed while saving, which is never done concurrently. */
+struct DifferentialSaveBase {
+	uint64_t identity = 0;                                          ///< Identity of the base, 0 if there is none.
+	btree::btree_map<uint32_t, std::vector<uint64_t>> chunk_hashes; ///< Hashes of the segments of each chunk of the base.
+	uint saves_since_base = 0;                                      ///< Number of differential autosaves referring to the base.
+	std::deque<uint64_t> history;                                   ///< Identities of the base files written in this session, oldest first.
+};
+
+static DifferentialSaveBase _differential_save_base;
+
+/**
+ * Get the name of the base file of differential autosaves, in the autosave directory.
+ * @param identity The identity of the base.
+ * @return The file name.
+ */
+static std::string GetDifferentialSaveBaseName(uint64_t identity)
+{
+	return fmt::format("diffbase-{:016x}.sav", identity);
+}
+
+/**
+ * Call a handler with each contiguous part of a range of the memory dump.
+ * @param dumper The dumper, its last block must have been finalised.
+ * @param start The start offset of the range.
+ * @param end The end offset of the range.
+ * @param handler The handler, called with a std::span<uint8_t>.
+ */
+template <typename F>
+static void ForEachMemoryDumperSpan(MemoryDumper &dumper, size_t start, size_t end, F handler)
+{
+	size_t offset = 0;
+	for (const MemoryDumper::BufferInfo &block : dumper.blocks) {
+		if (start >= end) return;
+		const size_t block_end = offset + block.size;
+		if (start < block_end) {
+			const size_t length = std::min(end, block_end) - start;
+			handler(std::span<uint8_t>(block.data + (start - offset), length));
+			start += length;
+		}
+		offset = block_end;
+	}
+}
+
+/**
+ * Hash a range of the memory dump.
+ * @param dumper The dumper, its last block must have been finalised.
+ * @param start The start offset of the range.
+ * @param end The end offset of the range.
+ * @return The first 64 bits of the MD5 hash of the range.
+ */
+static uint64_t HashMemoryDumperRange(MemoryDumper &dumper, size_t start, size_t end)
+{
+	Md5 checksum;
+	ForEachMemoryDumperSpan(dumper, start, end, [&](std::span<uint8_t> data) {
+		checksum.Append(data.data(), data.size());
+	});
+	MD5Hash digest;
+	checksum.Finish(digest);
+
+	uint64_t hash = 0;
+	for (uint i = 0; i < 8; i++) hash = (hash << 8) | digest[i];
+	return hash;
+}
+
+/** Buffered big endian writer of the fields of a differential savegame. */
+struct DifferentialSaveWriter {
+	SaveFilter &writer;          ///< The filter to write to.
+	std::vector<uint8_t> buffer; ///< Fields which have not been written yet.
+
+	DifferentialSaveWriter(SaveFilter &writer) : writer(writer) {}
+
+	void WriteByte(uint8_t value)
+	{
+		this->buffer.push_back(value);
+	}
+
+	void WriteUint32(uint32_t value)
+	{
+		for (int shift = 24; shift >= 0; shift -= 8) this->buffer.push_back(GB(value, shift, 8));
+	}
+
+	void WriteUint64(uint64_t value)
+	{
+		this->WriteUint32(static_cast<uint32_t>(value >> 32));
+		this->WriteUint32(static_cast<uint32_t>(value));
+	}
+
+	void Flush()
+	{
+		if (!this->buffer.empty()) this->writer.Write(this->buffer.data(), this->buffer.size());
+		this->buffer.clear();
+	}
+};
+
+/**
+ * Copy an autosave.
+ * @param from The name of the autosave to copy.
+ * @param to The name of the copy.
+ * @return Whether the copy was made.
+ */
+static bool CopyAutosaveFile(const std::string &from, const std::string &to)
+{
+	auto in = FioFOpenFile(from, "rb", Subdirectory::Autosave);
+	if (!in.has_value()) return false;
+
+	const std::string temp_suffix = fmt::format(".tmp-{:08x}", InteractiveRandom());
+	std::string temp_name;
+	auto out = FioFOpenFile(to + temp_suffix, "wb", Subdirectory::Autosave, nullptr, &temp_name);
+	if (!out.has_value()) return false;
+
+	std::vector<uint8_t> buffer(MEMORY_CHUNK_SIZE);
+	bool ok = true;
+	for (;;) {
+		const size_t length = fread(buffer.data(), 1, buffer.size(), *in);
+		if (length == 0) break;
+		if (fwrite(buffer.data(), 1, length, *out) != length) {
+			ok = false;
+			break;
+		}
+	}
+	if (ferror(*in)) ok = false;
+	out.reset();
+
+	if (!ok || !FioRenameFile(temp_name, temp_name.substr(0, temp_name.size() - temp_suffix.size()))) {
+		FioRemove(temp_name);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Write the memory dump as a differential savegame.
+ * Segments which are equal to those of the base are not written, unless there is no usable base or a new base is due.
+ * @param fmt The compression format.
+ * @param compression The compression level.
+ */
+static void SaveDifferentialFileToDisk(const SaveLoadFormat *fmt, uint8_t compression)
+{
+	TraceZone trace_zone("Save differential");
+
+	/** The segment hashes of a saved chunk. */
+	struct SavedChunk {
+		uint32_t id;                  ///< Chunk ID.
+		size_t start;                 ///< Offset of the chunk data, after the ID, in the memory dump.
+		size_t end;                   ///< Offset of the end of the chunk data in the memory dump.
+		std::vector<uint64_t> hashes; ///< Hashes of the segments.
+		const std::vector<uint64_t> *base_hashes; ///< Hashes of the segments of this chunk in the base, or nullptr.
+	};
+
+	MemoryDumper &dumper = *_sl.dumper;
+	dumper.FinaliseBlock();
+
+	DifferentialSaveBase &base = _differential_save_base;
+	const uint interval = _settings_client.gui.differential_autosaves;
+
+	std::vector<SavedChunk> chunks;
+	chunks.reserve(_sl.chunk_ranges.size());
+	Md5 identity_checksum;
+	size_t total_bytes = 0;
+	size_t changed_bytes = 0;
+	for (const auto &[start, end] : _sl.chunk_ranges) {
+		uint32_t id = 0;
+		ForEachMemoryDumperSpan(dumper, start, start + 4, [&](std::span<uint8_t> data) {
+			for (uint8_t b : data) id = (id << 8) | b;
+		});
+
+		SavedChunk &chunk = chunks.emplace_back(SavedChunk{id, start + 4, end, {}, nullptr});
+		auto it = base.chunk_hashes.find(id);
+		chunk.base_hashes = (it != base.chunk_hashes.end()) ? &it->second : nullptr;
+		for (size_t offset = chunk.start; offset < chunk.end; offset += DIFFERENTIAL_SAVEGAME_SEGMENT_SIZE) {
+			const size_t segment_end = std::min(offset + DIFFERENTIAL_SAVEGAME_SEGMENT_SIZE, chunk.end);
+			const size_t index = chunk.hashes.size();
+			const uint64_t hash = HashMemoryDumperRange(dumper, offset, segment_end);
+			if (chunk.base_hashes == nullptr || index >= chunk.base_hashes->size() || (*chunk.base_hashes)[index] != hash) {
+				changed_bytes += segment_end - offset;
+			}
+			chunk.hashes.push_back(hash);
+			total_bytes += segment_end - offset;
+		}
+
+		identity_checksum.Append(&id, sizeof(id));
+		identity_checksum.Append(chunk.hashes.data(), chunk.hashes.size() * sizeof(uint64_t));
+	}
+
+	MD5Hash digest;
+	identity_checksum.Finish(digest);
+	uint64_t identity = 0;
+	for (uint i = 0; i < 8; i++) identity = (identity << 8) | digest[i];
+	if (identity == 0) identity = 1;
+
+	/* Write a new base when there is none, when the configured number of differential autosaves refer to the current
+	 * one, when most of the game has changed since, or when its file has been removed. */
+	const bool full = base.identity == 0 || base.saves_since_base >= interval || changed_bytes * 2 > total_bytes ||
+			!FioCheckFileExists(GetDifferentialSaveBaseName(base.identity), Subdirectory::Autosave);
+
+	const uint32_t version = TO_BE32((uint32_t) (SAVEGAME_VERSION | SAVEGAME_VERSION_EXT) << 16);
+	DifferentialSaveWriter header(*_sl.sf);
+	header.WriteUint32(FROM_BE32(DIFFERENTIAL_SAVEGAME_TAG));
+	header.WriteUint32(FROM_BE32(version));
+	header.WriteUint64(identity);
+	header.WriteUint64(full ? 0 : base.identity);
+	header.WriteUint32(FROM_BE32(fmt->tag));
+	header.WriteUint32(FROM_BE32(version));
+	header.Flush();
+
+	_sl.sf = fmt->init_write(_sl.sf, compression);
+	DifferentialSaveWriter payload(*_sl.sf);
+	for (const SavedChunk &chunk : chunks) {
+		payload.WriteUint32(chunk.id);
+		payload.WriteUint32(static_cast<uint32_t>(chunk.hashes.size()));
+		for (size_t index = 0; index < chunk.hashes.size(); index++) {
+			const size_t offset = chunk.start + index * DIFFERENTIAL_SAVEGAME_SEGMENT_SIZE;
+			const size_t segment_end = std::min(offset + DIFFERENTIAL_SAVEGAME_SEGMENT_SIZE, chunk.end);
+			const bool literal = full || chunk.base_hashes == nullptr || index >= chunk.base_hashes->size() || (*chunk.base_hashes)[index] != chunk.hashes[index];
+			payload.WriteByte(literal ? 0 : 1);
+			payload.WriteUint64(chunk.hashes[index]);
+			payload.WriteUint32(static_cast<uint32_t>(segment_end - offset));
+			if (literal) {
+				payload.Flush();
+				ForEachMemoryDumperSpan(dumper, offset, segment_end, [&](std::span<uint8_t> data) {
+					_sl.sf->Write(data.data(), data.size());
+				});
+			}
+		}
+	}
+	payload.WriteUint32(0);
+	payload.Flush();
+	_sl.sf->Finish();
+
+	Debug(sl, 2, "Saved {} differential savegame {:016x}: {} of {} bytes changed since base", full ? "full" : "incremental", identity, changed_bytes, total_bytes);
+
+	if (!full) {
+		base.saves_since_base++;
+		return;
+	}
+
+	/* Keep a copy of the savegame as the base of the following differential autosaves,
+	 * as the savegame itself will be overwritten when the autosave names rotate. */
+	base.identity = 0;
+	base.chunk_hashes.clear();
+	if (!CopyAutosaveFile(_sl.save_name, GetDifferentialSaveBaseName(identity))) {
+		Debug(sl, 0, "Failed to write base of differential autosaves, the next autosave will be a full one");
+		return;
+	}
+	base.identity = identity;
+	base.saves_since_base = 0;
+	for (SavedChunk &chunk : chunks) {
+		base.chunk_hashes[chunk.id] = std::move(chunk.hashes);
+	}
+
+	std::erase(base.history, identity);
+	base.history.push_back(identity);
+	if (!_settings_client.gui.keep_all_autosave) {
+		/* A base is needed until all autosaves referring to it have been overwritten by the rotation of names. */
+		const size_t keep = CeilDiv(_settings_client.gui.max_num_autosaves + interval, interval + 1) + 1;
+		while (base.history.size() > keep) {
+			const std::string path = FioFindFullPath(Subdirectory::Autosave, GetDifferentialSaveBaseName(base.history.front()));
+			if (!path.empty()) FioRemove(path);
+			base.history.pop_front();
+		}
+	}
+}
+
+/** A differential savegame read into memory. */
+struct DifferentialSavegame {
+	uint32_t version;             ///< Savegame version field of the header.
+	uint64_t identity;            ///< Identity of the savegame.
+	uint64_t base_identity;       ///< Identity of the base, or 0.
+	std::vector<uint8_t> payload; ///< Decompressed payload.
+
+	/** A segment of a chunk. */
+	struct Segment {
+		bool literal;                  ///< Whether the segment data is stored in this savegame.
+		uint64_t hash;                 ///< Hash of the segment data.
+		uint32_t length;               ///< Length of the segment data.
+		std::span<const uint8_t> data; ///< The segment data if it is literal.
+	};
+
+	/** Cursor for reading the big endian fields of the payload. */
+	struct Reader {
+		std::span<const uint8_t> data; ///< The payload.
+		size_t pos = 0;                ///< Read position.
+
+		std::span<const uint8_t> ReadBytes(size_t length)
+		{
+			if (length > this->data.size() - this->pos) SlErrorCorrupt("Truncated differential savegame");
+			std::span<const uint8_t> result = this->data.subspan(this->pos, length);
+			this->pos += length;
+			return result;
+		}
+
+		uint8_t ReadByte() { return this->ReadBytes(1)[0]; }
+
+		uint32_t ReadUint32()
+		{
+			uint32_t value = 0;
+			for (uint8_t b : this->ReadBytes(4)) value = (value << 8) | b;
+			return value;
+		}
+
+		uint64_t ReadUint64()
+		{
+			uint64_t high = this->ReadUint32();
+			return (high << 32) | this->ReadUint32();
+		}
+	};
+
+	/**
+	 * Call a handler with each chunk of the payload.
+	 * @param handler The handler, called with the chunk ID and its segments.
+	 */
+	template <typename F>
+	void ForEachChunk(F handler) const
+	{
+		Reader reader{this->payload};
+		std::vector<Segment> segments;
+		for (uint32_t id = reader.ReadUint32(); id != 0; id = reader.ReadUint32()) {
+			segments.clear();
+			const uint32_t count = reader.ReadUint32();
+			for (uint32_t i = 0; i < count; i++) {
+				Segment &segment = segments.emplace_back();
+				const uint8_t kind = reader.ReadByte();
+				if (kind > 1) SlErrorCorrupt("Invalid segment in differential savegame");
+				segment.literal = (kind == 0);
+				segment.hash = reader.ReadUint64();
+				segment.length = reader.ReadUint32();
+				if (segment.literal) segment.data = reader.ReadBytes(segment.length);
+			}
+			handler(id, std::span<const Segment>(segments));
+		}
+	}
+};
+
+/**
+ * Read a differential savegame, after its tag and version.
+ * @param reader The filter to read from.
+ * @param version The version field of the header.
+ * @return The savegame.
+ */
+static DifferentialSavegame ReadDifferentialSavegame(std::shared_ptr<LoadFilter> reader, uint32_t version)
+{
+	uint8_t fields[16];
+	if (reader->Read(fields, sizeof(fields)) != sizeof(fields)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	DifferentialSavegame::Reader fields_reader{fields};
+
+	DifferentialSavegame savegame;
+	savegame.version = version;
+	savegame.identity = fields_reader.ReadUint64();
+	savegame.base_identity = fields_reader.ReadUint64();
+
+	uint32_t hdr[2];
+	if (reader->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	if (hdr[1] != version) SlErrorCorrupt("Mismatching versions in differential savegame header");
+
+	auto fmt = std::ranges::find_if(_saveload_formats, [&](const SaveLoadFormat &fmt) { return fmt.tag == hdr[0] && fmt.init_load != nullptr; });
+	if (fmt == std::end(_saveload_formats)) {
+		SlError(STR_GAME_SAVELOAD_ERROR_BROKEN_INTERNAL_ERROR, "Loader for the compression of the differential savegame is not available.");
+	}
+
+	reader = fmt->init_load(std::move(reader));
+	size_t size = 0;
+	for (;;) {
+		savegame.payload.resize(size + MEMORY_CHUNK_SIZE);
+		const size_t length = reader->Read(savegame.payload.data() + size, MEMORY_CHUNK_SIZE);
+		if (length == 0) break;
+		size += length;
+	}
+	savegame.payload.resize(size);
+	return savegame;
+}
+
+/** Filter reading the plain chunk stream of a differential savegame, rebuilt from it and its base. */
+struct DifferentialLoadFilter : LoadFilter {
+	DifferentialSavegame savegame;                  ///< The savegame.
+	DifferentialSavegame base;                      ///< The base of the savegame, if any.
+	std::array<uint32_t, 2> header;                 ///< Header of an uncompressed savegame.
+	std::deque<uint32_t> chunk_ids;                 ///< Big endian IDs of the chunks.
+	const uint32_t terminator = 0;                  ///< End of the chunk stream.
+	std::vector<std::span<const uint8_t>> spans;    ///< The parts of the rebuilt stream.
+	size_t span_index = 0;                          ///< Span currently being read.
+	size_t span_offset = 0;                         ///< Read position within the current span.
+
+	DifferentialLoadFilter(DifferentialSavegame &&savegame, DifferentialSavegame &&base) : LoadFilter(nullptr), savegame(std::move(savegame)), base(std::move(base))
+	{
+		this->header = { TO_BE32('OTTN'), this->savegame.version };
+		this->spans.emplace_back(reinterpret_cast<const uint8_t *>(this->header.data()), sizeof(this->header));
+
+		btree::btree_map<uint32_t, std::vector<DifferentialSavegame::Segment>> base_chunks;
+		this->base.ForEachChunk([&](uint32_t id, std::span<const DifferentialSavegame::Segment> segments) {
+			base_chunks[id].assign(segments.begin(), segments.end());
+		});
+
+		this->savegame.ForEachChunk([&](uint32_t id, std::span<const DifferentialSavegame::Segment> segments) {
+			this->chunk_ids.push_back(TO_BE32(id));
+			this->spans.emplace_back(reinterpret_cast<const uint8_t *>(&this->chunk_ids.back()), sizeof(uint32_t));
+
+			const auto it = base_chunks.find(id);
+			for (size_t index = 0; index < segments.size(); index++) {
+				const DifferentialSavegame::Segment &segment = segments[index];
+				if (segment.literal) {
+					this->spans.push_back(segment.data);
+					continue;
+				}
+				if (it == base_chunks.end() || index >= it->second.size()) {
+					SlErrorCorruptFmt("Differential savegame refers to missing segment {} of chunk {} in its base", index, ChunkIDDumper()(id));
+				}
+				const DifferentialSavegame::Segment &base_segment = it->second[index];
+				if (base_segment.hash != segment.hash || !base_segment.literal || base_segment.length != segment.length) {
+					SlErrorCorruptFmt("Differential savegame refers to mismatching segment {} of chunk {} in its base", index, ChunkIDDumper()(id));
+				}
+				this->spans.push_back(base_segment.data);
+			}
+		});
+
+		this->spans.emplace_back(reinterpret_cast<const uint8_t *>(&this->terminator), sizeof(this->terminator));
+	}
+
+	size_t Read(uint8_t *buf, size_t size) override
+	{
+		size_t read = 0;
+		while (read < size && this->span_index < this->spans.size()) {
+			const std::span<const uint8_t> &span = this->spans[this->span_index];
+			const size_t length = std::min(size - read, span.size() - this->span_offset);
+			std::copy_n(span.data() + this->span_offset, length, buf + read);
+			read += length;
+			this->span_offset += length;
+			if (this->span_offset == span.size()) {
+				this->span_index++;
+				this->span_offset = 0;
+			}
+		}
+		return read;
+	}
+
+	void Reset() override
+	{
+		this->span_index = 0;
+		this->span_offset = 0;
+	}
+};
+
+/**
+ * Load a differential savegame, and its base if it has one, into memory.
+ * @param reader The filter to read the savegame from, positioned after the tag and version.
+ * @param version The version field of the header.
+ * @return Filter reading the rebuilt plain savegame, starting with its header.
+ */
+static std::shared_ptr<LoadFilter> LoadDifferentialSavegame(std::shared_ptr<LoadFilter> reader, uint32_t version)
+{
+	TraceZone trace_zone("Load differential");
+
+	DifferentialSavegame savegame = ReadDifferentialSavegame(std::move(reader), version);
+	DifferentialSavegame base{};
+
+	if (savegame.base_identity != 0) {
+		const std::string base_name = GetDifferentialSaveBaseName(savegame.base_identity);
+		Debug(sl, 2, "Loading base of differential savegame: {}", base_name);
+
+		auto fh = FioFOpenFile(base_name, "rb", Subdirectory::Autosave);
+		if (!fh.has_value()) {
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE, fmt::format("The base autosave '{}' of this differential autosave is missing.", base_name));
+		}
+		auto base_reader = std::make_shared<FileReader>(std::move(*fh));
+		uint32_t hdr[2];
+		if (base_reader->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+		if (hdr[0] != DIFFERENTIAL_SAVEGAME_TAG || hdr[1] != version) {
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE, fmt::format("The base autosave '{}' of this differential autosave is not compatible.", base_name));
+		}
+
+		base = ReadDifferentialSavegame(std::move(base_reader), version);
+		if (base.identity != savegame.base_identity || base.base_identity != 0) {
+			SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE, fmt::format("The base autosave '{}' of this differential autosave has been replaced.", base_name));
+		}
+	} else {
+		base.payload.resize(4); // Empty chunk list
+	}
+
+	return std::make_shared<DifferentialLoadFilter>(std::move(savegame), std::move(base));
+}
+
 /**
  * We have written the whole game into memory, _memory_savegame, now find
  * and appropriate compressor and start writing to file.
  */
 static SaveLoadResult SaveFileToDisk(bool threaded)
 {
+	TraceZone trace_zone("Save to disk");
 	try {
 		uint8_t compression;
 		const SaveLoadFormat *fmt = GetSavegameFormat(_savegame_format, &compression, _sl.save_flags);
@@ -3945,11 +4458,15 @@ static SaveLoadResult SaveFileToDisk(bool threaded)
 		Debug(sl, 3, "Using compression format: {}, level: {}", fmt->name, compression);
 
 		/* We have written our stuff to memory, now write it to file! */
-		uint32_t hdr[2] = { fmt->tag, TO_BE32((uint32_t) (SAVEGAME_VERSION | SAVEGAME_VERSION_EXT) << 16) };
-		_sl.sf->Write((uint8_t*)hdr, sizeof(hdr));
+		if (_sl.save_flags & SMF_DIFFERENTIAL) {
+			SaveDifferentialFileToDisk(fmt, compression);
+		} else {
+			uint32_t hdr[2] = { fmt->tag, TO_BE32((uint32_t) (SAVEGAME_VERSION | SAVEGAME_VERSION_EXT) << 16) };
+			_sl.sf->Write((uint8_t*)hdr, sizeof(hdr));
 
-		_sl.sf = fmt->init_write(_sl.sf, compression);
-		_sl.dumper->Flush(*(_sl.sf));
+			_sl.sf = fmt->init_write(_sl.sf, compression);
+			_sl.dumper->Flush(*(_sl.sf));
+		}
 
 		ClearSaveLoadState();
 
@@ -4161,6 +4678,7 @@ struct ThreadedLoadFilter : LoadFilter {
  */
 static SaveLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check)
 {
+	TraceZone trace_zone("Load");
 	_sl.lf = std::move(reader);
 
 	if (load_check) {
@@ -4182,6 +4700,11 @@ static SaveLoadResult DoLoad(std::shared_ptr<LoadFilter> reader, bool load_check
 	uint32_t hdr[2];
 	if (_sl.lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
 
+	if (hdr[0] == DIFFERENTIAL_SAVEGAME_TAG) {
+		_sl.lf = LoadDifferentialSavegame(std::move(_sl.lf), hdr[1]);
+		if (_sl.lf->Read((uint8_t*)hdr, sizeof(hdr)) != sizeof(hdr)) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_READABLE);
+	}
+
 	SaveLoadVersion original_sl_version = SL_MIN_VERSION;
 
 	/* see if we have any loader for this type. */
@@ -4500,6 +5023,7 @@ SaveLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, De
 			if (temp_save_filename.size() <= temp_save_filename_suffix.size()) SlError(STR_GAME_SAVELOAD_ERROR_FILE_NOT_WRITEABLE, "Failed to get temporary file name");
 			Debug(desync, 1, "save: {}; {}", debug_date_dumper().HexDate(), filename);
 			if (!_settings_client.gui.threaded_saves) threaded = false;
+			if (save_flags & SMF_DIFFERENTIAL) _sl.save_name = filename;
 
 			return DoSave(std::make_shared<FileWriter>(std::move(*fh), temp_save_filename, temp_save_filename.substr(0, temp_save_filename.size() - temp_save_filename_suffix.size())), threaded);
 		}
@@ -4528,12 +5052,16 @@ SaveLoadResult SaveOrLoad(const std::string &filename, SaveLoadOperation fop, De
 void DoAutoOrNetsave(FiosNumberedSaveName &counter, bool threaded, FiosNumberedSaveName *lt_counter)
 {
 	std::string filename;
+	SaveModeFlags flags = SMF_ZSTD_OK;
+	if (_settings_client.gui.differential_autosaves > 0) flags |= SMF_DIFFERENTIAL;
 
 	if (_settings_client.gui.keep_all_autosave) {
 		filename = GenerateDefaultSaveName() + counter.Extension();
 	} else {
 		filename = counter.Filename();
 		if (lt_counter != nullptr && counter.GetLastNumber() == 0) {
+			/* The autosave with the first number becomes a long-term one at the next rotation, so it must not depend on a base which will be removed. */
+			flags &= ~SMF_DIFFERENTIAL;
 			std::string lt_path = lt_counter->FilenameUsingMaxSaves(_settings_client.gui.max_num_lt_autosaves);
 			Debug(sl, 2, "Renaming autosave '{}' to long-term file '{}'", filename, lt_path);
 			std::string dir = FioFindDirectory(Subdirectory::Autosave);
@@ -4542,7 +5070,7 @@ void DoAutoOrNetsave(FiosNumberedSaveName &counter, bool threaded, FiosNumberedS
 	}
 
 	Debug(sl, 2, "Autosaving to '{}'", filename);
-	if (SaveOrLoad(filename, SaveLoadOperation::Save, DetailedFileType::GameFile, Subdirectory::Autosave, threaded, SMF_ZSTD_OK) != SaveLoadResult::Ok) {
+	if (SaveOrLoad(filename, SaveLoadOperation::Save, DetailedFileType::GameFile, Subdirectory::Autosave, threaded, flags) != SaveLoadResult::Ok) {
 		ShowErrorMessage(GetEncodedString(STR_ERROR_AUTOSAVE_FAILED), {}, WarningLevel::Error);
 	}
 }
@@ -59,6 +59,7 @@ enum SaveModeFlags : uint8_t {
 	SMF_NET_SERVER       = 1 << 0, ///< Network server save
 	SMF_ZSTD_OK          = 1 << 1, ///< Zstd OK
 	SMF_SCENARIO         = 1 << 2, ///< Scenario save
+	SMF_DIFFERENTIAL     = 1 << 3, ///< Differential autosave, unchanged parts may refer to a base autosave
 };
 DECLARE_ENUM_AS_BIT_SET(SaveModeFlags);
 
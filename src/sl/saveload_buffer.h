@@ -212,6 +212,24 @@ struct ReadBuffer {
 		}
 	}
 
+	/**
+	 * Read a number of fixed size items, passing the raw bytes of as many complete items as are contiguous in the buffer to the handler at a time.
+	 * @param length Number of items.
+	 * @param item_size Size of each item in bytes.
+	 * @param handler Handler, called with a pointer to the raw bytes and the number of items.
+	 */
+	template <typename F>
+	inline void ReadItemsToSpanHandler(size_t length, size_t item_size, F handler)
+	{
+		while (length) {
+			this->CheckBytes(item_size);
+			size_t to_copy = std::min<size_t>((this->bufe - this->bufp) / item_size, length);
+			handler(const_cast<const uint8_t *>(this->bufp), to_copy);
+			this->bufp += to_copy * item_size;
+			length -= to_copy;
+		}
+	}
+
 	/**
 	 * Get the size of the memory dump made so far.
 	 * @return The size.
@@ -435,6 +453,24 @@ struct MemoryDumper {
 	}
 
 
+	/**
+	 * Write a number of fixed size items, passing space for as many complete items as are contiguous in the buffer to the handler at a time.
+	 * @param length Number of items.
+	 * @param item_size Size of each item in bytes.
+	 * @param handler Handler, called with a pointer to the space for the raw bytes and the number of items.
+	 */
+	template <typename F>
+	inline void WriteItemsFromSpanHandler(size_t length, size_t item_size, F handler)
+	{
+		while (length) {
+			this->CheckBytes(item_size);
+			size_t to_copy = std::min<size_t>((this->bufe - this->buf) / item_size, length);
+			handler(this->buf, to_copy);
+			this->buf += to_copy * item_size;
+			length -= to_copy;
+		}
+	}
+
 	void Flush(SaveFilter &writer);
 	size_t GetSize() const;
 	size_t GetWriteOffsetGeneric() const;
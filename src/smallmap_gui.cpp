@@ -174,8 +174,147 @@ static bool _smallmap_industry_highlight_state;
 /** For connecting company ID to position in owner list (small map legend) */
 TypedIndexContainer<std::array<uint32_t, MAX_COMPANIES>, CompanyID> _company_to_list_pos;
 
+/**
+ * Persistent colour buffer of the smallmap.
+ * Each cell holds the colours of one tile_zoom x tile_zoom group of tiles, as returned by SmallMapWindow::GetTileColours.
+ * Cells are stored in lazily allocated square blocks, so only the parts of the map which have been looked at use memory.
+ * Map changes mark the covering cell dirty (see #MarkSmallMapTileDirty), and dirty cells are recomputed when next drawn.
+ * Changes which are not reported per tile discard the whole buffer (see #InvalidateSmallMapColourCache).
+ */
+struct SmallMapColourCache {
+	static constexpr uint BLOCK_BITS = 5;                             ///< Log2 of the side length of a block, in cells.
+	static constexpr uint BLOCK_SIZE = 1 << BLOCK_BITS;               ///< Side length of a block, in cells.
+	static constexpr uint BLOCK_CELLS = BLOCK_SIZE * BLOCK_SIZE;      ///< Number of cells in a block.
+
+	struct Block {
+		std::array<uint32_t, BLOCK_CELLS> colours;
+		std::array<uint64_t, BLOCK_CELLS / 64> dirty; ///< Bitmask of cells which need to be recomputed.
+		bool any_dirty;                               ///< Whether any bit in dirty is set.
+
+		void MarkAllDirty()
+		{
+			this->dirty.fill(UINT64_MAX);
+			this->any_dirty = true;
+		}
+	};
+
+	/** Inputs other than the tile data which the cached colours depend on. */
+	struct Key {
+		SmallMapType map_type;
+		int tile_zoom;
+		uint8_t land_colour;
+		bool show_heightmap;
+		bool freeform_edges;
+		uint map_size_x;
+		uint map_size_y;
+
+		bool operator==(const Key &other) const = default;
+	};
+
+	Key key{};
+	uint blocks_x = 0;
+	uint blocks_y = 0;
+	std::vector<std::unique_ptr<Block>> blocks;
+
+	/**
+	 * Check that the cache matches the given key, and discard all cached colours if not.
+	 * @param key Current drawing inputs.
+	 */
+	void Validate(const Key &key)
+	{
+		if (key == this->key && !this->blocks.empty()) return;
+
+		this->key = key;
+		uint cells_x = CeilDivT<uint>(key.map_size_x, key.tile_zoom);
+		uint cells_y = CeilDivT<uint>(key.map_size_y, key.tile_zoom);
+		this->blocks_x = CeilDivT<uint>(cells_x, BLOCK_SIZE);
+		this->blocks_y = CeilDivT<uint>(cells_y, BLOCK_SIZE);
+		this->blocks.clear();
+		this->blocks.resize(this->blocks_x * this->blocks_y);
+	}
+
+	/** Discard all cached colours. */
+	void Clear()
+	{
+		this->blocks.clear();
+	}
+
+	/**
+	 * Mark the cell containing a tile dirty.
+	 * @param tile Tile which has changed.
+	 */
+	void MarkTileDirty(TileIndex tile)
+	{
+		if (this->blocks.empty()) return;
+
+		uint cx = TileX(tile) / this->key.tile_zoom;
+		uint cy = TileY(tile) / this->key.tile_zoom;
+		uint bx = cx >> BLOCK_BITS;
+		uint by = cy >> BLOCK_BITS;
+		if (bx >= this->blocks_x || by >= this->blocks_y) return;
+
+		Block *block = this->blocks[bx + by * this->blocks_x].get();
+		if (block == nullptr) return;
+
+		uint idx = (cx & (BLOCK_SIZE - 1)) + ((cy & (BLOCK_SIZE - 1)) << BLOCK_BITS);
+		SetBit(block->dirty[idx / 64], idx % 64);
+		block->any_dirty = true;
+	}
+
+	/**
+	 * Get the colours of a cell, recomputing them if they are not known.
+	 * @param xc X coordinate of the first tile of the cell.
+	 * @param yc Y coordinate of the first tile of the cell.
+	 * @param compute Functor returning the colours of the cell.
+	 * @return Colours of the cell.
+	 */
+	template <typename F>
+	uint32_t GetColours(uint xc, uint yc, F compute)
+	{
+		uint cx = xc / this->key.tile_zoom;
+		uint cy = yc / this->key.tile_zoom;
+		std::unique_ptr<Block> &block = this->blocks[(cx >> BLOCK_BITS) + (cy >> BLOCK_BITS) * this->blocks_x];
+		if (block == nullptr) {
+			block = std::make_unique<Block>();
+			block->MarkAllDirty();
+		}
+
+		uint idx = (cx & (BLOCK_SIZE - 1)) + ((cy & (BLOCK_SIZE - 1)) << BLOCK_BITS);
+		if (block->any_dirty && HasBit(block->dirty[idx / 64], idx % 64)) {
+			block->colours[idx] = compute();
+			ClrBit(block->dirty[idx / 64], idx % 64);
+			if (block->dirty[idx / 64] == 0) {
+				block->any_dirty = std::ranges::any_of(block->dirty, [](uint64_t bits) { return bits != 0; });
+			}
+		}
+		return block->colours[idx];
+	}
+};
+
+/** Colour buffer of the open smallmap window, if any. */
+static std::unique_ptr<SmallMapColourCache> _smallmap_colour_cache;
+
+/**
+ * Mark a tile as changed for the purposes of the smallmap colour buffer.
+ * @param tile Tile which has changed.
+ */
+void MarkSmallMapTileDirty(TileIndex tile)
+{
+	if (_smallmap_colour_cache != nullptr) _smallmap_colour_cache->MarkTileDirty(tile);
+}
+
+/**
+ * Discard the whole smallmap colour buffer, for changes which are not specific to individual tiles.
+ */
+void InvalidateSmallMapColourCache()
+{
+	if (_smallmap_colour_cache != nullptr) _smallmap_colour_cache->Clear();
+}
+
 static void NotifyAllViewports(ViewportMapType map_type)
 {
+	InvalidateSmallMapColourCache();
+
 	for (Window *w : Window::Iterate()) {
 		if (w->viewport != nullptr) {
 			if (w->viewport->zoom >= ZoomLevel::DrawMap && w->viewport->map_type == map_type) {
@@ -687,7 +826,7 @@ inline Point SmallMapWindow::PixelToTile(int px, int py) const
 void SmallMapWindow::SetZoomLevel(ZoomLevelChange change, const Point *zoom_pt)
 {
 	static const int tile_zoomlevels[] = {1, 1, 1, 2, 4, 6, 8}; // Available zoom levels. Bigger number means more zoom-out (further away).
-	static const int ui_zoomlevels[] = {4, 2, 1, 1, 1, 1, 1};
+	static const int ui_zoomlevels[] = {MAX_UI_ZOOM, 2, 1, 1, 1, 1, 1};
 	static const int MIN_ZOOM_INDEX = 0;
 	static const int MAX_ZOOM_INDEX = lengthof(tile_zoomlevels) - 1;
 
@@ -821,16 +960,18 @@ inline uint32_t SmallMapWindow::GetTileColours(const TileArea &ta) const
  * @param start_pos Position of first pixel to draw.
  * @param end_pos Position of last pixel to draw (exclusive).
  * @param blitter current blitter
+ * @param cache Colour buffer to read tile colours from, or \c nullptr to compute them directly from the map.
  * @note If pixel position is below \c 0, skip drawing.
  */
-void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, int y, int end_y, Blitter *blitter) const
+void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, int y, int end_y, Blitter *blitter, SmallMapColourCache *cache) const
 {
 	void *dst_ptr_abs_end = blitter->MoveTo(_screen.dst_ptr, 0, _screen.height);
 	uint min_xy = _settings_game.construction.freeform_edges ? 1 : 0;
 
 	int hidden_x = std::max(0, -start_pos);
-	int hidden_idx = hidden_x / this->ui_zoom;
-	int hidden_mod = hidden_x % this->ui_zoom;
+	int width = end_pos - std::max(0, start_pos);
+	if (width <= 0) return;
+	assert(this->ui_zoom <= MAX_UI_ZOOM);
 
 	do {
 		/* Check if the tile (xc,yc) is within the map range */
@@ -840,49 +981,30 @@ void SmallMapWindow::DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch,
 		if (dst < _screen.dst_ptr) continue;
 		if (dst >= dst_ptr_abs_end) continue;
 
-		/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
-		TileArea ta;
-		if (min_xy == 1 && (xc == 0 || yc == 0)) {
-			if (this->tile_zoom == 1) continue; // The tile area is empty, don't draw anything.
-			ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->tile_zoom - (xc == 0), this->tile_zoom - (yc == 0));
-		} else {
-			ta = TileArea(TileXY(xc, yc), this->tile_zoom, this->tile_zoom);
-		}
-		ta.ClampToMap(); // Clamp to map boundaries (may contain TileType::Void tiles!).
+		if (min_xy == 1 && (xc == 0 || yc == 0) && this->tile_zoom == 1) continue; // The tile area is empty, don't draw anything.
 
-		uint32_t tile_colours = this->GetTileColours(ta);
-		auto get_val_colour = [tile_colours](uint8_t idx) -> PixelColour {
-			return PixelColour{static_cast<uint8_t>(tile_colours >> (idx * 8))};
-		};
-		if (this->ui_zoom == 1) {
-			int idx = std::max(0, -start_pos);
-			if (y >= 0 && y < end_y) {
-				for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
-					blitter->SetPixel(dst, idx, 0, get_val_colour(idx));
-					idx++;
-				}
-			}
-		} else {
-			auto ndst = dst;
-			auto ny = y;
-			for (auto i = 0; i < this->ui_zoom; i++) {
-				if (ny >= 0 && ny < end_y) {
-					int idx = hidden_idx;
-					int j = hidden_mod;
-					int x = hidden_x;
-					for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
-						blitter->SetPixel(ndst, x, 0, get_val_colour(idx));
-						j++;
-						x++;
-						if (j == this->ui_zoom) {
-							idx++;
-							j = 0;
-						}
-					}
-				}
-				ndst = blitter->MoveTo(ndst, pitch, 0);
-				ny++;
+		auto compute_colours = [&]() -> uint32_t {
+			/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
+			TileArea ta;
+			if (min_xy == 1 && (xc == 0 || yc == 0)) {
+				ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->tile_zoom - (xc == 0), this->tile_zoom - (yc == 0));
+			} else {
+				ta = TileArea(TileXY(xc, yc), this->tile_zoom, this->tile_zoom);
 			}
+			ta.ClampToMap(); // Clamp to map boundaries (may contain TileType::Void tiles!).
+			return this->GetTileColours(ta);
+		};
+		uint32_t tile_colours = (cache != nullptr) ? cache->GetColours(xc, yc, compute_colours) : compute_colours();
+
+		/* Expand the colours of the cell by the UI zoom into one line of pixels, and blit the visible part of it on each line of the cell. */
+		std::array<uint8_t, 4 * MAX_UI_ZOOM> line;
+		for (int i = 0; i < 4 * this->ui_zoom; i++) {
+			line[i] = GB(tile_colours, (i / this->ui_zoom) * 8, 8);
+		}
+		void *line_dst = dst;
+		for (int i = 0; i < this->ui_zoom; i++) {
+			if (y + i >= 0 && y + i < end_y) blitter->SetRect(line_dst, hidden_x, 0, line.data() + hidden_x, 1, width, 4 * this->ui_zoom);
+			line_dst = blitter->MoveTo(line_dst, pitch, 0);
 		}
 	/* Switch to next tile in the column */
 	} while (xc += this->tile_zoom, yc += this->tile_zoom, dst = blitter->MoveTo(dst, pitch * this->ui_zoom * 2, 0), y += 2 * this->ui_zoom, --reps != 0);
@@ -1013,12 +1135,22 @@ void SmallMapWindow::DrawMapIndicators() const
  * <li>Town names (optional)</li></ol>
  *
  * @param dpi pointer to pixel to write onto
+ * @param draw_indicators Whether to draw the main viewport position indicators.
+ * @param use_colour_cache Whether to use the persistent colour buffer, this should be false when drawing the whole map at once.
  */
-void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators) const
+void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators, bool use_colour_cache) const
 {
 	Blitter *blitter = BlitterFactory::GetCurrentBlitter();
 	AutoRestoreBackup dpi_backup(_cur_dpi, dpi);
 
+	/* The highlighted industry type blinks, so its tiles cannot be cached. */
+	SmallMapColourCache *cache = nullptr;
+	if (use_colour_cache && _smallmap_colour_cache != nullptr && !(this->map_type == SMT_INDUSTRY && _smallmap_industry_highlight != IT_INVALID)) {
+		cache = _smallmap_colour_cache.get();
+		cache->Validate({ this->map_type, this->tile_zoom, _settings_client.gui.smallmap_land_colour, _smallmap_show_heightmap,
+				_settings_game.construction.freeform_edges, Map::SizeX(), Map::SizeY() });
+	}
+
 	/* Clear it */
 	const PixelColour map_clear_color = (_settings_game.construction.map_edge_mode == MapEdgeMode::InfiniteWater) ? PC_WATER : PC_BLACK;
 	GfxFillRect(dpi->left, dpi->top, dpi->left + dpi->width - 1, dpi->top + dpi->height - 1, map_clear_color);
@@ -1046,7 +1178,7 @@ void SmallMapWindow::DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators) cons
 			int end_pos = std::min(dpi->width, x + 4 * this->ui_zoom);
 			int reps = (dpi->height - y + 3 * this->ui_zoom - 1) / 2 / this->ui_zoom; // Number of lines.
 			if (reps > 0) {
-				this->DrawSmallMapColumn(ptr, tile_x, tile_y, dpi->pitch, reps, x, end_pos, y, dpi->height, blitter);
+				this->DrawSmallMapColumn(ptr, tile_x, tile_y, dpi->pitch, reps, x, end_pos, y, dpi->height, blitter, cache);
 			}
 		}
 		if (even) {
@@ -1152,6 +1284,8 @@ SmallMapWindow::SmallMapWindow(WindowDesc &desc, int window_number) : Window(des
 	this->SetupWidgetData();
 	this->FinishInitNested(window_number);
 
+	_smallmap_colour_cache = std::make_unique<SmallMapColourCache>();
+
 	this->SetZoomLevel(ZLC_INITIALIZE, nullptr);
 	this->SmallMapCenterOnCurrentPos();
 	this->SetOverlayCargoMask();
@@ -1161,6 +1295,7 @@ SmallMapWindow::SmallMapWindow(WindowDesc &desc, int window_number) : Window(des
 /* virtual */ void SmallMapWindow::Close([[maybe_unused]] int data)
 {
 	this->BreakIndustryChainLink();
+	_smallmap_colour_cache.reset();
 	this->Window::Close();
 }
 
@@ -1637,6 +1772,8 @@ int SmallMapWindow::GetPositionOnLegend(Point pt)
 {
 	if (!gui_scope) return;
 
+	InvalidateSmallMapColourCache();
+
 	switch (data) {
 		case 1:
 			/* The owner legend has already been rebuilt. */
@@ -1823,7 +1960,7 @@ void SmallMapWindow::ScreenshotCallbackHandler(void *buf, uint y, uint pitch, ui
 	this->scroll_y = 0;
 
 	/* make the screenshot */
-	this->DrawSmallMap(&dpi, false);
+	this->DrawSmallMap(&dpi, false, false);
 }
 
 SmallMapType SmallMapWindow::map_type = SMT_CONTOUR;
@@ -38,6 +38,10 @@ void BuildIndustriesLegend();
 void ShowSmallMap();
 void BuildLandLegend();
 void BuildOwnerLegend();
+void MarkSmallMapTileDirty(TileIndex tile);
+void InvalidateSmallMapColourCache();
+
+struct SmallMapColourCache;
 
 /** Structure for holding relevant data for legends in small map */
 struct LegendAndColour {
@@ -83,6 +87,7 @@ protected:
 	static const uint FORCE_REFRESH_PERIOD_VEH = 240;         ///< map is redrawn after that many milliseconds (modes with vehicles).
 	static const uint FORCE_REFRESH_PERIOD_LINK_GRAPH = 2850; ///< map is redrawn after that many milliseconds (link graph mode).
 	static const uint BLINK_PERIOD         = 450;             ///< highlight blinking interval in milliseconds.
+	static const int MAX_UI_ZOOM           = 4;               ///< Largest UI (pixel doubling) zoom level.
 
 	uint min_number_of_columns = 0;    ///< Minimal number of columns in legends.
 	uint min_number_of_fixed_rows = 0; ///< Minimal number of rows in the legends for the fixed layouts only (all except #SMT_INDUSTRY).
@@ -176,11 +181,11 @@ protected:
 	uint PausedAdjustRefreshTimeDelta(uint delta_ms) const;
 
 	void DrawMapIndicators() const;
-	void DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, int y, int end_y, Blitter *blitter) const;
+	void DrawSmallMapColumn(void *dst, uint xc, uint yc, int pitch, int reps, int start_pos, int end_pos, int y, int end_y, Blitter *blitter, SmallMapColourCache *cache) const;
 	void DrawVehicles(const DrawPixelInfo *dpi, Blitter *blitter) const;
 	void DrawTowns(const DrawPixelInfo *dpi, const int vertical_padding) const;
 	void DrawIndustryNames(const DrawPixelInfo *dpi, const int vertical_padding) const;
-	void DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators = true) const;
+	void DrawSmallMap(DrawPixelInfo *dpi, bool draw_indicators = true, bool use_colour_cache = true) const;
 
 	Point TileToPixel(int tx, int ty) const;
 	Point PixelToTile(int px, int py) const;
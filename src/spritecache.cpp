@@ -26,6 +26,11 @@
 #include "spritecache.h"
 #include "spritecache_internal.h"
 #include "blitter/32bpp_base.hpp"
+#include "thread.h"
+#include "worker_thread.h"
+#include "fileio_func.h"
+#include "debug.h"
+#include "core/serialisation.hpp"
 
 #include "table/sprites.h"
 #include "table/strings.h"
@@ -35,13 +40,20 @@
 
 #include <vector>
 #include <algorithm>
+#include <map>
 #include <optional>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <filesystem>
 
 #include "safeguards.h"
 
 /** Default of 4MB spritecache. */
 uint _sprite_cache_size = 4;
 
+bool _sprite_cache_preload = true; ///< Whether to load the sprites into the sprite cache in the background after loading the sprite tables.
+
 size_t _spritecache_bytes_used = 0;
 static uint32_t _sprite_lru_counter;
 static uint32_t _spritecache_prune_events = 0;
@@ -52,6 +64,9 @@ static std::vector<SpriteCache> _spritecache;
 static std::vector<std::unique_ptr<SpriteFile>> _sprite_files;
 static RecolourSpriteCache _recolour_cache;
 
+static constexpr size_t SPRITE_PREFETCH_MIN_SPRITES = 4; ///< Minimum number of sprites to load for #PrefetchSprites to use the worker threads.
+static constexpr uint SPRITE_PRELOAD_CACHE_PERCENT = 50; ///< Percentage of the target sprite cache size up to which #StartSpriteCachePreload fills the sprite cache.
+
 static inline SpriteCache *GetSpriteCache(uint index)
 {
 	return &_spritecache[index];
@@ -516,9 +531,12 @@ static const char *GetSpriteTypeName(SpriteType type)
  * @param sprite_type Type of sprite.
  * @param allocator   Allocator function to use.
  * @param encoder     Sprite encoder to use.
+ * @param zoom_levels Zoom levels to load.
+ * @param worker_file If not nullptr, read from this handle of the sprite's file instead, as this is not running on the main thread.
+ *                    In this case nullptr is returned instead of the fallback sprite when the sprite cannot be loaded.
  * @return Read sprite data.
  */
-static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder, LowZoomLevels zoom_levels)
+static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder, LowZoomLevels zoom_levels, SpriteFile *worker_file = nullptr)
 {
 	/* Use current blitter if no other sprite encoder is given. */
 	if (encoder == nullptr) {
@@ -529,7 +547,7 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 	}
 	if (encoder->NoSpriteDataRequired()) zoom_levels = {};
 
-	SpriteFile &file = *sc->file;
+	SpriteFile &file = (worker_file != nullptr) ? *worker_file : *sc->file;
 	size_t file_pos = sc->file_pos;
 
 	SCOPE_INFO_FMT([&], "ReadSprite: pos: {}, id: {}, file: ({}), type: {}", file_pos, id, file.GetSimplifiedFilename(), GetSpriteTypeName(sprite_type));
@@ -558,7 +576,7 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 	}
 
 	if (load_result.loaded_sprites.None()) {
-		if (sprite_type == SpriteType::MapGen) return nullptr;
+		if (sprite_type == SpriteType::MapGen || worker_file != nullptr) return nullptr;
 		if (id == SPR_IMG_QUERY) UserError("Okay... something went horribly wrong. I couldn't load the fallback sprite. What should I do?");
 		return (void*)GetRawSprite(SPR_IMG_QUERY, SpriteType::Normal, LOW_ZOOM_ALL_BITS, &allocator, encoder);
 	}
@@ -595,6 +613,7 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 	}
 
 	if (!ResizeSprites(sprite, load_result.loaded_sprites, encoder, zoom_levels)) {
+		if (worker_file != nullptr) return nullptr;
 		if (id == SPR_IMG_QUERY) UserError("Okay... something went horribly wrong. I couldn't resize the fallback sprite. What should I do?");
 		return (void*)GetRawSprite(SPR_IMG_QUERY, SpriteType::Normal, LOW_ZOOM_ALL_BITS, &allocator, encoder);
 	}
@@ -634,8 +653,260 @@ size_t GetGRFSpriteOffset(uint32_t id)
 	return iter != _grf_sprite_offsets.end() ? iter->second.file_pos : SIZE_MAX;
 }
 
+/** Full path of a file on disk, or of the tar file containing it, and the start position of the GRF file in it. */
+using GrfSpriteOffsetCacheKey = std::pair<std::string, uint64_t>;
+
+/** Cached index of the sprite section of a GRF file. */
+struct GrfSpriteOffsetCacheEntry {
+	uint64_t file_size = 0;        ///< Size of the file on disk.
+	int64_t modification_time = 0; ///< Modification time of the file on disk.
+	uint64_t end_pos = 0;          ///< End position of the GRF file in the file on disk.
+	uint32_t data_offset = 0;      ///< Offset of the sprite section, relative to the end of the offset field.
+	std::vector<std::pair<uint32_t, GrfSpriteOffset>> offsets; ///< Contents of #_grf_sprite_offsets for this file.
+	bool used = false;             ///< Whether this entry was used or updated in this session.
+};
+
+std::string _grf_sprite_offset_cache_file; ///< File to store the sprite section indices of GRF files in, between sessions.
+static constexpr uint32_t GRF_SPRITE_OFFSET_CACHE_MAGIC = 0x4F535247; ///< Magic at the start of the sprite section index cache ("GRSO").
+static constexpr uint32_t GRF_SPRITE_OFFSET_CACHE_VERSION = 2;      ///< Version of the format of the sprite section index cache.
+
+/** Sprite section indices of GRF files, by location on disk. */
+static std::map<GrfSpriteOffsetCacheKey, GrfSpriteOffsetCacheEntry> _grf_sprite_offset_cache;
+static bool _grf_sprite_offset_cache_loaded = false;
+static bool _grf_sprite_offset_cache_dirty = false;
+static std::mutex _grf_sprite_offset_cache_mutex; ///< Guards the sprite section index cache against concurrent access.
+
+/**
+ * Load the sprite section index cache from disk, if not already loaded.
+ * Any error while loading results in an empty cache, such that all indices are rebuilt from the GRF files.
+ */
+static void LoadGRFSpriteOffsetCache()
+{
+	if (_grf_sprite_offset_cache_loaded) return;
+	_grf_sprite_offset_cache_loaded = true;
+	if (_grf_sprite_offset_cache_file.empty()) return;
+
+	size_t size;
+	auto f = FioFOpenFile(_grf_sprite_offset_cache_file, "rb", Subdirectory::None, &size);
+	if (!f.has_value()) return;
+
+	std::vector<uint8_t> data(size);
+	if (fread(data.data(), 1, size, *f) != size) return;
+
+	DeserialisationBuffer buffer(data.data(), data.size());
+	if (buffer.Recv_uint32() != GRF_SPRITE_OFFSET_CACHE_MAGIC || buffer.Recv_uint32() != GRF_SPRITE_OFFSET_CACHE_VERSION) return;
+
+	uint64_t count = buffer.Recv_varuint();
+	for (uint64_t i = 0; i < count && !buffer.error; i++) {
+		GrfSpriteOffsetCacheKey key;
+		buffer.Recv_string(key.first, StringValidationSetting::ReplaceWithQuestionMark);
+		key.second = buffer.Recv_uint64();
+		GrfSpriteOffsetCacheEntry &entry = _grf_sprite_offset_cache[key];
+		entry.file_size = buffer.Recv_uint64();
+		entry.modification_time = static_cast<int64_t>(buffer.Recv_uint64());
+		entry.end_pos = buffer.Recv_uint64();
+		entry.data_offset = buffer.Recv_uint32();
+		uint64_t offset_count = buffer.Recv_varuint();
+		if (!buffer.CanRecvBytes(offset_count * 18, true)) break;
+		entry.offsets.resize(offset_count);
+		for (auto &[id, offset] : entry.offsets) {
+			id = buffer.Recv_uint32();
+			offset.file_pos = static_cast<size_t>(buffer.Recv_uint64());
+			offset.count = buffer.Recv_uint32();
+			offset.control_flags = buffer.Recv_uint16();
+		}
+	}
+
+	if (buffer.error) {
+		Debug(sprite, 1, "GRF sprite section index cache is invalid, ignoring it");
+		_grf_sprite_offset_cache.clear();
+	}
+}
+
+/**
+ * Get the size and modification time of a file.
+ * @param path Full path of the file.
+ * @return Pair of the size and the modification time, or std::nullopt if the file could not be accessed.
+ */
+static std::optional<std::pair<uint64_t, int64_t>> GetGRFSpriteOffsetCacheFileStats(const std::string &path)
+{
+	std::error_code ec;
+	std::filesystem::path fs_path(OTTD2FS(path));
+	uint64_t size = std::filesystem::file_size(fs_path, ec);
+	if (ec) return std::nullopt;
+	auto mtime = std::filesystem::last_write_time(fs_path, ec);
+	if (ec) return std::nullopt;
+	return std::make_pair(size, static_cast<int64_t>(mtime.time_since_epoch().count()));
+}
+
+/**
+ * Save the sprite section index cache to disk, if it has changed.
+ * Entries which were not used in this session, and whose files no longer exist or have changed, are dropped.
+ * The cache is written to a temporary file first, such that an interrupted save can not leave a truncated cache behind.
+ */
+void SaveGRFSpriteOffsetCache()
+{
+	std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+	if (!_grf_sprite_offset_cache_dirty || _grf_sprite_offset_cache_file.empty()) return;
+	_grf_sprite_offset_cache_dirty = false;
+
+	std::vector<uint8_t> data;
+	BufferSerialisationRef buffer(data);
+	buffer.Send_uint32(GRF_SPRITE_OFFSET_CACHE_MAGIC);
+	buffer.Send_uint32(GRF_SPRITE_OFFSET_CACHE_VERSION);
+
+	std::vector<std::pair<const GrfSpriteOffsetCacheKey *, const GrfSpriteOffsetCacheEntry *>> entries;
+	for (const auto &[key, entry] : _grf_sprite_offset_cache) {
+		if (!entry.used) {
+			auto stats = GetGRFSpriteOffsetCacheFileStats(key.first);
+			if (!stats.has_value() || stats->first != entry.file_size || stats->second != entry.modification_time) continue;
+		}
+		entries.emplace_back(&key, &entry);
+	}
+
+	buffer.Send_varuint(entries.size());
+	for (const auto &[key, entry] : entries) {
+		buffer.Send_string(key->first);
+		buffer.Send_uint64(key->second);
+		buffer.Send_uint64(entry->file_size);
+		buffer.Send_uint64(static_cast<uint64_t>(entry->modification_time));
+		buffer.Send_uint64(entry->end_pos);
+		buffer.Send_uint32(entry->data_offset);
+		buffer.Send_varuint(entry->offsets.size());
+		for (const auto &[id, offset] : entry->offsets) {
+			buffer.Send_uint32(id);
+			buffer.Send_uint64(offset.file_pos);
+			buffer.Send_uint32(offset.count);
+			buffer.Send_uint16(offset.control_flags);
+		}
+	}
+
+	std::string temp_filename = _grf_sprite_offset_cache_file + ".tmp";
+	bool ok;
+	{
+		auto f = FileHandle::Open(temp_filename, "wb");
+		ok = f.has_value() && fwrite(data.data(), 1, data.size(), *f) == data.size() && fflush(*f) == 0;
+	}
+	if (ok) ok = FioRenameFile(temp_filename, _grf_sprite_offset_cache_file);
+	if (!ok) {
+		Debug(sprite, 1, "Could not save GRF sprite section index cache to: {}", _grf_sprite_offset_cache_file);
+		FioRemove(temp_filename);
+	}
+}
+
+/**
+ * Get the sprite section index cache key, and the size and modification time of the file on disk, of a GRF file.
+ * For files inside a tar, the size and modification time of the tar file are used for validation.
+ * @param file The file.
+ * @param[out] stats The size and modification time of the file on disk.
+ * @return The cache key, or std::nullopt if the file can't be cached.
+ */
+static std::optional<GrfSpriteOffsetCacheKey> GetGRFSpriteOffsetCacheKey(SpriteFile &file, std::pair<uint64_t, int64_t> &stats)
+{
+	const std::string &path = file.GetDiskFilename();
+	if (path.empty()) return std::nullopt;
+
+	auto file_stats = GetGRFSpriteOffsetCacheFileStats(path);
+	if (!file_stats.has_value() || file_stats->first < file.GetEndPos()) return std::nullopt;
+	stats = *file_stats;
+	return GrfSpriteOffsetCacheKey{ path, file.GetStartPos() };
+}
+
+/**
+ * Check whether a sprite section index cache entry is valid for a file.
+ * @param entry The cache entry.
+ * @param file The file, positioned just after the sprite section offset field.
+ * @param stats The size and modification time of the file on disk.
+ * @param data_offset The sprite section offset.
+ * @return True if the entry is valid.
+ */
+static bool IsGRFSpriteOffsetCacheEntryValid(const GrfSpriteOffsetCacheEntry &entry, SpriteFile &file, const std::pair<uint64_t, int64_t> &stats, size_t data_offset)
+{
+	if (entry.file_size != stats.first || entry.modification_time != stats.second || entry.end_pos != file.GetEndPos() || entry.data_offset != data_offset) return false;
+
+	/* Check that the first sprite in the sprite section is where the cache expects it to be. */
+	size_t old_pos = file.GetPos();
+	file.SeekTo(data_offset, SEEK_CUR);
+	size_t first_pos = file.GetPos();
+	uint32_t first_id = file.ReadDword();
+	file.SeekTo(old_pos, SEEK_SET);
+
+	if (entry.offsets.empty()) return first_id == 0;
+	return entry.offsets.front().second.file_pos == first_pos && entry.offsets.front().first == first_id;
+}
+
+/**
+ * Scan the sprite section of a GRF file.
+ * @param file The file, positioned just after the sprite section offset field. The position is restored afterwards.
+ * @param data_offset The sprite section offset.
+ * @return The first file offset of each run of sprite section entries with the same ID, in file order.
+ */
+static std::vector<std::pair<uint32_t, GrfSpriteOffset>> ScanGRFSpriteSection(SpriteFile &file, size_t data_offset)
+{
+	size_t old_pos = file.GetPos();
+	file.SeekTo(data_offset, SEEK_CUR);
+
+	std::vector<std::pair<uint32_t, GrfSpriteOffset>> offsets;
+	GrfSpriteOffset offset = { 0, 0, 0 };
+
+	/* Loop over all sprite section entries and store the file
+	 * offset for each newly encountered ID. */
+	SpriteID id, prev_id = 0;
+	while ((id = file.ReadDword()) != 0) {
+		if (id != prev_id) {
+			if (prev_id != 0) offsets.emplace_back(prev_id, offset);
+			offset.file_pos = file.GetPos() - 4;
+			offset.count = 0;
+			offset.control_flags = 0;
+		}
+		offset.count++;
+		prev_id = id;
+		uint length = file.ReadDword();
+		if (length > 0) {
+			SpriteComponents colour{file.ReadByte()};
+			length--;
+			if (length > 0) {
+				uint8_t zoom = file.ReadByte();
+				length--;
+				if (colour.Any()) {
+					static const ZoomLevel zoom_lvl_map[6] = {ZoomLevel::Normal, ZoomLevel::In4x, ZoomLevel::In2x, ZoomLevel::Out2x, ZoomLevel::Out4x, ZoomLevel::Out8x};
+					if (zoom < 6) SetBit(offset.control_flags, static_cast<uint>(zoom_lvl_map[zoom]) + static_cast<uint>((colour != SpriteComponent::Palette) ? SCC_32BPP_ZOOM_START : SCC_PAL_ZOOM_START));
+				}
+			}
+		}
+		file.SkipBytes(length);
+	}
+	if (prev_id != 0) offsets.emplace_back(prev_id, offset);
+
+	/* Continue processing the data section. */
+	file.SeekTo(old_pos, SEEK_SET);
+	return offsets;
+}
+
+/**
+ * Store a scanned sprite section index in the cache.
+ * @param key The cache key of the file.
+ * @param stats The size and modification time of the file on disk.
+ * @param end_pos The end position of the GRF file in the file on disk.
+ * @param data_offset The sprite section offset.
+ * @param offsets The scanned index.
+ */
+static void StoreGRFSpriteOffsetCacheEntry(const GrfSpriteOffsetCacheKey &key, const std::pair<uint64_t, int64_t> &stats, size_t end_pos, size_t data_offset, std::vector<std::pair<uint32_t, GrfSpriteOffset>> offsets)
+{
+	GrfSpriteOffsetCacheEntry &entry = _grf_sprite_offset_cache[key];
+	entry.file_size = stats.first;
+	entry.modification_time = stats.second;
+	entry.end_pos = end_pos;
+	entry.data_offset = static_cast<uint32_t>(data_offset);
+	entry.offsets = std::move(offsets);
+	entry.used = true;
+	_grf_sprite_offset_cache_dirty = true;
+}
+
 /**
  * Parse the sprite section of GRFs.
+ * The parsed sprite section index is cached, in memory and on disk, such that the sprite section does not need
+ * to be scanned again for each loading stage and on each start.
  * @param file The file to read the sprite offsets for.
  */
 void ReadGRFSpriteOffsets(SpriteFile &file)
@@ -645,45 +916,77 @@ void ReadGRFSpriteOffsets(SpriteFile &file)
 	if (file.GetContainerVersion() >= 2) {
 		/* Seek to sprite section of the GRF. */
 		size_t data_offset = file.ReadDword();
-		size_t old_pos = file.GetPos();
-		file.SeekTo(data_offset, SEEK_CUR);
-
-		GrfSpriteOffset offset = { 0, 0, 0 };
-
-		/* Loop over all sprite section entries and store the file
-		 * offset for each newly encountered ID. */
-		SpriteID id, prev_id = 0;
-		while ((id = file.ReadDword()) != 0) {
-			if (id != prev_id) {
-				_grf_sprite_offsets[prev_id] = offset;
-				offset.file_pos = file.GetPos() - 4;
-				offset.count = 0;
-				offset.control_flags = 0;
+
+		auto fill = [&](const std::vector<std::pair<uint32_t, GrfSpriteOffset>> &offsets) {
+			/* Later entries for an ID replace earlier ones. */
+			_grf_sprite_offsets.reserve(offsets.size());
+			for (const auto &[id, offset] : offsets) {
+				_grf_sprite_offsets[id] = offset;
 			}
-			offset.count++;
-			prev_id = id;
-			uint length = file.ReadDword();
-			if (length > 0) {
-				SpriteComponents colour{file.ReadByte()};
-				length--;
-				if (length > 0) {
-					uint8_t zoom = file.ReadByte();
-					length--;
-					if (colour.Any()) {
-						static const ZoomLevel zoom_lvl_map[6] = {ZoomLevel::Normal, ZoomLevel::In4x, ZoomLevel::In2x, ZoomLevel::Out2x, ZoomLevel::Out4x, ZoomLevel::Out8x};
-						if (zoom < 6) SetBit(offset.control_flags, static_cast<uint>(zoom_lvl_map[zoom]) + static_cast<uint>((colour != SpriteComponent::Palette) ? SCC_32BPP_ZOOM_START : SCC_PAL_ZOOM_START));
-					}
-				}
+		};
+
+		std::pair<uint64_t, int64_t> stats;
+		std::optional<GrfSpriteOffsetCacheKey> key = GetGRFSpriteOffsetCacheKey(file, stats);
+		if (key.has_value()) {
+			std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+			LoadGRFSpriteOffsetCache();
+			auto iter = _grf_sprite_offset_cache.find(*key);
+			if (iter != _grf_sprite_offset_cache.end() && IsGRFSpriteOffsetCacheEntryValid(iter->second, file, stats, data_offset)) {
+				fill(iter->second.offsets);
+				iter->second.used = true;
+				return;
 			}
-			file.SkipBytes(length);
 		}
-		if (prev_id != 0) _grf_sprite_offsets[prev_id] = offset;
 
-		/* Continue processing the data section. */
-		file.SeekTo(old_pos, SEEK_SET);
+		std::vector<std::pair<uint32_t, GrfSpriteOffset>> offsets = ScanGRFSpriteSection(file, data_offset);
+		fill(offsets);
+
+		if (key.has_value()) {
+			std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+			StoreGRFSpriteOffsetCacheEntry(*key, stats, file.GetEndPos(), data_offset, std::move(offsets));
+		}
 	}
 }
 
+/**
+ * Scan the sprite sections of several GRF files on the worker threads, and store them in the sprite section index cache.
+ * Subsequent calls to #ReadGRFSpriteOffsets for these files then do not need to scan them.
+ * @param files Filename and subdirectory of each GRF file.
+ */
+void PrefetchGRFSpriteOffsets(std::span<const std::pair<std::string, Subdirectory>> files)
+{
+	if (_general_worker_pool.GetWorkerCount() == 0 || files.size() < 2) return;
+
+	{
+		std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+		LoadGRFSpriteOffsetCache();
+	}
+
+	_general_worker_pool.ParallelFor(static_cast<uint>(files.size()), [&](uint i) {
+		const auto &[filename, subdir] = files[i];
+		if (!FioCheckFileExists(filename, subdir)) return;
+
+		SpriteFile file(filename, subdir, false);
+		if (file.GetContainerVersion() < 2) return;
+		size_t data_offset = file.ReadDword();
+
+		std::pair<uint64_t, int64_t> stats;
+		std::optional<GrfSpriteOffsetCacheKey> key = GetGRFSpriteOffsetCacheKey(file, stats);
+		if (!key.has_value()) return;
+
+		{
+			std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+			auto iter = _grf_sprite_offset_cache.find(*key);
+			if (iter != _grf_sprite_offset_cache.end() && IsGRFSpriteOffsetCacheEntryValid(iter->second, file, stats, data_offset)) return;
+		}
+
+		std::vector<std::pair<uint32_t, GrfSpriteOffset>> offsets = ScanGRFSpriteSection(file, data_offset);
+
+		std::lock_guard<std::mutex> lock(_grf_sprite_offset_cache_mutex);
+		StoreGRFSpriteOffsetCacheEntry(*key, stats, file.GetEndPos(), data_offset, std::move(offsets));
+	});
+}
+
 
 /**
  * Load a real or recolour sprite.
@@ -1034,6 +1337,252 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, LowZoomLevels zoom_levels,
 	}
 }
 
+/** Spare handles of sprite files, so that worker threads can read from the same sprite file concurrently. */
+static robin_hood::unordered_map<const SpriteFile *, std::vector<std::unique_ptr<SpriteFile>>> _spare_sprite_file_handles;
+static std::mutex _spare_sprite_file_handles_mutex;
+
+/**
+ * Get a handle of a sprite file for exclusive use by the calling thread.
+ * @param file The sprite file.
+ * @return A separate handle of the same file, return it with #ReleaseSpriteFileHandle.
+ */
+static std::unique_ptr<SpriteFile> AcquireSpriteFileHandle(const SpriteFile &file)
+{
+	{
+		std::lock_guard<std::mutex> lock(_spare_sprite_file_handles_mutex);
+		std::vector<std::unique_ptr<SpriteFile>> &handles = _spare_sprite_file_handles[&file];
+		if (!handles.empty()) {
+			std::unique_ptr<SpriteFile> handle = std::move(handles.back());
+			handles.pop_back();
+			return handle;
+		}
+	}
+
+	std::unique_ptr<SpriteFile> handle = std::make_unique<SpriteFile>(file.GetFilename(), file.GetSubdirectory(), file.NeedsPaletteRemap());
+	handle->flags = file.flags;
+	return handle;
+}
+
+/**
+ * Return a handle of a sprite file acquired by #AcquireSpriteFileHandle.
+ * @param file The sprite file.
+ * @param handle The handle to return.
+ */
+static void ReleaseSpriteFileHandle(const SpriteFile &file, std::unique_ptr<SpriteFile> handle)
+{
+	std::lock_guard<std::mutex> lock(_spare_sprite_file_handles_mutex);
+	_spare_sprite_file_handles[&file].push_back(std::move(handle));
+}
+
+/**
+ * Load normal sprites which are not yet in the sprite cache, decoding them in parallel on the general worker pool.
+ * Reading and encoding the sprites is done by the workers, the sprite cache itself is only modified by the main thread.
+ * This is only an optimisation, any sprites not loaded by this are loaded by #GetRawSprite when they are used.
+ * @param sprites Sprites to load, this may contain duplicates and sprites which are not normal sprites.
+ * @param zoom_levels Zoom levels to load.
+ */
+void PrefetchSprites(std::span<const SpriteID> sprites, LowZoomLevels zoom_levels)
+{
+	assert(IsMainThread());
+
+	struct PrefetchJob {
+		SpriteID id;
+		LowZoomLevels zoom_levels;    ///< Zoom levels to load.
+		bool append;                  ///< Whether the sprite cache entry already has data for other zoom levels.
+		SpriteDataBuffer data{};      ///< Loaded data, or empty if the sprite could not be loaded by the worker.
+	};
+	std::vector<PrefetchJob> jobs;
+
+	for (SpriteID sprite : sprites) {
+		if (!SpriteExists(sprite)) continue;
+		SpriteCache *sc = GetSpriteCache(sprite);
+		if (sc->GetType() != SpriteType::Normal || sc->file == nullptr) continue;
+
+		if (sc->GetPtr() == nullptr) {
+			jobs.push_back({ sprite, zoom_levels, false });
+		} else if ((sc->total_missing_zoom_levels & zoom_levels).Any()) {
+			jobs.push_back({ sprite, sc->total_missing_zoom_levels & zoom_levels, true });
+		}
+	}
+
+	/* Loading a few sprites on the main thread as they are used is cheaper than handing them to the workers. */
+	if (jobs.size() < SPRITE_PREFETCH_MIN_SPRITES || _general_worker_pool.GetWorkerCount() == 0) return;
+
+	std::sort(jobs.begin(), jobs.end(), [](const PrefetchJob &a, const PrefetchJob &b) { return a.id < b.id; });
+	jobs.erase(std::unique(jobs.begin(), jobs.end(), [](const PrefetchJob &a, const PrefetchJob &b) { return a.id == b.id; }), jobs.end());
+
+	_general_worker_pool.ParallelFor((uint)jobs.size(), [&](uint i) {
+		PrefetchJob &job = jobs[i];
+		const SpriteCache *sc = GetSpriteCache(job.id);
+
+		std::unique_ptr<SpriteFile> handle = AcquireSpriteFileHandle(*sc->file);
+		CacheSpriteAllocator cache_allocator;
+		if (ReadSprite(sc, job.id, SpriteType::Normal, cache_allocator, nullptr, job.zoom_levels, handle.get()) != nullptr) {
+			job.data = std::move(cache_allocator.last_sprite_allocation);
+		}
+		ReleaseSpriteFileHandle(*sc->file, std::move(handle));
+	});
+
+	for (PrefetchJob &job : jobs) {
+		if (job.data.GetPtr() == nullptr) continue;
+
+		SpriteCache *sc = GetSpriteCache(job.id);
+		if (job.append) {
+			sc->Append(std::move(job.data));
+		} else {
+			sc->Assign(std::move(job.data));
+		}
+	}
+}
+
+/**
+ * Background loader of sprites into the sprite cache, see #StartSpriteCachePreload.
+ * The sprites are read and encoded by a low priority thread, the sprite cache itself is only modified by the main thread in #UpdateSpriteCachePreload.
+ */
+struct SpriteCachePreloader {
+	/** A sprite to load. The sprite cache entry is copied, as the entries are not accessed by the preload thread. */
+	struct Job {
+		SpriteID id;
+		SpriteFile *file;
+		size_t file_pos;
+		uint count;
+		uint16_t flags;
+	};
+
+	static constexpr size_t MAX_PENDING_RESULTS = 256; ///< Maximum number of loaded sprites waiting to be inserted into the sprite cache.
+
+	std::vector<Job> jobs;                                      ///< Sprites to load, in order.
+	LowZoomLevels zoom_levels;                                  ///< Zoom levels to load.
+	std::thread thread;                                         ///< The preload thread.
+	std::mutex lock;                                            ///< Lock for the members below.
+	std::condition_variable results_consumed;                   ///< Signalled when #results has been emptied or the thread should stop.
+	std::vector<std::pair<SpriteID, SpriteDataBuffer>> results; ///< Loaded sprites not yet inserted into the sprite cache.
+	bool stop = false;                                          ///< Whether the thread should stop.
+	bool done = false;                                          ///< Whether the thread has loaded all sprites.
+	uint inserted = 0;                                          ///< Number of sprites inserted into the sprite cache, only used by the main thread.
+
+	~SpriteCachePreloader()
+	{
+		{
+			std::lock_guard<std::mutex> guard(this->lock);
+			this->stop = true;
+		}
+		this->results_consumed.notify_one();
+		if (this->thread.joinable()) this->thread.join();
+	}
+
+	static void Run(SpriteCachePreloader *self);
+};
+
+static std::unique_ptr<SpriteCachePreloader> _sprite_cache_preloader;
+
+/**
+ * Main function of the preload thread.
+ * @param self The preloader.
+ */
+void SpriteCachePreloader::Run(SpriteCachePreloader *self)
+{
+	SetCurrentThreadLowPriority();
+
+	for (const Job &job : self->jobs) {
+		{
+			std::unique_lock<std::mutex> guard(self->lock);
+			self->results_consumed.wait(guard, [&]() { return self->stop || self->results.size() < MAX_PENDING_RESULTS; });
+			if (self->stop) return;
+		}
+
+		SpriteCache entry{};
+		entry.file = job.file;
+		entry.file_pos = job.file_pos;
+		entry.count = job.count;
+		entry.flags = job.flags;
+		entry.SetType(SpriteType::Normal);
+
+		std::unique_ptr<SpriteFile> handle = AcquireSpriteFileHandle(*job.file);
+		CacheSpriteAllocator cache_allocator;
+		if (ReadSprite(&entry, job.id, SpriteType::Normal, cache_allocator, nullptr, self->zoom_levels, handle.get()) != nullptr) {
+			std::lock_guard<std::mutex> guard(self->lock);
+			self->results.emplace_back(job.id, std::move(cache_allocator.last_sprite_allocation));
+		}
+		ReleaseSpriteFileHandle(*job.file, std::move(handle));
+	}
+
+	std::lock_guard<std::mutex> guard(self->lock);
+	self->done = true;
+}
+
+/**
+ * Start loading the normal sprites of the base set and the active NewGRFs into the sprite cache in the background, at the default zoom level.
+ * This warms the sprite cache so that the first frames drawn after loading do not have to read the sprites.
+ * Loading stops when the sprite cache is filled up to #SPRITE_PRELOAD_CACHE_PERCENT of its target size.
+ */
+void StartSpriteCachePreload()
+{
+	assert(IsMainThread());
+
+	StopSpriteCachePreload();
+	if (!_sprite_cache_preload || BlitterFactory::GetCurrentBlitter()->NoSpriteDataRequired()) return;
+
+	std::unique_ptr<SpriteCachePreloader> preloader = std::make_unique<SpriteCachePreloader>();
+	preloader->zoom_levels = LowZoomMask(ZoomLevel::Normal);
+	for (SpriteID i = 0; i != _spritecache.size(); i++) {
+		const SpriteCache *sc = GetSpriteCache(i);
+		if (sc->GetType() != SpriteType::Normal || sc->file == nullptr || sc->GetPtr() != nullptr) continue;
+		preloader->jobs.push_back({ i, sc->file, sc->file_pos, sc->count, sc->flags });
+	}
+	if (preloader->jobs.empty()) return;
+
+	if (!StartNewThread(&preloader->thread, "ottd:sprpreload", &SpriteCachePreloader::Run, preloader.get())) return;
+
+	Debug(sprite, 2, "Started preloading {} sprites into the sprite cache", preloader->jobs.size());
+	_sprite_cache_preloader = std::move(preloader);
+}
+
+/**
+ * Stop loading sprites in the background, discarding any sprites not yet inserted into the sprite cache.
+ */
+void StopSpriteCachePreload()
+{
+	if (_sprite_cache_preloader == nullptr) return;
+
+	Debug(sprite, 2, "Stopped preloading sprites into the sprite cache, {} sprites inserted", _sprite_cache_preloader->inserted);
+	_sprite_cache_preloader.reset();
+}
+
+/**
+ * Insert the sprites loaded in the background into the sprite cache.
+ * Stops the background loading when it is done, or when the sprite cache is filled far enough.
+ */
+void UpdateSpriteCachePreload()
+{
+	SpriteCachePreloader *preloader = _sprite_cache_preloader.get();
+	if (preloader == nullptr) return;
+
+	std::vector<std::pair<SpriteID, SpriteDataBuffer>> results;
+	bool done;
+	{
+		std::lock_guard<std::mutex> guard(preloader->lock);
+		results.swap(preloader->results);
+		done = preloader->done;
+	}
+	preloader->results_consumed.notify_one();
+
+	for (auto &[id, data] : results) {
+		/* Skip sprites which have been loaded in the mean time because they were used. */
+		SpriteCache *sc = GetSpriteCache(id);
+		if (sc->GetPtr() != nullptr) continue;
+
+		/* Preloaded sprites have not been used yet, so they are the first to be removed when the cache is full. */
+		static_cast<Sprite *>(data.GetPtr())->lru = 0;
+		sc->Assign(std::move(data));
+		preloader->inserted++;
+	}
+
+	if (done || _spritecache_bytes_used >= (size_t)GetTargetSpriteSize() * SPRITE_PRELOAD_CACHE_PERCENT / 100) {
+		StopSpriteCachePreload();
+	}
+}
+
 #if !defined(DEDICATED)
 /**
  * Reads a sprite and finds its most representative colour.
@@ -1154,8 +1703,11 @@ uint32_t GetSpriteMainColour(SpriteID sprite_id, PaletteID palette_id)
 
 void GfxInitSpriteMem()
 {
+	StopSpriteCachePreload();
+
 	/* Reset the spritecache 'pool' */
 	_spritecache.clear();
+	_spare_sprite_file_handles.clear();
 	_sprite_files.clear();
 	_recolour_cache.Clear();
 	assert(_spritecache_bytes_used == 0);
@@ -1170,6 +1722,9 @@ void GfxInitSpriteMem()
  */
 void GfxClearSpriteCache()
 {
+	/* Sprites being loaded in the background may be encoded for a different blitter or zoom settings. */
+	StopSpriteCachePreload();
+
 	/* Clear sprite ptr for all cached items */
 	for (uint i = 0; i != _spritecache.size(); i++) {
 		SpriteCache *sc = GetSpriteCache(i);
@@ -1245,4 +1800,4 @@ void DumpSpriteCacheStats(format_target &buffer)
 	}
 }
 
-/* static */ SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> SpriteLoader::Sprite::buffer;
+/* static */ thread_local SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> SpriteLoader::Sprite::buffer;
@@ -39,6 +39,7 @@ enum SpriteCacheCtrlFlags {
 };
 
 extern uint _sprite_cache_size;
+extern bool _sprite_cache_preload;
 
 /** SpriteAllocator that allocates memory via a unique_ptr array. */
 class UniquePtrSpriteAllocator : public SpriteAllocator {
@@ -50,6 +51,10 @@ protected:
 
 void *GetRawSprite(SpriteID sprite, SpriteType type, LowZoomLevels zoom_levels, SpriteAllocator *allocator = nullptr, SpriteEncoder *encoder = nullptr);
 bool SpriteExists(SpriteID sprite);
+void PrefetchSprites(std::span<const SpriteID> sprites, LowZoomLevels zoom_levels);
+void StartSpriteCachePreload();
+void StopSpriteCachePreload();
+void UpdateSpriteCachePreload();
 
 SpriteType GetSpriteType(SpriteID sprite);
 SpriteFile *GetOriginFile(SpriteID sprite);
@@ -79,6 +84,8 @@ SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdi
 std::span<const std::unique_ptr<SpriteFile>> GetCachedSpriteFiles();
 
 void ReadGRFSpriteOffsets(SpriteFile &file);
+void SaveGRFSpriteOffsetCache();
+void PrefetchGRFSpriteOffsets(std::span<const std::pair<std::string, Subdirectory>> files);
 size_t GetGRFSpriteOffset(uint32_t id);
 bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id);
 bool SkipSpriteData(SpriteFile &file, uint8_t type, uint16_t num);
@@ -14,8 +14,11 @@
 #include "../strings_func.h"
 #include "../error.h"
 #include "../spritecache.h"
+#include "../thread.h"
 #include "grf.hpp"
 
+#include <atomic>
+
 #include "table/strings.h"
 
 #include "../safeguards.h"
@@ -32,12 +35,18 @@ extern const uint8_t _palmap_w2d[];
  */
 static bool WarnCorruptSprite(const SpriteFile &file, size_t file_pos, int line)
 {
-	static uint8_t warning_level = 0;
-	if (warning_level == 0) {
+	/* Sprites are also loaded by worker threads, which cannot show the error message.
+	 * Leave that to the main thread, which loads the sprite again when it is needed. */
+	static std::atomic<uint8_t> warning_level = 0;
+	if (!IsMainThread()) {
+		Debug(sprite, warning_level.load(std::memory_order_relaxed), "[{}] Loading corrupted sprite from {} at position {}", line, file.GetSimplifiedFilename(), file_pos);
+		return false;
+	}
+	if (warning_level.load(std::memory_order_relaxed) == 0) {
 		ShowErrorMessage(GetEncodedString(STR_NEWGRF_ERROR_CORRUPT_SPRITE, file.GetSimplifiedFilename()), {}, WarningLevel::Error);
 	}
-	Debug(sprite, warning_level, "[{}] Loading corrupted sprite from {} at position {}", line, file.GetSimplifiedFilename(), file_pos);
-	warning_level = 6;
+	Debug(sprite, warning_level.load(std::memory_order_relaxed), "[{}] Loading corrupted sprite from {} at position {}", line, file.GetSimplifiedFilename(), file_pos);
+	warning_level.store(6, std::memory_order_relaxed);
 	return false;
 }
 
@@ -180,9 +189,8 @@ bool DecodeSingleSprite(SpriteLoader::Sprite *sprite, SpriteFile &file, size_t f
 		}
 
 		if (dest_size > sprite_size) {
-			static uint8_t warning_level = 0;
-			Debug(sprite, warning_level, "Ignoring {} unused extra bytes from the sprite from {} at position {}", dest_size - sprite_size, file.GetSimplifiedFilename(), file_pos);
-			warning_level = 6;
+			static std::atomic<uint8_t> warning_level = 0;
+			Debug(sprite, warning_level.exchange(6, std::memory_order_relaxed), "Ignoring {} unused extra bytes from the sprite from {} at position {}", dest_size - sprite_size, file.GetSimplifiedFilename(), file_pos);
 		}
 
 		dest = dest_orig.get();
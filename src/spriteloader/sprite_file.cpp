@@ -13,6 +13,8 @@
 
 #include <array>
 
+bool _sprite_file_mmap = false; ///< Whether sprite files are memory mapped when possible.
+
 /** Signature of a container version 2 GRF. */
 extern const std::array<uint8_t, 8> _grf_cont_v2_sig = {'G', 'R', 'F', 0x82, 0x0D, 0x0A, 0x1A, 0x0A};
 
@@ -47,8 +49,9 @@ static uint8_t GetGRFContainerVersion(SpriteFile &file)
  * @param palette_remap Whether a palette remap needs to be performed for this file.
  */
 SpriteFile::SpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap)
-	: RandomAccessFile(filename, subdir), palette_remap(palette_remap)
+	: RandomAccessFile(filename, subdir), palette_remap(palette_remap), subdir(subdir)
 {
+	if (_sprite_file_mmap) this->MapIntoMemory();
 	this->container_version = GetGRFContainerVersion(*this);
 	this->content_begin = this->GetPos();
 }
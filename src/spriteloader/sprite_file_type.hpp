@@ -21,6 +21,8 @@ enum SpriteFileFlags : uint8_t {
 };
 DECLARE_ENUM_AS_BIT_SET(SpriteFileFlags)
 
+extern bool _sprite_file_mmap;
+
 /**
  * RandomAccessFile with some extra information specific for sprite files.
  * It automatically detects and stores the container version upload opening the file.
@@ -28,6 +30,7 @@ DECLARE_ENUM_AS_BIT_SET(SpriteFileFlags)
 class SpriteFile : public RandomAccessFile {
 	size_t content_begin;   ///< The begin of the content of the sprite file, i.e. after the container metadata.
 	bool palette_remap;     ///< Whether or not a remap of the palette is required for this file.
+	Subdirectory subdir;    ///< The sub directory the file was opened from.
 	uint8_t container_version; ///< Container format of the sprite file.
 
 public:
@@ -43,6 +46,12 @@ public:
 	 */
 	bool NeedsPaletteRemap() const { return this->palette_remap; }
 
+	/**
+	 * Get the sub directory the file was opened from.
+	 * @return The sub directory.
+	 */
+	Subdirectory GetSubdirectory() const { return this->subdir; }
+
 	/**
 	 * Get the version number of container type used by the file.
 	 * @return The version.
@@ -87,8 +87,8 @@ public:
 		 */
 		void AllocateData(ZoomLevel zoom, size_t size) { this->data = Sprite::buffer[zoom].ZeroAllocate(size); }
 	private:
-		/** Allocated memory to pass sprite data around */
-		static SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> buffer;
+		/** Allocated memory to pass sprite data around, per thread as sprites may be decoded on worker threads. */
+		static thread_local SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> buffer;
 	};
 
 	/**
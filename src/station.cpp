@@ -30,6 +30,7 @@
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/linkgraphschedule.h"
 #include "tracerestrict.h"
+#include "worker_thread.h"
 #include "newgrf_debug.h"
 #include "3rdparty/cpp-btree/btree_set.h"
 #include "3rdparty/robin_hood/robin_hood.h"
@@ -534,6 +535,20 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 		return;
 	}
 
+	std::vector<Town *> towns;
+	std::vector<Industry *> industries;
+	this->ComputeCatchment(towns, industries);
+	this->AddToNearbyLists(towns, industries);
+}
+
+/**
+ * Compute the tiles covered in our catchment area, and the industries we can deliver to, when we are not associated
+ * with a neutral industry. This only changes this station, so it can be done for multiple stations concurrently.
+ * @param[out] towns The towns with houses in the catchment area, the same town may occur multiple times.
+ * @param[out] industries The industries in the catchment area, the same industry may occur multiple times.
+ */
+void Station::ComputeCatchment(std::vector<Town *> &towns, std::vector<Industry *> &industries)
+{
 	this->catchment_tiles.Initialize(GetCatchmentRect());
 
 	/* Loop finding all station tiles */
@@ -557,7 +572,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 	for (TileIndex tile = it; tile != INVALID_TILE; tile = ++it) {
 		if (IsTileType(tile, TileType::House)) {
 			Town *t = Town::GetByTile(tile);
-			t->stations_near.insert(this);
+			if (towns.empty() || towns.back() != t) towns.push_back(t);
 		}
 		if (IsTileType(tile, TileType::Industry)) {
 			Industry *i = Industry::GetByTile(tile);
@@ -565,7 +580,7 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 			/* Ignore industry if it has a neutral station. It already can't be this station. */
 			if (!_settings_game.station.serve_neutral_industries && i->neutral_station != nullptr) continue;
 
-			i->stations_near.insert(this);
+			if (industries.empty() || industries.back() != i) industries.push_back(i);
 
 			/* Add if we can deliver to this industry as well */
 			this->AddIndustryToDeliver(i, tile);
@@ -573,6 +588,17 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 	}
 }
 
+/**
+ * Add this station to the nearby lists of the towns and industries in its catchment area.
+ * @param towns The towns with houses in the catchment area.
+ * @param industries The industries in the catchment area.
+ */
+void Station::AddToNearbyLists(std::span<Town * const> towns, std::span<Industry * const> industries)
+{
+	for (Town *t : towns) t->stations_near.insert(this);
+	for (Industry *i : industries) i->stations_near.insert(this);
+}
+
 /**
  * Recomputes catchment of all stations.
  * This will additionally recompute nearby stations for all towns and industries.
@@ -581,7 +607,36 @@ void Station::RecomputeCatchment(bool no_clear_nearby_lists)
 {
 	for (Town *t : Town::Iterate()) { t->stations_near.clear(); }
 	for (Industry *i : Industry::Iterate()) { i->stations_near.clear(); }
-	for (Station *st : Station::Iterate()) { st->RecomputeCatchment(true); }
+
+	/* The catchment area of a station which is not associated with a neutral industry only depends on the map,
+	 * so compute those concurrently. Linking the stations to the towns and industries is done in station order. */
+	struct NearbyLists {
+		Station *st;
+		std::vector<Town *> towns;
+		std::vector<Industry *> industries;
+	};
+	std::vector<NearbyLists> nearby;
+	for (Station *st : Station::Iterate()) nearby.push_back({ st, {}, {} });
+
+	const bool serve_neutral_industries = _settings_game.station.serve_neutral_industries;
+	auto is_independent = [&](const Station *st) {
+		return !st->rect.IsEmpty() && (serve_neutral_industries || st->industry == nullptr);
+	};
+
+	_general_worker_pool.ParallelFor(static_cast<uint>(nearby.size()), [&](uint i) {
+		Station *st = nearby[i].st;
+		if (!is_independent(st)) return;
+		st->industries_near.clear();
+		st->ComputeCatchment(nearby[i].towns, nearby[i].industries);
+	});
+
+	for (const NearbyLists &lists : nearby) {
+		if (is_independent(lists.st)) {
+			lists.st->AddToNearbyLists(lists.towns, lists.industries);
+		} else {
+			lists.st->RecomputeCatchment(true);
+		}
+	}
 }
 
 /************************************************************************/
@@ -952,6 +952,10 @@ public:
 	uint GetPlatformLength(TileIndex tile) const override;
 	void RecomputeCatchment(bool no_clear_nearby_lists = false);
 	static void RecomputeCatchmentForAll();
+private:
+	void ComputeCatchment(std::vector<Town *> &towns, std::vector<Industry *> &industries);
+	void AddToNearbyLists(std::span<Town * const> towns, std::span<Industry * const> industries);
+public:
 
 	uint GetCatchmentRadius() const;
 	Rect GetCatchmentRectUsingRadius(uint radius) const;
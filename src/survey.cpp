@@ -18,6 +18,15 @@
 #include "timer/timer_game_tick.h"
 #include "sl/saveload.h"
 #include "date_func.h"
+#include "cargopacket.h"
+#include "company_base.h"
+#include "group.h"
+#include "industry.h"
+#include "order_base.h"
+#include "station_base.h"
+#include "town.h"
+#include "vehicle_base.h"
+#include "debug_desync.h"
 
 #include "currency.h"
 #include "fontcache.h"
@@ -43,6 +52,10 @@
 
 #include <bit>
 
+#if defined(UNIX)
+#	include <sys/resource.h>
+#endif
+
 #ifdef WITH_ALLEGRO
 #	include <allegro.h>
 #endif /* WITH_ALLEGRO */
@@ -331,6 +344,48 @@ void SurveyTimers(nlohmann::json &survey)
 	survey["economy"] = fmt::format("{:04}-{:02}-{:02} ({})", EconTime::CurYear(), EconTime::CurMonth() + 1, EconTime::CurDay(), EconTime::CurDateFract());
 }
 
+/**
+ * Convert the state of the game at the end of a benchmark to JSON.
+ * This is the size of the main pools, the peak memory usage of the process and the world state hash.
+ *
+ * @param survey The JSON object.
+ */
+void SurveyBenchmarkState(nlohmann::json &survey)
+{
+	auto survey_pool = [&](std::string_view name, size_t items, size_t capacity) {
+		auto &pool = survey["pools"][std::string(name)];
+		pool["items"] = items;
+		pool["capacity"] = capacity;
+	};
+	survey_pool("vehicles", Vehicle::GetNumItems(), Vehicle::GetPoolSize());
+	survey_pool("stations", BaseStation::GetNumItems(), BaseStation::GetPoolSize());
+	survey_pool("cargo_packets", CargoPacket::GetNumItems(), CargoPacket::GetPoolSize());
+	survey_pool("orders", OrderPoolItem::GetNumItems(), OrderPoolItem::GetPoolSize());
+	survey_pool("order_lists", OrderList::GetNumItems(), OrderList::GetPoolSize());
+	survey_pool("towns", Town::GetNumItems(), Town::GetPoolSize());
+	survey_pool("industries", Industry::GetNumItems(), Industry::GetPoolSize());
+	survey_pool("companies", Company::GetNumItems(), Company::GetPoolSize());
+	survey_pool("groups", Group::GetNumItems(), Group::GetPoolSize());
+
+#if defined(UNIX)
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#	if defined(__APPLE__)
+		/* Already in bytes */
+		survey["peak_memory"] = static_cast<uint64_t>(usage.ru_maxrss);
+#	else
+		survey["peak_memory"] = static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#	endif
+	}
+#endif
+
+	const WorldStateHash hash = ComputeWorldStateHash(WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG);
+	survey["state_hash"]["root"] = fmt::format("{:016X}", hash.RootHash());
+	for (uint part = 0; part < WSHP_END; part++) {
+		survey["state_hash"][GetWorldStateHashPartName(static_cast<WorldStateHashPart>(part))] = fmt::format("{:016X}", hash.PartHash(static_cast<WorldStateHashPart>(part)));
+	}
+}
+
 /**
  * Convert GRF information to JSON.
  *
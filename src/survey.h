@@ -27,7 +27,12 @@ void SurveyOpenTTD(nlohmann::json &survey);
 void SurveySettings(nlohmann::json &survey, bool skip_if_default);
 void SurveyTimers(nlohmann::json &survey);
 
+void SurveyBenchmarkState(nlohmann::json &survey);
+
 /* Defined in os/<os>/survey_<os>.cpp. */
 void SurveyOS(nlohmann::json &json);
 
+/* Defined in framerate_gui.cpp. */
+void SurveyPerformanceBenchmark(nlohmann::json &survey);
+
 #endif /* SURVEY_H */
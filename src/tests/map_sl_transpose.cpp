@@ -0,0 +1,74 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file map_sl_transpose.cpp Test the conversion between map tile arrays and map chunk field streams. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../map_type.h"
+#include "../sl/map_sl_transpose.h"
+
+#include <vector>
+
+#include "../safeguards.h"
+
+/* Not a multiple of any vector size, so that the scalar tail is also tested */
+static const size_t TEST_TILE_COUNT = 1000 + 7;
+
+template <typename TField, typename TTile, size_t TOffset>
+static void TestMapFieldTransposer()
+{
+	using Transposer = MapFieldTransposer<TField, sizeof(TTile), TOffset>;
+
+	std::vector<TTile> tiles(TEST_TILE_COUNT);
+	uint8_t *tile_bytes = reinterpret_cast<uint8_t *>(tiles.data());
+	for (size_t i = 0; i < TEST_TILE_COUNT * sizeof(TTile); i++) {
+		tile_bytes[i] = static_cast<uint8_t>((i * 37) + 11);
+	}
+	const std::vector<TTile> original = tiles;
+
+	std::vector<uint8_t> stream(TEST_TILE_COUNT * sizeof(TField));
+	for (size_t i = 0; i < stream.size(); i++) {
+		stream[i] = static_cast<uint8_t>((i * 101) + 3);
+	}
+
+	Transposer::Scatter(tile_bytes, stream.data(), TEST_TILE_COUNT);
+	for (size_t i = 0; i < TEST_TILE_COUNT; i++) {
+		const uint8_t *tile = tile_bytes + (i * sizeof(TTile));
+		const uint8_t *orig = reinterpret_cast<const uint8_t *>(original.data()) + (i * sizeof(TTile));
+		TField expected = stream[i * sizeof(TField)];
+		if constexpr (sizeof(TField) == 2) expected = (expected << 8) | stream[(i * 2) + 1];
+		TField value;
+		std::memcpy(&value, tile + TOffset, sizeof(value));
+		CHECK(value == expected);
+		for (size_t j = 0; j < sizeof(TTile); j++) {
+			if (j < TOffset || j >= TOffset + sizeof(TField)) CHECK(tile[j] == orig[j]);
+		}
+	}
+
+	std::vector<uint8_t> output(stream.size());
+	Transposer::Gather(output.data(), tile_bytes, TEST_TILE_COUNT);
+	CHECK(output == stream);
+}
+
+TEST_CASE("Map chunk field transposition - Tile")
+{
+	TestMapFieldTransposer<uint8_t, Tile, offsetof(Tile, type)>();
+	TestMapFieldTransposer<uint8_t, Tile, offsetof(Tile, height)>();
+	TestMapFieldTransposer<uint16_t, Tile, offsetof(Tile, m2)>();
+	TestMapFieldTransposer<uint8_t, Tile, offsetof(Tile, m1)>();
+	TestMapFieldTransposer<uint8_t, Tile, offsetof(Tile, m5)>();
+}
+
+TEST_CASE("Map chunk field transposition - TileExtended")
+{
+	TestMapFieldTransposer<uint8_t, TileExtended, offsetof(TileExtended, m6)>();
+	TestMapFieldTransposer<uint8_t, TileExtended, offsetof(TileExtended, m7)>();
+	TestMapFieldTransposer<uint16_t, TileExtended, offsetof(TileExtended, m8)>();
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file newgrf_resolve_threads.cpp Test that sprite groups can be resolved concurrently. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../newgrf_spritegroup.h"
+#include "newgrf_spritegroup_helpers.h"
+
+#include <atomic>
+#include <thread>
+
+#include "../safeguards.h"
+
+static DeterministicSpriteGroup *MakeCalculatedResultGroup(std::vector<DeterministicSpriteGroupAdjust> adjusts)
+{
+	DeterministicSpriteGroup *group = DeterministicSpriteGroup::Create();
+	group->size = DSG_SIZE_DWORD;
+	group->dsg_flags |= DSGF_CALCULATED_RESULT;
+	group->adjusts = std::move(adjusts);
+	group->Compile();
+	return group;
+}
+
+/**
+ * Expected result of the test chain.
+ * @param param1 Callback parameter 1.
+ * @param param2 Callback parameter 2.
+ * @return The callback result.
+ */
+static uint16_t ExpectedResult(uint32_t param1, uint32_t param2)
+{
+	uint32_t value = ((param2 * 3) ^ param1) + param1 + (param2 * 3);
+	return GB(value, 0, 15);
+}
+
+TEST_CASE("NewGRF resolve - concurrent resolves using temporary storage")
+{
+	/* Procedure: store 3 * param2 into register 6, return (3 * param2) ^ param1 */
+	DeterministicSpriteGroup *proc = MakeCalculatedResultGroup({
+		MakeAdjust(DSGA_OP_RST, 0x18, UINT32_MAX),
+		MakeAdjust(DSGA_OP_MUL, 0x1A, 3),
+		MakeAdjust(DSGA_OP_STO, 0x1A, 6),
+		MakeAdjust(DSGA_OP_XOR, 0x10, UINT32_MAX),
+	});
+
+	/* Root: store param1 into register 5, call the procedure and add registers 5 and 6 to its result */
+	DeterministicSpriteGroupAdjust call = MakeAdjust(DSGA_OP_RST, 0x7E, UINT32_MAX);
+	call.subroutine = proc;
+	DeterministicSpriteGroup *root = MakeCalculatedResultGroup({
+		MakeAdjust(DSGA_OP_RST, 0x10, UINT32_MAX),
+		MakeAdjust(DSGA_OP_STO, 0x1A, 5),
+		call,
+		MakeAdjust(DSGA_OP_ADD, 0x7D, UINT32_MAX, 5),
+		MakeAdjust(DSGA_OP_ADD, 0x7D, UINT32_MAX, 6),
+	});
+
+	auto resolve = [&](uint32_t param1, uint32_t param2) -> uint16_t {
+		ResolverObject object(nullptr, CBID_VEHICLE_LENGTH, param1, param2);
+		object.root_spritegroup = root;
+		return object.ResolveCallback();
+	};
+
+	CHECK(resolve(1, 2) == ExpectedResult(1, 2));
+	CHECK(resolve(0x1234, 0x56) == ExpectedResult(0x1234, 0x56));
+
+	static constexpr uint THREAD_COUNT = 4;
+	static constexpr uint ITERATIONS = 20000;
+	std::atomic<uint> mismatches = 0;
+	std::vector<std::thread> threads;
+	for (uint t = 0; t < THREAD_COUNT; t++) {
+		threads.emplace_back([&, t]() {
+			for (uint i = 0; i < ITERATIONS; i++) {
+				uint32_t param1 = (i * 7919) ^ (t << 12);
+				uint32_t param2 = i + t;
+				if (resolve(param1, param2) != ExpectedResult(param1, param2)) mismatches++;
+			}
+		});
+	}
+	for (std::thread &thread : threads) thread.join();
+
+	CHECK(mismatches == 0);
+
+	_spritegroup_pool.CleanPool();
+}
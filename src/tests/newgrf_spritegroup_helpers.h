@@ -0,0 +1,42 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file newgrf_spritegroup_helpers.h Helpers for building deterministic sprite groups in tests. */
+
+#ifndef NEWGRF_SPRITEGROUP_HELPERS_H
+#define NEWGRF_SPRITEGROUP_HELPERS_H
+
+#include "../newgrf_spritegroup.h"
+
+/**
+ * Make an adjust of a deterministic sprite group.
+ * @param operation Operation combining the value with the last value.
+ * @param variable Variable to read.
+ * @param and_mask Mask applied to the shifted variable.
+ * @param parameter Parameter of variables 0x60 to 0x7F.
+ * @param type Adjustment applied to the masked variable.
+ * @param shift_num Right shift applied to the variable.
+ * @param add_val Value added for #DSGA_TYPE_DIV and #DSGA_TYPE_MOD, compared for #DSGA_TYPE_EQ and #DSGA_TYPE_NEQ.
+ * @param divmod_val Divisor for #DSGA_TYPE_DIV and #DSGA_TYPE_MOD.
+ * @return The adjust.
+ */
+inline DeterministicSpriteGroupAdjust MakeAdjust(DeterministicSpriteGroupAdjustOperation operation, uint16_t variable, uint32_t and_mask, uint32_t parameter = 0,
+		DeterministicSpriteGroupAdjustType type = DSGA_TYPE_NONE, uint8_t shift_num = 0, uint32_t add_val = 0, uint32_t divmod_val = 0)
+{
+	DeterministicSpriteGroupAdjust adjust;
+	adjust.operation = operation;
+	adjust.type = type;
+	adjust.variable = variable;
+	adjust.shift_num = shift_num;
+	adjust.parameter = parameter;
+	adjust.and_mask = and_mask;
+	adjust.add_val = add_val;
+	adjust.divmod_val = divmod_val;
+	return adjust;
+}
+
+#endif /* NEWGRF_SPRITEGROUP_HELPERS_H */
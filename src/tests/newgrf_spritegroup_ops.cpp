@@ -0,0 +1,239 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file newgrf_spritegroup_ops.cpp Test that compiled deterministic sprite group ops behave like the adjusts they were compiled from, and that compiled ranges select the right group. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../newgrf_spritegroup.h"
+#include "newgrf_spritegroup_helpers.h"
+
+#include "../safeguards.h"
+
+/** Shift, mask and adjustment of the value of an adjust. */
+struct AdjustValueVariant {
+	DeterministicSpriteGroupAdjustType type;
+	uint8_t shift_num;
+	uint32_t and_mask;
+	uint32_t add_val;
+	uint32_t divmod_val;
+};
+
+static const AdjustValueVariant _value_variants[] = {
+	{ DSGA_TYPE_NONE, 0, UINT32_MAX, 0, 0 },
+	{ DSGA_TYPE_NONE, 3, 0xFF, 0, 0 },
+	{ DSGA_TYPE_NONE, 31, 0x1, 0, 0 },
+	{ DSGA_TYPE_DIV, 0, 0xFFFF, 5, 7 },
+	{ DSGA_TYPE_DIV, 2, 0xFF, 0xFFFFFFFE, 3 },
+	{ DSGA_TYPE_MOD, 0, 0xFFFF, 3, 5 },
+	{ DSGA_TYPE_MOD, 4, 0xFFF, 0, 0xFFFFFFF9 },
+	{ DSGA_TYPE_EQ, 0, 0xFF, 4, 0 },
+	{ DSGA_TYPE_NEQ, 1, 0xFF, 2, 0 },
+};
+
+static const DeterministicSpriteGroupAdjustOperation _operations[] = {
+	DSGA_OP_ADD, DSGA_OP_SUB, DSGA_OP_SMIN, DSGA_OP_SMAX, DSGA_OP_UMIN, DSGA_OP_UMAX, DSGA_OP_SDIV, DSGA_OP_SMOD, DSGA_OP_UDIV, DSGA_OP_UMOD,
+	DSGA_OP_MUL, DSGA_OP_AND, DSGA_OP_OR, DSGA_OP_XOR, DSGA_OP_STO, DSGA_OP_RST, DSGA_OP_STOP, DSGA_OP_ROR, DSGA_OP_SCMP, DSGA_OP_UCMP,
+	DSGA_OP_SHL, DSGA_OP_SHR, DSGA_OP_SAR, DSGA_OP_TERNARY, DSGA_OP_EQ, DSGA_OP_SLT, DSGA_OP_SGE, DSGA_OP_SLE, DSGA_OP_SGT, DSGA_OP_RSUB,
+	DSGA_OP_STO_NC, DSGA_OP_ABS, DSGA_OP_JZ, DSGA_OP_JNZ, DSGA_OP_JZ_LV, DSGA_OP_JNZ_LV, DSGA_OP_NOOP,
+};
+
+static const DeterministicSpriteGroupSize _sizes[] = { DSG_SIZE_BYTE, DSG_SIZE_WORD, DSG_SIZE_DWORD };
+
+static const uint32_t _param1_values[] = { 0, 1, 7, 0x80, 0x1234, 0xFFFFFFF0 };
+static const uint32_t _param2_values[] = { 0, 3, 0xFFFF, 0x7FFFFFFF };
+
+static bool IsJumpOperation(DeterministicSpriteGroupAdjustOperation operation)
+{
+	return operation == DSGA_OP_JZ || operation == DSGA_OP_JNZ || operation == DSGA_OP_JZ_LV || operation == DSGA_OP_JNZ_LV;
+}
+
+static DeterministicSpriteGroupAdjust MakeAdjust(DeterministicSpriteGroupAdjustOperation operation, uint16_t variable, const AdjustValueVariant &variant)
+{
+	return MakeAdjust(operation, variable, variant.and_mask, 0, variant.type, variant.shift_num, variant.add_val, variant.divmod_val);
+}
+
+/* Shift, mask and adjust a value, S is the signed type of the variable size. */
+template <typename S>
+static uint32_t ReferenceAdjustValue(const DeterministicSpriteGroupAdjust &adjust, uint32_t value)
+{
+	value = (value >> adjust.shift_num) & adjust.and_mask;
+	switch (adjust.type) {
+		case DSGA_TYPE_DIV: return ((S)value + (S)adjust.add_val) / (S)adjust.divmod_val;
+		case DSGA_TYPE_MOD: return ((S)value + (S)adjust.add_val) % (S)adjust.divmod_val;
+		case DSGA_TYPE_EQ:  return (value == adjust.add_val) ? 1 : 0;
+		case DSGA_TYPE_NEQ: return (value != adjust.add_val) ? 1 : 0;
+		default:            return value;
+	}
+}
+
+/**
+ * Reference evaluation of the adjusts of a group, which only uses the variables 0x10, 0x18, 0x1A and 0x7E.
+ * The operations themselves are evaluated by EvaluateDeterministicSpriteGroupAdjust, on the already adjusted value.
+ * @param group The group.
+ * @param param1 Callback parameter 1.
+ * @param param2 Callback parameter 2.
+ * @return The value of the last adjust.
+ */
+static uint32_t ReferenceEvaluate(const DeterministicSpriteGroup *group, uint32_t param1, uint32_t param2)
+{
+	ResolverObject object(nullptr);
+	uint32_t last_value = 0;
+	for (size_t i = 0; i < group->adjusts.size(); i++) {
+		const DeterministicSpriteGroupAdjust &adjust = group->adjusts[i];
+		if ((adjust.adjust_flags & DSGAF_SKIP_ON_ZERO) && (last_value == 0)) continue;
+		if ((adjust.adjust_flags & DSGAF_SKIP_ON_LSB_SET) && (last_value & 1) != 0) continue;
+
+		uint32_t value;
+		switch (adjust.variable) {
+			case 0x10: value = param1; break;
+			case 0x18: value = param2; break;
+			case 0x1A: value = UINT32_MAX; break;
+			case 0x7E: value = GB(ReferenceEvaluate(static_cast<const DeterministicSpriteGroup *>(adjust.subroutine), param1, param2), 0, 15); break;
+			default: NOT_REACHED();
+		}
+		switch (group->size) {
+			case DSG_SIZE_BYTE:  value = ReferenceAdjustValue<int8_t>(adjust, value); break;
+			case DSG_SIZE_WORD:  value = ReferenceAdjustValue<int16_t>(adjust, value); break;
+			case DSG_SIZE_DWORD: value = ReferenceAdjustValue<int32_t>(adjust, value); break;
+		}
+
+		/* Apply the operation to the adjusted value, or return the value truncated to the variable size */
+		auto apply = [&](DeterministicSpriteGroupAdjustOperation operation) -> uint32_t {
+			DeterministicSpriteGroupAdjust plain = adjust;
+			plain.operation = operation;
+			plain.type = DSGA_TYPE_NONE;
+			plain.shift_num = 0;
+			plain.and_mask = UINT32_MAX;
+			return EvaluateDeterministicSpriteGroupAdjust(group->size, plain, &object.default_scope, last_value, value);
+		};
+
+		bool jump = false;
+		switch (adjust.operation) {
+			case DSGA_OP_JZ:     jump = (value == 0); break;
+			case DSGA_OP_JNZ:    jump = (value != 0); break;
+			case DSGA_OP_JZ_LV:  jump = (last_value == 0); break;
+			case DSGA_OP_JNZ_LV: jump = (last_value != 0); break;
+			default:
+				last_value = apply(adjust.operation);
+				continue;
+		}
+		if (jump) {
+			if (adjust.operation == DSGA_OP_JZ || adjust.operation == DSGA_OP_JNZ) last_value = apply(DSGA_OP_RST);
+			i += adjust.jump;
+		}
+	}
+	return last_value;
+}
+
+/**
+ * Resolve a group with its compiled ops, and check that this gives the same result as the reference evaluation of its adjusts.
+ * @param group The group to check, it is compiled by this function.
+ * @return True iff the results match for all tested parameters.
+ */
+static bool CheckOpsMatchAdjusts(DeterministicSpriteGroup *group)
+{
+	group->Compile();
+
+	for (uint32_t param1 : _param1_values) {
+		for (uint32_t param2 : _param2_values) {
+			ResolverObject object(nullptr, CBID_VEHICLE_LENGTH, param1, param2);
+			object.root_spritegroup = group;
+			object.ResolveCallback();
+			uint32_t compiled = object.last_value;
+			uint32_t reference = ReferenceEvaluate(group, param1, param2);
+			if (compiled != reference) {
+				UNSCOPED_INFO("operation: " << group->adjusts[1].operation << ", variable: " << group->adjusts[1].variable << ", size: " << group->size << ", param1: " << param1 << ", param2: " << param2);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+TEST_CASE("NewGRF deterministic sprite group - compiled ops match adjusts")
+{
+	/* Procedure returning (param1 * 3) ^ param2, called by variable 0x7E */
+	DeterministicSpriteGroup *proc = DeterministicSpriteGroup::Create();
+	proc->size = DSG_SIZE_DWORD;
+	proc->dsg_flags |= DSGF_CALCULATED_RESULT;
+	proc->adjusts.push_back(MakeAdjust(DSGA_OP_RST, 0x10, _value_variants[0]));
+	proc->adjusts.push_back(MakeAdjust(DSGA_OP_MUL, 0x1A, { DSGA_TYPE_NONE, 0, 3, 0, 0 }));
+	proc->adjusts.push_back(MakeAdjust(DSGA_OP_XOR, 0x18, _value_variants[0]));
+	proc->Compile();
+
+	const AdjustValueVariant last_value_variant = { DSGA_TYPE_NONE, 0, UINT32_MAX, 0, 0 };
+	const AdjustValueVariant constant_variant = { DSGA_TYPE_NONE, 0, 100, 0, 0 };
+
+	for (DeterministicSpriteGroupSize size : _sizes) {
+		for (DeterministicSpriteGroupAdjustOperation operation : _operations) {
+			for (const AdjustValueVariant &variant : _value_variants) {
+				for (uint16_t variable : { 0x10, 0x1A, 0x7E }) {
+					/* The jump distance shares storage with the procedure, so jumps cannot call procedures */
+					if (variable == 0x7E && IsJumpOperation(operation)) continue;
+
+					/* last_value = param2, apply the tested adjust, then add a constant which jumps may skip */
+					DeterministicSpriteGroup *group = DeterministicSpriteGroup::Create();
+					group->size = size;
+					group->dsg_flags |= DSGF_CALCULATED_RESULT;
+					group->adjusts.push_back(MakeAdjust(DSGA_OP_RST, 0x18, last_value_variant));
+					group->adjusts.push_back(MakeAdjust(operation, variable, variant));
+					if (variable == 0x7E) {
+						group->adjusts.back().subroutine = proc;
+					} else {
+						group->adjusts.back().jump = 1;
+					}
+					group->adjusts.push_back(MakeAdjust(DSGA_OP_ADD, 0x1A, constant_variant));
+
+					CHECK(CheckOpsMatchAdjusts(group));
+				}
+			}
+		}
+	}
+
+	_spritegroup_pool.CleanPool();
+}
+
+TEST_CASE("NewGRF deterministic sprite group - compiled ranges")
+{
+	const uint16_t results[] = { 10, 11, 12, 13, 14 };
+	std::vector<CallbackResultSpriteGroup *> targets;
+	for (uint16_t result : results) targets.push_back(CallbackResultSpriteGroup::Create(result));
+	const SpriteGroup *default_group = CallbackResultSpriteGroup::Create(99);
+
+	/* Dense ranges, which are compiled to a table, and the same ranges moved to a span too large for a table */
+	for (uint32_t offset : { 0U, 5U, 0x7FFFFF00U }) {
+		DeterministicSpriteGroup *group = DeterministicSpriteGroup::Create();
+		group->size = DSG_SIZE_DWORD;
+		group->adjusts.push_back(MakeAdjust(DSGA_OP_RST, 0x10, _value_variants[0]));
+		group->ranges.push_back({ targets[0], offset + 0, offset + 1 });
+		group->ranges.push_back({ targets[1], offset + 2, offset + 2 });
+		group->ranges.push_back({ targets[2], offset + 4, offset + 7 });
+		group->ranges.push_back({ targets[3], offset + 8, offset + 8 });
+		group->ranges.push_back({ targets[4], offset + 9, offset == 0x7FFFFF00U ? UINT32_MAX : offset + 20 });
+		group->default_group = default_group;
+		group->Compile();
+		CHECK(group->range_table.empty() == (offset == 0x7FFFFF00U));
+
+		auto expected = [&](uint32_t value) -> uint16_t {
+			for (const DeterministicSpriteGroupRange &range : group->ranges) {
+				if (range.low <= value && value <= range.high) return range.group->GetCallbackResult();
+			}
+			return 99;
+		};
+
+		for (uint32_t value = offset - 2; value != offset + 25; value++) {
+			ResolverObject object(nullptr, CBID_VEHICLE_LENGTH, value);
+			object.root_spritegroup = group;
+			CHECK(object.ResolveCallback() == expected(value));
+		}
+	}
+
+	_spritegroup_pool.CleanPool();
+}
@@ -0,0 +1,76 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file viewport_sprite_sorter.cpp Test that the parent sprite sorters produce the same order. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../viewport_sprite_sorter.h"
+#include "../viewport_func.h"
+#include "../core/random_func.hpp"
+
+#include "../safeguards.h"
+
+#ifdef WITH_SSE
+
+/**
+ * Generate sprites roughly like a viewport does: tiles in rows, with a few sprites per tile and some overlapping objects.
+ * @param randomizer The random source.
+ * @param count Number of sprites to generate.
+ * @return The sprites.
+ */
+static std::vector<ParentSpriteToDraw> GenerateSprites(Randomizer &randomizer, uint count)
+{
+	std::vector<ParentSpriteToDraw> sprites(count);
+	for (uint i = 0; i < count; i++) {
+		ParentSpriteToDraw &ps = sprites[i];
+		const int tile = i / 3;
+		const int x = (tile % 24) * 16 + (int)randomizer.Next(24) - 4;
+		const int y = (tile / 24) * 16 + (int)randomizer.Next(24) - 4;
+		const int z = (int)randomizer.Next(64);
+		ps.xmin = x;
+		ps.ymin = y;
+		ps.zmin = z;
+		ps.xmax = x + randomizer.Next(16);
+		ps.ymax = y + randomizer.Next(16);
+		ps.zmax = z + randomizer.Next(32);
+		ps.special_flags = VSSF_NONE;
+		if (randomizer.Next(16) == 0) ps.special_flags = VSSSF_SORT_SPECIAL | (randomizer.Next(2) == 0 ? VSSSF_SORT_DIAG_VEH : VSSSF_SORT_SORT_BRIDGE_BB);
+		ps.height = 0;
+		ps.SetComparisonDone(false);
+	}
+	return sprites;
+}
+
+static std::vector<uint> SortSprites(std::vector<ParentSpriteToDraw> sprites, VpSpriteSorter sorter)
+{
+	ParentSpriteToSortVector psdv;
+	for (ParentSpriteToDraw &ps : sprites) psdv.push_back(&ps);
+	sorter(&psdv);
+
+	std::vector<uint> order;
+	for (const ParentSpriteToDraw *ps : psdv) order.push_back((uint)(ps - sprites.data()));
+	return order;
+}
+
+TEST_CASE("ViewportSortParentSprites - AVX2 bucketed sorter matches SSE4.1 sorter")
+{
+	if (!ViewportSortParentSpritesAVX2Checker() || !ViewportSortParentSpritesSSE41Checker()) return;
+
+	Randomizer randomizer;
+	randomizer.SetSeed(0x5350524E);
+	for (uint count : { 1, 100, 255, 256, 257, 300, 1000, 2000 }) {
+		for (int run = 0; run < 8; run++) {
+			std::vector<ParentSpriteToDraw> sprites = GenerateSprites(randomizer, count);
+			CHECK(SortSprites(sprites, &ViewportSortParentSpritesAVX2) == SortSprites(sprites, &ViewportSortParentSpritesSSE41));
+		}
+	}
+}
+
+#endif /* WITH_SSE */
@@ -146,7 +146,10 @@
 #include "core/alloc_func.hpp"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "debug.h"
+#include "worker_thread.h"
 #include <math.h>
+#include <chrono>
 
 #include "safeguards.h"
 
@@ -405,24 +408,30 @@ static void HeightMapGenerate()
 		}
 
 		/* It is regular iteration round.
-		 * Interpolate height values at odd x, even y tiles */
-		for (int y = 0; y <= _height_map.size_y; y += 2 * step) {
+		 * Interpolate height values at odd x, even y tiles.
+		 * Each row only reads and writes itself, so rows are interpolated in parallel. */
+		_general_worker_pool.ParallelFor(_height_map.size_y / (2 * step) + 1, [&](uint row) {
+			const int y = row * 2 * step;
 			for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
 				Height h00 = _height_map.height(x + 0 * step, y);
 				Height h02 = _height_map.height(x + 2 * step, y);
 				Height h01 = (h00 + h02) / 2;
 				_height_map.height(x + 1 * step, y) = h01;
 			}
-		}
+		});
 
-		/* Interpolate height values at odd y tiles */
-		for (int y = 0; y <= _height_map.size_y - 2 * step; y += 2 * step) {
-			for (int x = 0; x <= _height_map.size_x; x += step) {
-				Height h00 = _height_map.height(x, y + 0 * step);
-				Height h20 = _height_map.height(x, y + 2 * step);
-				Height h10 = (h00 + h20) / 2;
-				_height_map.height(x, y + 1 * step) = h10;
-			}
+		/* Interpolate height values at odd y tiles.
+		 * Each odd row is only written from the even rows either side of it, so rows are interpolated in parallel. */
+		if (_height_map.size_y >= 2 * step) {
+			_general_worker_pool.ParallelFor((_height_map.size_y - 2 * step) / (2 * step) + 1, [&](uint row) {
+				const int y = row * 2 * step;
+				for (int x = 0; x <= _height_map.size_x; x += step) {
+					Height h00 = _height_map.height(x, y + 0 * step);
+					Height h20 = _height_map.height(x, y + 2 * step);
+					Height h10 = (h00 + h20) / 2;
+					_height_map.height(x, y + 1 * step) = h10;
+				}
+			});
 		}
 
 		/* Add noise for next higher frequency (smaller steps) */
@@ -529,6 +538,45 @@ static double SineTransformPlateaus(double &fheight)
 	return height;
 }
 
+/**
+ * Applies sine wave redistribution onto one height of the height map.
+ * @param h The height to transform.
+ * @param h_min The minimum height for the map.
+ * @param h_max The maximum height for the map.
+ */
+static void HeightMapSineTransformHeight(Height &h, Height h_min, Height h_max)
+{
+	double fheight;
+
+	if (h < h_min) return;
+
+	/* Transform height into 0..1 space */
+	fheight = (double)(h - h_min) / (double)(h_max - h_min);
+
+	switch (_settings_game.game_creation.average_height) {
+		case GenworldAverageHeight::Auto:
+			/* Apply sine transform depending on landscape type */
+			switch (_settings_game.game_creation.landscape) {
+				case LandscapeType::Temperate: fheight = SineTransformNormal(fheight); break;
+				case LandscapeType::Tropic: fheight = SineTransformLowlands(fheight); break;
+				case LandscapeType::Arctic: fheight = SineTransformPlateaus(fheight); break;
+				case LandscapeType::Toyland: fheight = SineTransformNormal(fheight); break;
+				default: NOT_REACHED();
+			}
+			break;
+
+		case GenworldAverageHeight::Lowlands: fheight = SineTransformLowlands(fheight); break;
+		case GenworldAverageHeight::Normal: fheight = SineTransformNormal(fheight); break;
+		case GenworldAverageHeight::Plateaus: fheight = SineTransformPlateaus(fheight); break;
+		default: NOT_REACHED();
+	}
+
+	/* Transform it back into h_min..h_max space */
+	h = static_cast<Height>(fheight * (h_max - h_min) + h_min);
+	if (h < 0) h = I2H(0);
+	if (h >= h_max) h = h_max - 1;
+}
+
 /**
  * Applies sine wave redistribution onto height map.
  * @param h_min The minimum height for the map.
@@ -536,37 +584,12 @@ static double SineTransformPlateaus(double &fheight)
  */
 static void HeightMapSineTransform(Height h_min, Height h_max)
 {
-	for (Height &h : _height_map.h) {
-		double fheight;
-
-		if (h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-
-		switch (_settings_game.game_creation.average_height) {
-			case GenworldAverageHeight::Auto:
-				/* Apply sine transform depending on landscape type */
-				switch (_settings_game.game_creation.landscape) {
-					case LandscapeType::Temperate: fheight = SineTransformNormal(fheight); break;
-					case LandscapeType::Tropic: fheight = SineTransformLowlands(fheight); break;
-					case LandscapeType::Arctic: fheight = SineTransformPlateaus(fheight); break;
-					case LandscapeType::Toyland: fheight = SineTransformNormal(fheight); break;
-					default: NOT_REACHED();
-				}
-				break;
-
-			case GenworldAverageHeight::Lowlands: fheight = SineTransformLowlands(fheight); break;
-			case GenworldAverageHeight::Normal: fheight = SineTransformNormal(fheight); break;
-			case GenworldAverageHeight::Plateaus: fheight = SineTransformPlateaus(fheight); break;
-			default: NOT_REACHED();
+	/* Each height is transformed independently, so the rows of the height map are transformed in parallel. */
+	_general_worker_pool.ParallelFor(_height_map.size_y + 1, [&](uint y) {
+		for (int x = 0; x < _height_map.dim_x; x++) {
+			HeightMapSineTransformHeight(_height_map.height(x, y), h_min, h_max);
 		}
-
-		/* Transform it back into h_min..h_max space */
-		h = static_cast<Height>(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
-	}
+	});
 }
 
 /**
@@ -604,8 +627,6 @@ static void HeightMapCurves(uint level)
 
 	const std::span<const ControlPoint> curve_maps[] = { curve_map_1, curve_map_2, curve_map_3, curve_map_4 };
 
-	std::array<Height, std::size(curve_maps)> ht{};
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -616,8 +637,10 @@ static void HeightMapCurves(uint level)
 		c[i] = RandomRange(static_cast<uint32_t>(std::size(curve_maps)));
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
+	/* Apply curves, each column only touches its own heights so columns are processed in parallel */
+	_general_worker_pool.ParallelFor(_height_map.size_x, [&](uint col) {
+		const int x = col;
+		std::array<Height, std::size(curve_maps)> ht{};
 
 		/* Get our X grid positions and bi-linear ratio */
 		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
@@ -699,7 +722,7 @@ static void HeightMapCurves(uint level)
 			/* Re-add sea level */
 			*h += I2H(1);
 		}
-	}
+	});
 }
 
 /**
@@ -909,6 +932,19 @@ static void HeightMapSmoothSlopes(Height dh_max)
 	}
 }
 
+/**
+ * Run one stage of the terrain generator, and log how long it took at map debug level 2.
+ * @param name The name of the stage.
+ * @param stage The stage to run.
+ */
+template <typename F>
+static void TgenRunStage(const char *name, F stage)
+{
+	const auto start = std::chrono::steady_clock::now();
+	stage();
+	Debug(map, 2, "TGP: {} took {} us", name, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
 /**
  * Height map terraform post processing:
  *  - water level adjusting
@@ -922,21 +958,21 @@ static void HeightMapNormalize()
 	const Height h_max_new = TGPGetMaxHeight();
 	const Height roughness = 7 + 3 * _settings_game.game_creation.tgen_smoothness;
 
-	HeightMapAdjustWaterLevel(water_percent, h_max_new);
+	TgenRunStage("water level", [&]() { HeightMapAdjustWaterLevel(water_percent, h_max_new); });
 
 	BorderFlags water_borders = _settings_game.construction.freeform_edges ? _settings_game.game_creation.water_borders : BORDERFLAGS_ALL;
 	if (water_borders == BorderFlag::RandomBorders) water_borders = static_cast<BorderFlags>(GB(Random(), 0, 4));
 
-	HeightMapCoastLines(water_borders);
-	HeightMapSmoothSlopes(roughness);
+	TgenRunStage("coast lines", [&]() { HeightMapCoastLines(water_borders); });
+	TgenRunStage("slope smoothing", [&]() { HeightMapSmoothSlopes(roughness); });
 
-	HeightMapSmoothCoasts(water_borders);
-	HeightMapSmoothSlopes(roughness);
+	TgenRunStage("coast smoothing", [&]() { HeightMapSmoothCoasts(water_borders); });
+	TgenRunStage("slope smoothing", [&]() { HeightMapSmoothSlopes(roughness); });
 
-	HeightMapSineTransform(I2H(1), h_max_new);
+	TgenRunStage("sine transform", [&]() { HeightMapSineTransform(I2H(1), h_max_new); });
 
 	if (_settings_game.game_creation.variety > 0) {
-		HeightMapCurves(_settings_game.game_creation.variety);
+		TgenRunStage("curves", []() { HeightMapCurves(_settings_game.game_creation.variety); });
 	}
 }
 
@@ -1062,11 +1098,11 @@ void GenerateTerrainPerlin()
 	AllocHeightMap();
 	GenerateWorldSetAbortCallback(FreeHeightMap);
 
-	HeightMapGenerate();
+	TgenRunStage("generate", HeightMapGenerate);
 
 	IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
 
-	HeightMapNormalize();
+	TgenRunStage("normalize", HeightMapNormalize);
 
 	IncreaseGeneratingWorldProgress(GenWorldProgress::Landscape);
 
@@ -1078,12 +1114,14 @@ void GenerateTerrainPerlin()
 
 	int max_height = H2I(TGPGetMaxHeight());
 
-	/* Transfer height map into OTTD map */
-	for (int y = 0; y < _height_map.size_y; y++) {
-		for (int x = 0; x < _height_map.size_x; x++) {
-			TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
-		}
-	}
+	/* Transfer height map into OTTD map, each tile is set independently so rows are transferred in parallel */
+	TgenRunStage("transfer", [&]() {
+		_general_worker_pool.ParallelFor(_height_map.size_y, [&](uint y) {
+			for (int x = 0; x < _height_map.size_x; x++) {
+				TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+			}
+		});
+	});
 
 	FreeHeightMap();
 	GenerateWorldSetAbortCallback(nullptr);
@@ -37,6 +37,12 @@ void SetCurrentThreadName(const std::string &name);
  */
 void GetCurrentThreadName(struct format_target &buffer);
 
+/**
+ * Lower the scheduling priority of the thread this function is called on,
+ * for background work which should not compete with the main thread.
+ */
+void SetCurrentThreadLowPriority();
+
 /**
  * Set the current thread as the "main" thread
  */
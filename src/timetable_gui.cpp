@@ -21,6 +21,7 @@
 #include "company_func.h"
 #include "date_func.h"
 #include "date_gui.h"
+#include "departures_func.h"
 #include "vehicle_gui.h"
 #include "settings_type.h"
 #include "viewport_func.h"
@@ -1383,6 +1384,7 @@ void ShowTimetableWindow(const Vehicle *v)
 
 void SetTimetableWindowsDirty(const Vehicle *v, SetTimetableWindowsDirtyFlags flags)
 {
+	InvalidateDepartureScheduleState(v);
 	if (_pause_mode.Any()) InvalidateWindowClassesData(WindowClass::DepartureBoard);
 
 	if (!(HaveWindowByClass(WindowClass::VehicleTimetable) ||
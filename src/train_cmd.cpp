@@ -33,6 +33,7 @@
 #include "zoom_func.h"
 #include "newgrf_debug.h"
 #include "framerate_type.h"
+#include "vehicle_cpu_stats.h"
 #include "tracerestrict.h"
 #include "tbtr_template_vehicle_func.h"
 #include "autoreplace_func.h"
@@ -3981,6 +3982,7 @@ static const uint8_t _initial_tile_subcoord[6][4][3] = {
  */
 static Track DoTrainPathfind(const Train *v, TileIndex tile, DiagDirection enterdir, TrackBits tracks, bool &path_found, bool do_track_reservation, PBSTileInfo *dest, TileIndex *final_dest)
 {
+	VehiclePathfinderCostMeasurer cost(v->index);
 	if (final_dest != nullptr) *final_dest = INVALID_TILE;
 	return YapfTrainChooseTrack(v, tile, enterdir, tracks, path_found, do_track_reservation, dest, final_dest);
 }
@@ -220,12 +220,14 @@ public:
 				SndConfirmBeep();
 				PlaceTreesRandomly();
 				MarkWholeNonMapViewportsDirty();
+				MarkAllViewportMapLandscapesDirty();
 				break;
 
 			case WID_BT_REMOVE_ALL: // remove all trees over the landscape
 				SndConfirmBeep();
 				RemoveAllTrees();
 				MarkWholeNonMapViewportsDirty();
+				MarkAllViewportMapLandscapesDirty();
 				break;
 
 			case WID_BT_MODE_NORMAL:
@@ -56,6 +56,7 @@
 #include "linkgraph/linkgraph.h"
 #include "linkgraph/refresh.h"
 #include "framerate_type.h"
+#include "vehicle_cpu_stats.h"
 #include "blitter/factory.hpp"
 #include "tbtr_template_vehicle_func.h"
 #include "tbtr_template_vehicle_cmd.h"
@@ -75,6 +76,7 @@
 #include "table/strings.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include "safeguards.h"
 
@@ -518,6 +520,17 @@ Vehicle::Vehicle(VehicleID index, VehicleType type) : VehiclePool::PoolItem<&_ve
 	this->last_loading_tick = StateTicks{0};
 	this->cur_image_valid_dir  = INVALID_DIR;
 	this->vcache.cached_veh_flags = 0;
+	this->newgrf_cache_generation = GetNextVehicleNewGRFCacheGeneration();
+}
+
+/**
+ * Get a new value for Vehicle::newgrf_cache_generation, which has not been used by any vehicle before.
+ * @return The generation.
+ */
+uint64_t GetNextVehicleNewGRFCacheGeneration()
+{
+	static std::atomic<uint64_t> generation = 0;
+	return generation.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 using VehicleTypeTileHash = robin_hood::unordered_map<TileIndex, VehicleID>;
@@ -1155,6 +1168,8 @@ void Vehicle::PreDestructor()
 
 	SCOPE_INFO_FMT([this], "Vehicle::PreDestructor: {}", VehicleInfoDumper(this));
 
+	ResetVehicleCpuStats(this->index);
+
 	if (Station::IsValidID(this->last_station_visited)) {
 		Station *st = Station::Get(this->last_station_visited);
 		st->loading_vehicles.erase(std::remove(st->loading_vehicles.begin(), st->loading_vehicles.end(), this), st->loading_vehicles.end());
@@ -1591,6 +1606,8 @@ void CallVehicleTicks()
 
 	_train_news_too_heavy_this_tick.clear();
 
+	UpdateVehicleCpuStatsSampling();
+
 	if (TickSkipCounter() == 0) RunVehicleDayProc();
 
 	if (EconTime::UsingWallclockUnits() && !CalTime::IsCalendarFrozen() && CalTime::CurSubDateFract() == 0) {
@@ -1670,6 +1687,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_TRAINS);
 		for (Train *front : _tick_train_front_cache) {
 			v = front;
+			VehicleTickCostMeasurer cost(front->index);
 			if (!front->Train::Tick()) continue;
 			for (Train *u = front; u != nullptr; u = u->Next()) {
 				u->tick_counter++;
@@ -1683,6 +1701,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_ROADVEHS);
 		for (RoadVehicle *front : _tick_road_veh_front_cache) {
 			v = front;
+			VehicleTickCostMeasurer cost(front->index);
 			if (!front->RoadVehicle::Tick()) continue;
 			for (RoadVehicle *u = front; u != nullptr; u = u->Next()) {
 				u->tick_counter++;
@@ -1696,6 +1715,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_AIRCRAFT);
 		for (Aircraft *front : _tick_aircraft_front_cache) {
 			v = front;
+			VehicleTickCostMeasurer cost(front->index);
 			if (!front->Aircraft::Tick()) continue;
 			for (Aircraft *u = front; u != nullptr; u = u->Next()) {
 				VehicleTickCargoAging(u);
@@ -1708,6 +1728,7 @@ void CallVehicleTicks()
 		PerformanceMeasurer framerate(PFE_GL_SHIPS);
 		for (Ship *s : _tick_ship_front_cache) {
 			v = s;
+			VehicleTickCostMeasurer cost(s->index);
 			if (!s->Ship::Tick()) continue;
 			for (Ship *u = s; u != nullptr; u = u->Next()) {
 				VehicleTickCargoAging(u);
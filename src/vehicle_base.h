@@ -253,6 +253,8 @@ struct VehicleUnbunchState {
 	Ticks round_trip_time = 0;                                        ///< How many ticks for a single circumnavigation of the orders.
 };
 
+uint64_t GetNextVehicleNewGRFCacheGeneration();
+
 /** %Vehicle data structure. */
 struct Vehicle : VehiclePool::PoolItem<&_vehicle_pool>, BaseVehicle, BaseConsist {
 	/* These are here for structure packing purposes */
@@ -383,6 +385,7 @@ public:
 	OrderList *orders = nullptr;                 ///< Pointer to the order list for this vehicle
 
 	NO_UNIQUE_ADDRESS NewGRFCache grf_cache{};   ///< Cache of often used calculated NewGRF values
+	uint64_t newgrf_cache_generation = 0;        ///< NOSAVE: Changed whenever #grf_cache is invalidated, unique over all vehicles, see ResolverObject::ResolveMemoisedCallback
 	Direction cur_image_valid_dir = INVALID_DIR; ///< NOSAVE: direction for which cur_image does not need to be regenerated on the next tick
 
 	VehicleCache vcache{};                       ///< Cache of often used vehicle values.
@@ -569,6 +572,7 @@ public:
 	inline void InvalidateNewGRFCache()
 	{
 		this->grf_cache.cache_valid = 0;
+		this->newgrf_cache_generation = GetNextVehicleNewGRFCacheGeneration();
 	}
 
 	/**
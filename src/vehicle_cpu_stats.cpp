@@ -0,0 +1,210 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file vehicle_cpu_stats.cpp Sampling of the CPU time spent ticking and pathfinding for each vehicle. */
+
+#include "stdafx.h"
+#include "vehicle_cpu_stats.h"
+#include "vehicle_base.h"
+#include "group.h"
+#include "order_base.h"
+#include "date_func.h"
+#include "strings_func.h"
+#include "core/format.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "table/strings.h"
+
+#include "safeguards.h"
+
+bool _vehicle_cpu_stats_sampling = false; ///< Whether the costs of vehicles are measured in the current tick.
+
+static bool _vehicle_cpu_stats_enabled = false;       ///< Whether vehicle costs are being sampled.
+static uint _vehicle_cpu_stats_interval = 1;          ///< Sample every this many ticks.
+static uint64_t _vehicle_cpu_stats_sampled_ticks = 0; ///< Number of sampled ticks since the statistics were cleared.
+static std::vector<VehicleCpuStats> _vehicle_cpu_stats; ///< Statistics of each vehicle, indexed by vehicle ID.
+
+static VehicleCpuStats &GetVehicleCpuStats(VehicleID veh)
+{
+	if (veh.base() >= _vehicle_cpu_stats.size()) _vehicle_cpu_stats.resize(veh.base() + 1);
+	return _vehicle_cpu_stats[veh.base()];
+}
+
+/**
+ * Add the time of one tick of a vehicle.
+ * @param veh The front vehicle.
+ * @param duration The time in nanoseconds.
+ */
+void RecordVehicleTickCost(VehicleID veh, int64_t duration)
+{
+	VehicleCpuStats &stats = GetVehicleCpuStats(veh);
+	stats.tick_ns += duration;
+	stats.ticks++;
+}
+
+/**
+ * Add the cost of one pathfinder call of a vehicle.
+ * @param veh The front vehicle.
+ * @param duration The time in nanoseconds.
+ * @param nodes The number of nodes searched.
+ */
+void RecordVehiclePathfinderCost(VehicleID veh, int64_t duration, uint nodes)
+{
+	VehicleCpuStats &stats = GetVehicleCpuStats(veh);
+	stats.pathfinder_ns += duration;
+	stats.pathfinder_calls++;
+	stats.pathfinder_nodes += nodes;
+}
+
+/**
+ * Start sampling the costs of vehicles.
+ * @param interval Sample every this many ticks.
+ */
+void StartVehicleCpuStats(uint interval)
+{
+	_vehicle_cpu_stats_enabled = true;
+	_vehicle_cpu_stats_interval = std::max<uint>(interval, 1);
+}
+
+/** Stop sampling the costs of vehicles, the statistics are kept. */
+void StopVehicleCpuStats()
+{
+	_vehicle_cpu_stats_enabled = false;
+	_vehicle_cpu_stats_sampling = false;
+}
+
+/** Discard the statistics of all vehicles. */
+void ClearVehicleCpuStats()
+{
+	_vehicle_cpu_stats.clear();
+	_vehicle_cpu_stats_sampled_ticks = 0;
+}
+
+/**
+ * Discard the statistics of a vehicle, so that they are not attributed to a later vehicle with the same ID.
+ * @param veh The vehicle.
+ */
+void ResetVehicleCpuStats(VehicleID veh)
+{
+	VehicleTickCostMeasurer::Cancel(veh);
+	if (veh.base() < _vehicle_cpu_stats.size()) _vehicle_cpu_stats[veh.base()] = {};
+}
+
+/** Decide whether the current tick is sampled, this must be called once per tick before the vehicles are ticked. */
+void UpdateVehicleCpuStatsSampling()
+{
+	_vehicle_cpu_stats_sampling = _vehicle_cpu_stats_enabled && (_scaled_tick_counter % _vehicle_cpu_stats_interval) == 0;
+	if (_vehicle_cpu_stats_sampling) _vehicle_cpu_stats_sampled_ticks++;
+}
+
+/**
+ * Get the number of sampled ticks since the statistics were cleared.
+ * @return The number of ticks.
+ */
+uint64_t GetVehicleCpuStatsSampledTicks()
+{
+	return _vehicle_cpu_stats_sampled_ticks;
+}
+
+/**
+ * Get the statistics of all current vehicles which have been measured, in order of their index.
+ * @return The vehicles and their statistics.
+ */
+std::vector<std::pair<const Vehicle *, VehicleCpuStats>> GetSampledVehicleCpuStats()
+{
+	std::vector<std::pair<const Vehicle *, VehicleCpuStats>> result;
+	for (size_t i = 0; i < _vehicle_cpu_stats.size(); i++) {
+		const VehicleCpuStats &stats = _vehicle_cpu_stats[i];
+		if (stats.IsEmpty()) continue;
+		const Vehicle *v = Vehicle::GetIfValid(i);
+		if (v != nullptr) result.emplace_back(v, stats);
+	}
+	return result;
+}
+
+/**
+ * Write the statistics of the vehicles, aggregated and sorted by decreasing tick time.
+ * @param buffer The output.
+ * @param grouping How to aggregate the vehicles.
+ * @param count The maximum number of lines to write.
+ */
+void DumpVehicleCpuStats(format_target &buffer, VehicleCpuStatsGrouping grouping, uint count)
+{
+	/* Keys are the owner, group, order list or vehicle index, depending on the grouping. */
+	std::map<uint32_t, VehicleCpuStats> aggregates;
+	VehicleCpuStats totals{};
+	for (const auto &[v, stats] : GetSampledVehicleCpuStats()) {
+		uint32_t key = 0;
+		switch (grouping) {
+			case VehicleCpuStatsGrouping::Company: key = v->owner.base(); break;
+			case VehicleCpuStatsGrouping::Group: key = v->group_id.base(); break;
+			case VehicleCpuStatsGrouping::OrderList: key = v->orders != nullptr ? v->orders->index.base() : UINT32_MAX; break;
+			case VehicleCpuStatsGrouping::Vehicle: key = v->index.base(); break;
+		}
+		VehicleCpuStats &aggregate = aggregates[key];
+		aggregate += stats;
+		aggregate.vehicles++;
+		totals += stats;
+		totals.vehicles++;
+	}
+
+	std::vector<std::pair<uint32_t, VehicleCpuStats>> sorted(aggregates.begin(), aggregates.end());
+	std::ranges::sort(sorted, [](const auto &a, const auto &b) { return a.second.tick_ns > b.second.tick_ns; });
+	if (sorted.size() > count) sorted.resize(count);
+
+	auto print_stats = [&](const VehicleCpuStats &stats) {
+		buffer.format("    vehicles: {}, tick: {:.3f} ms ({:.2f} us/tick), pathfinder: {:.3f} ms, calls: {}, nodes: {}\n",
+				stats.vehicles, stats.tick_ns / 1000000.0, stats.ticks == 0 ? 0.0 : stats.tick_ns / (1000.0 * stats.ticks),
+				stats.pathfinder_ns / 1000000.0, stats.pathfinder_calls, stats.pathfinder_nodes);
+	};
+
+	buffer.format("Sampled ticks: {}, interval: {}, sampling: {}\n", _vehicle_cpu_stats_sampled_ticks, _vehicle_cpu_stats_interval, _vehicle_cpu_stats_enabled ? "on" : "off");
+	for (const auto &[key, stats] : sorted) {
+		switch (grouping) {
+			case VehicleCpuStatsGrouping::Company: {
+				const Owner owner = static_cast<Owner>(key);
+				buffer.format("{}: ", owner);
+				AppendStringInPlace(buffer, STR_COMPANY_NAME, owner);
+				break;
+			}
+
+			case VehicleCpuStatsGrouping::Group: {
+				const GroupID group = static_cast<GroupID>(key);
+				if (group == DEFAULT_GROUP) {
+					buffer.append("Ungrouped");
+				} else {
+					const Group *g = Group::GetIfValid(group);
+					buffer.format("Group {}", group);
+					if (g != nullptr) buffer.format(", company {}: {}", g->owner, g->name);
+				}
+				break;
+			}
+
+			case VehicleCpuStatsGrouping::OrderList:
+				if (key == UINT32_MAX) {
+					buffer.append("No orders");
+				} else {
+					const OrderList *list = OrderList::Get(key);
+					buffer.format("Order list {}: {} orders, first vehicle: {}", key, list->GetNumOrders(), list->GetFirstSharedVehicle()->index);
+				}
+				break;
+
+			case VehicleCpuStatsGrouping::Vehicle: {
+				const Vehicle *v = Vehicle::Get(key);
+				buffer.format("Vehicle {}: unit {}, company {}, group {}", v->index, v->unitnumber, v->owner, v->group_id);
+				break;
+			}
+		}
+		buffer.push_back('\n');
+		print_stats(stats);
+	}
+	buffer.append("Totals\n");
+	print_stats(totals);
+}
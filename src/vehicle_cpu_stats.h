@@ -0,0 +1,140 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file vehicle_cpu_stats.h Sampling of the CPU time spent ticking and pathfinding for each vehicle. */
+
+#ifndef VEHICLE_CPU_STATS_H
+#define VEHICLE_CPU_STATS_H
+
+#include "vehicle_type.h"
+#include "debug_trace.h"
+
+#include <vector>
+
+extern bool _vehicle_cpu_stats_sampling;
+
+void RecordVehicleTickCost(VehicleID veh, int64_t duration);
+void RecordVehiclePathfinderCost(VehicleID veh, int64_t duration, uint nodes);
+
+/**
+ * RAII class which adds the time from construction to destruction to the tick cost of a vehicle, in sampled ticks.
+ * When the vehicle is deleted during the measurement, nothing is recorded.
+ */
+class VehicleTickCostMeasurer {
+	static inline VehicleTickCostMeasurer *current = nullptr; ///< The active measurer, vehicles are only ticked on the game thread.
+
+	VehicleID veh; ///< The vehicle, or VehicleID::Invalid() if this tick is not sampled.
+	int64_t start; ///< Start time of the measurement.
+
+public:
+	inline VehicleTickCostMeasurer(VehicleID veh) : veh(_vehicle_cpu_stats_sampling ? veh : VehicleID::Invalid()), start(0)
+	{
+		if (this->veh == VehicleID::Invalid()) return;
+		current = this;
+		this->start = TraceTimestamp();
+	}
+
+	inline ~VehicleTickCostMeasurer()
+	{
+		if (current != this) return;
+		current = nullptr;
+		if (this->veh != VehicleID::Invalid()) RecordVehicleTickCost(this->veh, TraceTimestamp() - this->start);
+	}
+
+	/**
+	 * Stop measuring a vehicle, because it is being deleted.
+	 * @param veh The vehicle.
+	 */
+	static inline void Cancel(VehicleID veh)
+	{
+		if (current != nullptr && current->veh == veh) current->veh = VehicleID::Invalid();
+	}
+
+	VehicleTickCostMeasurer(const VehicleTickCostMeasurer &) = delete;
+	VehicleTickCostMeasurer &operator=(const VehicleTickCostMeasurer &) = delete;
+};
+
+/**
+ * RAII class which adds the time from construction to destruction, and the nodes searched by the pathfinder, to the pathfinder cost of a vehicle, in sampled ticks.
+ * When pathfinder calls are nested, only the outermost call is measured.
+ */
+class VehiclePathfinderCostMeasurer {
+	static inline VehiclePathfinderCostMeasurer *current = nullptr; ///< The active measurer, pathfinding only happens on the game thread.
+
+	VehicleID veh;  ///< The vehicle, or VehicleID::Invalid() if not measuring.
+	int64_t start;  ///< Start time of the measurement.
+	uint nodes = 0; ///< Number of nodes searched so far.
+
+public:
+	inline VehiclePathfinderCostMeasurer(VehicleID veh) : veh(_vehicle_cpu_stats_sampling && current == nullptr ? veh : VehicleID::Invalid()), start(0)
+	{
+		if (this->veh == VehicleID::Invalid()) return;
+		current = this;
+		this->start = TraceTimestamp();
+	}
+
+	inline ~VehiclePathfinderCostMeasurer()
+	{
+		if (this->veh == VehicleID::Invalid()) return;
+		RecordVehiclePathfinderCost(this->veh, TraceTimestamp() - this->start, this->nodes);
+		current = nullptr;
+	}
+
+	/**
+	 * Add to the number of nodes searched by the measured pathfinder call, if any.
+	 * @param nodes The number of nodes.
+	 */
+	static inline void AddNodes(uint nodes)
+	{
+		if (current != nullptr) current->nodes += nodes;
+	}
+
+	VehiclePathfinderCostMeasurer(const VehiclePathfinderCostMeasurer &) = delete;
+	VehiclePathfinderCostMeasurer &operator=(const VehiclePathfinderCostMeasurer &) = delete;
+};
+
+/** Ways to aggregate the vehicle CPU statistics. */
+enum class VehicleCpuStatsGrouping : uint8_t {
+	Company,   ///< Per owner of the vehicles.
+	Group,     ///< Per vehicle group.
+	OrderList, ///< Per (shared) order list.
+	Vehicle,   ///< Per vehicle.
+};
+
+/** Statistics of one vehicle, or of an aggregate of vehicles. */
+struct VehicleCpuStats {
+	uint64_t tick_ns = 0;         ///< Time spent in the vehicle tick, including pathfinding.
+	uint64_t pathfinder_ns = 0;   ///< Time spent in the pathfinder.
+	uint32_t ticks = 0;           ///< Number of measured ticks.
+	uint32_t pathfinder_calls = 0; ///< Number of measured pathfinder calls.
+	uint64_t pathfinder_nodes = 0; ///< Number of nodes searched by the pathfinder.
+	uint vehicles = 0;            ///< Number of vehicles in an aggregate.
+
+	bool IsEmpty() const { return this->ticks == 0 && this->pathfinder_calls == 0; }
+
+	VehicleCpuStats &operator+=(const VehicleCpuStats &other)
+	{
+		this->tick_ns += other.tick_ns;
+		this->pathfinder_ns += other.pathfinder_ns;
+		this->ticks += other.ticks;
+		this->pathfinder_calls += other.pathfinder_calls;
+		this->pathfinder_nodes += other.pathfinder_nodes;
+		this->vehicles += other.vehicles;
+		return *this;
+	}
+};
+
+void StartVehicleCpuStats(uint interval);
+void StopVehicleCpuStats();
+void ClearVehicleCpuStats();
+void ResetVehicleCpuStats(VehicleID veh);
+void UpdateVehicleCpuStatsSampling();
+void DumpVehicleCpuStats(struct format_target &buffer, VehicleCpuStatsGrouping grouping, uint count);
+uint64_t GetVehicleCpuStatsSampledTicks();
+std::vector<std::pair<const Vehicle *, VehicleCpuStats>> GetSampledVehicleCpuStats();
+
+#endif /* VEHICLE_CPU_STATS_H */
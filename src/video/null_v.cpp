@@ -13,6 +13,11 @@
 #include "../sl/saveload.h"
 #include "../window_func.h"
 #include "../thread.h"
+#include "../openttd.h"
+#include "../framerate_type.h"
+#include "../fileio_func.h"
+#include "../survey.h"
+#include "../debug.h"
 #include "null_v.h"
 
 #include <atomic>
@@ -37,6 +42,7 @@ const char *VideoDriver_Null::Start(const StringList &parm)
 
 	this->ticks = GetDriverParamInt(parm, "ticks", 1000);
 	this->until_exit = GetDriverParamBool(parm, "until_exit");
+	this->benchmark_file = GetDriverParam(parm, "benchmark").value_or("");
 	_screen.width  = _screen.pitch = _cur_resolution.width;
 	_screen.height = _cur_resolution.height;
 	_screen.dst_ptr = nullptr;
@@ -62,11 +68,24 @@ void VideoDriver_Null::MainLoop()
 			::UpdateWindows();
 		}
 	} else {
+		std::optional<std::chrono::steady_clock::time_point> benchmark_start;
+		int benchmark_start_tick = 0;
 		for (int i = 0; i < this->ticks; i++) {
+			/* Only measure once the game to benchmark has been loaded. */
+			if (!this->benchmark_file.empty() && !benchmark_start.has_value() && _switch_mode == SM_NONE && _game_mode == GM_NORMAL) {
+				StartPerformanceBenchmark();
+				benchmark_start = std::chrono::steady_clock::now();
+				benchmark_start_tick = i;
+			}
 			::GameLoop();
 			::InputLoop();
 			::UpdateWindows();
 		}
+		if (benchmark_start.has_value()) {
+			this->WriteBenchmarkReport(this->ticks - benchmark_start_tick, std::chrono::steady_clock::now() - *benchmark_start);
+		} else if (!this->benchmark_file.empty()) {
+			Debug(misc, 0, "No game was running, not writing a benchmark report");
+		}
 	}
 
 	/* If requested, make a save just before exit. The normal exit-flow is
@@ -76,6 +95,36 @@ void VideoDriver_Null::MainLoop()
 	}
 }
 
+/**
+ * Write a JSON report of the performance measurements of the benchmarked ticks and of the final game state.
+ * @param ticks The number of benchmarked ticks.
+ * @param wall_time The duration of the benchmarked ticks.
+ */
+void VideoDriver_Null::WriteBenchmarkReport(int ticks, std::chrono::steady_clock::duration wall_time) const
+{
+	nlohmann::json report;
+
+	const double wall_time_ms = std::chrono::duration<double, std::milli>(wall_time).count();
+	report["ticks"] = ticks;
+	report["wall_time_ms"] = wall_time_ms;
+	report["ticks_per_second"] = wall_time_ms > 0 ? ticks * 1000.0 / wall_time_ms : 0.0;
+
+	SurveyPerformanceBenchmark(report["elements"]);
+	SurveyBenchmarkState(report);
+	SurveyTimers(report["timers"]);
+	SurveyOpenTTD(report["openttd"]);
+
+	auto f = FileHandle::Open(this->benchmark_file, "w");
+	if (!f.has_value()) {
+		Debug(misc, 0, "Unable to open benchmark report file: {}", this->benchmark_file);
+		return;
+	}
+	const std::string data = report.dump(4);
+	if (fwrite(data.data(), 1, data.size(), *f) != data.size()) {
+		Debug(misc, 0, "Unable to write benchmark report file: {}", this->benchmark_file);
+	}
+}
+
 bool VideoDriver_Null::ChangeResolution(int, int) { return false; }
 
 bool VideoDriver_Null::ToggleFullscreen(bool) { return false; }
@@ -12,11 +12,16 @@
 
 #include "video_driver.hpp"
 
+#include <chrono>
+
 /** The null video driver. */
 class VideoDriver_Null : public VideoDriver {
 private:
 	int ticks = 0; ///< Amount of ticks to run.
 	bool until_exit = false;
+	std::string benchmark_file; ///< File to write a benchmark report of the run ticks to, if not empty.
+
+	void WriteBenchmarkReport(int ticks, std::chrono::steady_clock::duration wall_time) const;
 
 public:
 	const char *Start(const StringList &param) override;
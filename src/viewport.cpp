@@ -102,6 +102,7 @@
 #include "command_func.h"
 #include "network/network_func.h"
 #include "framerate_type.h"
+#include "debug_trace.h"
 #include "depot_base.h"
 #include "tunnelbridge_map.h"
 #include "gui.h"
@@ -276,6 +277,24 @@ struct BridgeSetYComparator {
 	}
 };
 
+/** Bridges found while rendering the viewport map, keyed by their northern end. */
+struct ViewportMapBridgeSets {
+	btree::btree_map<TileIndex, TileIndex, BridgeSetXComparator> bridge_to_map_x;
+	btree::btree_map<TileIndex, TileIndex, BridgeSetYComparator> bridge_to_map_y;
+
+	void Clear()
+	{
+		this->bridge_to_map_x.clear();
+		this->bridge_to_map_y.clear();
+	}
+
+	void Merge(const ViewportMapBridgeSets &other)
+	{
+		this->bridge_to_map_x.insert(other.bridge_to_map_x.begin(), other.bridge_to_map_x.end());
+		this->bridge_to_map_y.insert(other.bridge_to_map_y.begin(), other.bridge_to_map_y.end());
+	}
+};
+
 using ChildStoreID = uint32_t;
 static constexpr ChildStoreID NO_CHILD_STORE = UINT32_MAX;
 static constexpr ChildStoreID CHILD_SPRITE_STORE_TAG = 1 << 31;
@@ -318,8 +337,7 @@ struct ViewportDrawerDynamic {
 	std::vector<ViewportProcessParentSpritesData> parent_sprite_sets;
 	ParentSpriteToDrawSubSpriteHolder parent_sprite_subsprites;
 	ChildScreenSpriteToDrawVector child_screen_sprites_to_draw;
-	btree::btree_map<TileIndex, TileIndex, BridgeSetXComparator> bridge_to_map_x;
-	btree::btree_map<TileIndex, TileIndex, BridgeSetYComparator> bridge_to_map_y;
+	ViewportMapBridgeSets map_bridges;
 
 	NWidgetDisplayFlags display_flags;
 
@@ -462,6 +480,7 @@ bool _draw_bounding_boxes = false;
 bool _draw_dirty_blocks = false;
 std::atomic<uint> _dirty_block_colour;
 static VpSpriteSorter _vp_sprite_sorter = nullptr;
+static VpSpriteSorter _vp_unbucketed_sprite_sorter = nullptr; ///< Best sprite sorter without spatial bucketing, for comparison purposes.
 
 const uint8_t *_pal2trsp_remap_ptr = nullptr;
 
@@ -483,6 +502,7 @@ enum ViewportDebugFlags {
 	VDF_SHOW_NO_LANDSCAPE_MAP_DRAW,
 	VDF_DISABLE_LANDSCAPE_CACHE,
 	VDF_DISABLE_THREAD,
+	VDF_DISABLE_BUCKET_SPRITE_SORTER,
 };
 uint32_t _viewport_debug_flags;
 
@@ -2285,7 +2305,13 @@ static bool ViewportSortParentSpritesChecker()
 	return true;
 }
 
-static void ViewportSortParentSpritesSingleComparison(ParentSpriteToDraw *ps, ParentSpriteToDraw *ps2, ParentSpriteToDraw *ps_to_move, ParentSpriteToDraw **psd, ParentSpriteToDraw **psd2)
+/**
+ * Check whether \a ps2 has to be drawn before \a ps, when sorting \a ps.
+ * @param ps The sprite currently being sorted.
+ * @param ps2 The sprite it is compared with.
+ * @return True if \a ps2 has to be moved in front of \a ps.
+ */
+static bool ViewportSortParentSpritesIsInFront(const ParentSpriteToDraw *ps, const ParentSpriteToDraw *ps2)
 {
 	/* Decide which comparator to use, based on whether the bounding
 	 * boxes overlap
@@ -2301,7 +2327,7 @@ static void ViewportSortParentSpritesSingleComparison(ParentSpriteToDraw *ps, Pa
 		 */
 		if (ps->xmin + ps->xmax + ps->ymin + ps->ymax + ps->zmin + ps->zmax <=
 				ps2->xmin + ps2->xmax + ps2->ymin + ps2->ymax + ps2->zmin + ps2->zmax) {
-			return;
+			return false;
 		}
 	} else {
 		/* We only change the order, if it is definite.
@@ -2311,23 +2337,32 @@ static void ViewportSortParentSpritesSingleComparison(ParentSpriteToDraw *ps, Pa
 		if (ps->xmax < ps2->xmin ||
 				ps->ymax < ps2->ymin ||
 				ps->zmax < ps2->zmin) {
-			return;
+			return false;
 		}
 	}
 
-	/* Move ps_to_move (ps2) in front of ps */
-	ParentSpriteToDraw *temp = ps_to_move;
+	return true;
+}
+
+/**
+ * Move the sprite at \a psd2 in front of the sprite at \a psd.
+ * @param psd Position to move to.
+ * @param psd2 Position of the sprite to move.
+ */
+static void ViewportSortParentSpritesMoveInFront(ParentSpriteToDraw **psd, ParentSpriteToDraw **psd2)
+{
+	ParentSpriteToDraw *temp = *psd2;
 	for (auto psd3 = psd2; psd3 > psd; psd3--) {
 		*psd3 = *(psd3 - 1);
 	}
 	*psd = temp;
 }
 
-bool ViewportSortParentSpritesSpecial(ParentSpriteToDraw *ps, ParentSpriteToDraw *ps2, ParentSpriteToDraw **psd, ParentSpriteToDraw **psd2)
+bool ViewportSortParentSpritesSpecialIsInFront(const ParentSpriteToDraw *ps, const ParentSpriteToDraw *ps2, bool &in_front)
 {
 	ParentSpriteToDraw temp;
 
-	auto is_bridge_diag_veh_comparison = [&](ParentSpriteToDraw *a, ParentSpriteToDraw *b) -> bool {
+	auto is_bridge_diag_veh_comparison = [&](const ParentSpriteToDraw *a, const ParentSpriteToDraw *b) -> bool {
 		if ((a->special_flags & VSSSF_SORT_SPECIAL_TYPE_MASK) == VSSSF_SORT_SORT_BRIDGE_BB && (b->special_flags & VSSSF_SORT_SPECIAL_TYPE_MASK) == VSSSF_SORT_DIAG_VEH && a->zmin > b->zmax) {
 			temp = *a;
 			temp.xmax += 4;
@@ -2338,17 +2373,26 @@ bool ViewportSortParentSpritesSpecial(ParentSpriteToDraw *ps, ParentSpriteToDraw
 	};
 
 	if (is_bridge_diag_veh_comparison(ps, ps2)) {
-		ViewportSortParentSpritesSingleComparison(&temp, ps2, ps2, psd, psd2);
+		in_front = ViewportSortParentSpritesIsInFront(&temp, ps2);
 		return true;
 	}
 	if (is_bridge_diag_veh_comparison(ps2, ps)) {
-		ViewportSortParentSpritesSingleComparison(ps, &temp, ps2, psd, psd2);
+		in_front = ViewportSortParentSpritesIsInFront(ps, &temp);
 		return true;
 	}
 
 	return false;
 }
 
+bool ViewportSortParentSpritesSpecial(ParentSpriteToDraw *ps, ParentSpriteToDraw *ps2, ParentSpriteToDraw **psd, ParentSpriteToDraw **psd2)
+{
+	bool in_front;
+	if (!ViewportSortParentSpritesSpecialIsInFront(ps, ps2, in_front)) return false;
+
+	if (in_front) ViewportSortParentSpritesMoveInFront(psd, psd2);
+	return true;
+}
+
 /** Sort parent sprites pointer array */
 static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 {
@@ -2374,7 +2418,7 @@ static void ViewportSortParentSprites(ParentSpriteToSortVector *psdv)
 				if (ViewportSortParentSpritesSpecial(ps, ps2, psd, psd2)) continue;
 			}
 
-			ViewportSortParentSpritesSingleComparison(ps, ps2, ps2, psd, psd2);
+			if (ViewportSortParentSpritesIsInFront(ps, ps2)) ViewportSortParentSpritesMoveInFront(psd, psd2);
 		}
 	}
 }
@@ -2428,7 +2472,7 @@ static void ViewportDrawBoundingBoxes(const DrawPixelInfo *dpi, const ParentSpri
 	}
 }
 
-static void ViewportMapStoreBridge(const Viewport * const vp, const TileIndex tile)
+static void ViewportMapStoreBridge(ViewportMapBridgeSets &bridges, const TileIndex tile)
 {
 	extern LegendAndColour _legend_land_owners[NUM_NO_COMPANY_ENTRIES + MAX_COMPANIES + 1];
 	extern TypedIndexContainer<std::array<uint32_t, MAX_COMPANIES>, CompanyID> _company_to_list_pos;
@@ -2441,41 +2485,41 @@ static void ViewportMapStoreBridge(const Viewport * const vp, const TileIndex ti
 	switch (GetTunnelBridgeDirection(tile)) {
 		case DIAGDIR_NE: {
 			/* X axis: tile at higher coordinate, facing towards lower coordinate */
-			auto iter = _vdd->bridge_to_map_x.lower_bound(tile);
-			if (iter != _vdd->bridge_to_map_x.begin()) {
+			auto iter = bridges.bridge_to_map_x.lower_bound(tile);
+			if (iter != bridges.bridge_to_map_x.begin()) {
 				auto prev = iter;
 				--prev;
 				if (prev->second == tile) return;
 			}
-			_vdd->bridge_to_map_x.insert(iter, std::make_pair(GetOtherTunnelBridgeEnd(tile), tile));
+			bridges.bridge_to_map_x.insert(iter, std::make_pair(GetOtherTunnelBridgeEnd(tile), tile));
 			break;
 		}
 
 		case DIAGDIR_NW: {
 			/* Y axis: tile at higher coordinate, facing towards lower coordinate */
-			auto iter = _vdd->bridge_to_map_y.lower_bound(tile);
-			if (iter != _vdd->bridge_to_map_y.begin()) {
+			auto iter = bridges.bridge_to_map_y.lower_bound(tile);
+			if (iter != bridges.bridge_to_map_y.begin()) {
 				auto prev = iter;
 				--prev;
 				if (prev->second == tile) return;
 			}
-			_vdd->bridge_to_map_y.insert(iter, std::make_pair(GetOtherTunnelBridgeEnd(tile), tile));
+			bridges.bridge_to_map_y.insert(iter, std::make_pair(GetOtherTunnelBridgeEnd(tile), tile));
 			break;
 		}
 
 		case DIAGDIR_SW: {
 			/* X axis: tile at lower coordinate, facing towards higher coordinate */
-			auto iter = _vdd->bridge_to_map_x.lower_bound(tile);
-			if (iter != _vdd->bridge_to_map_x.end() && iter->first == tile) return;
-			_vdd->bridge_to_map_x.insert(iter, std::make_pair(tile, GetOtherTunnelBridgeEnd(tile)));
+			auto iter = bridges.bridge_to_map_x.lower_bound(tile);
+			if (iter != bridges.bridge_to_map_x.end() && iter->first == tile) return;
+			bridges.bridge_to_map_x.insert(iter, std::make_pair(tile, GetOtherTunnelBridgeEnd(tile)));
 			break;
 		}
 
 		case DIAGDIR_SE: {
 			/* Y axis: tile at lower coordinate, facing towards higher coordinate */
-			auto iter = _vdd->bridge_to_map_y.lower_bound(tile);
-			if (iter != _vdd->bridge_to_map_y.end() && iter->first == tile) return;
-			_vdd->bridge_to_map_y.insert(iter, std::make_pair(tile, GetOtherTunnelBridgeEnd(tile)));
+			auto iter = bridges.bridge_to_map_y.lower_bound(tile);
+			if (iter != bridges.bridge_to_map_y.end() && iter->first == tile) return;
+			bridges.bridge_to_map_y.insert(iter, std::make_pair(tile, GetOtherTunnelBridgeEnd(tile)));
 			break;
 		}
 
@@ -3594,33 +3638,33 @@ static inline uint32_t ViewportMapGetColourRoutes(const TileIndex tile, TileType
 	return IS32(colour);
 }
 
-static inline void ViewportMapStoreBridgeAboveTile(const Viewport * const vp, const TileIndex tile)
+static inline void ViewportMapStoreBridgeAboveTile(ViewportMapBridgeSets &bridges, const TileIndex tile)
 {
 	/* No need to bother for hidden things */
 	if (!_settings_client.gui.show_bridges_on_map) return;
 
 	if (GetBridgeAxis(tile) == Axis::X) {
-		auto iter = _vdd->bridge_to_map_x.lower_bound(tile);
-		if (iter != _vdd->bridge_to_map_x.end() && iter->first < tile && iter->second > tile) return; /* already covered */
-		_vdd->bridge_to_map_x.insert(iter, std::make_pair(GetNorthernBridgeEnd(tile), GetSouthernBridgeEnd(tile)));
+		auto iter = bridges.bridge_to_map_x.lower_bound(tile);
+		if (iter != bridges.bridge_to_map_x.end() && iter->first < tile && iter->second > tile) return; /* already covered */
+		bridges.bridge_to_map_x.insert(iter, std::make_pair(GetNorthernBridgeEnd(tile), GetSouthernBridgeEnd(tile)));
 	} else {
-		auto iter = _vdd->bridge_to_map_y.lower_bound(tile);
-		if (iter != _vdd->bridge_to_map_y.end() && iter->first < tile && iter->second > tile) return; /* already covered */
-		_vdd->bridge_to_map_y.insert(iter, std::make_pair(GetNorthernBridgeEnd(tile), GetSouthernBridgeEnd(tile)));
+		auto iter = bridges.bridge_to_map_y.lower_bound(tile);
+		if (iter != bridges.bridge_to_map_y.end() && iter->first < tile && iter->second > tile) return; /* already covered */
+		bridges.bridge_to_map_y.insert(iter, std::make_pair(GetNorthernBridgeEnd(tile), GetSouthernBridgeEnd(tile)));
 	}
 }
 
-static inline TileIndex ViewportMapGetMostSignificantTileType(const Viewport * const vp, const TileIndex from_tile, TileType * const tile_type)
+static inline TileIndex ViewportMapGetMostSignificantTileType(const Viewport * const vp, ViewportMapBridgeSets &bridges, const TileIndex from_tile, TileType * const tile_type)
 {
 	if (vp->zoom <= ZoomLevel::Out32x) {
 		const TileType ttype = GetTileType(from_tile);
 		/* Store bridges and tunnels. */
 		if (ttype != TileType::TunnelBridge) {
 			*tile_type = ttype;
-			if (IsBridgeAbove(from_tile)) ViewportMapStoreBridgeAboveTile(vp, from_tile);
+			if (IsBridgeAbove(from_tile)) ViewportMapStoreBridgeAboveTile(bridges, from_tile);
 		} else {
 			if (IsBridge(from_tile)) {
-				ViewportMapStoreBridge(vp, from_tile);
+				ViewportMapStoreBridge(bridges, from_tile);
 			}
 			switch (GetTunnelBridgeTransportType(from_tile)) {
 				case TRANSPORT_RAIL:  *tile_type = TileType::Railway; break;
@@ -3647,7 +3691,7 @@ static inline TileIndex ViewportMapGetMostSignificantTileType(const Viewport * c
 			result = tile;
 		}
 		if (ttype != TileType::TunnelBridge && IsBridgeAbove(tile)) {
-			ViewportMapStoreBridgeAboveTile(vp, tile);
+			ViewportMapStoreBridgeAboveTile(bridges, tile);
 		}
 	}
 
@@ -3655,7 +3699,7 @@ static inline TileIndex ViewportMapGetMostSignificantTileType(const Viewport * c
 	*tile_type = GetTileType(result);
 	if (*tile_type == TileType::TunnelBridge) {
 		if (IsBridge(result)) {
-			ViewportMapStoreBridge(vp, result);
+			ViewportMapStoreBridge(bridges, result);
 		}
 		switch (GetTunnelBridgeTransportType(result)) {
 			case TRANSPORT_RAIL: *tile_type = TileType::Railway; break;
@@ -3674,7 +3718,7 @@ static uint32_t ViewportMapVoidColour()
 
 /** Get the colour of a tile, can be 32bpp RGB or 8bpp palette index. */
 template <bool is_32bpp, bool show_slope>
-uint32_t ViewportMapGetColour(const Viewport * const vp, int x, int y, const uint8_t colour_index)
+uint32_t ViewportMapGetColour(const Viewport * const vp, ViewportMapBridgeSets &bridges, int x, int y, const uint8_t colour_index)
 {
 	if (x >= static_cast<int>(Map::MaxX() * TILE_SIZE) || y >= static_cast<int>(Map::MaxY() * TILE_SIZE)) return ViewportMapVoidColour();
 
@@ -3698,7 +3742,7 @@ uint32_t ViewportMapGetColour(const Viewport * const vp, int x, int y, const uin
 		if (tile >= Map::Size()) return ViewportMapVoidColour();
 	}
 	TileType tile_type = TileType::Void;
-	tile = ViewportMapGetMostSignificantTileType(vp, tile, &tile_type);
+	tile = ViewportMapGetMostSignificantTileType(vp, bridges, tile, &tile_type);
 	if (tile_type == TileType::Void) return ViewportMapVoidColour();
 
 	/* Return the colours. */
@@ -3904,6 +3948,9 @@ static void ViewportMapDrawBridgeTunnel(Viewport * const vp, const TunnelBridgeT
 	}
 }
 
+static constexpr int VIEWPORT_MAP_BAND_MIN_LINES = 32; ///< Minimum number of lines in a band of the viewport map which is rendered by a worker thread.
+static constexpr uint VIEWPORT_MAP_BAND_MAX_COUNT = 16; ///< Maximum number of bands of the viewport map to render concurrently.
+
 /** Draw the map on a viewport. */
 template <bool is_32bpp, bool show_slope>
 void ViewportMapDraw(Viewport * const vp)
@@ -3923,54 +3970,80 @@ void ViewportMapDraw(Viewport * const vp)
 	const  int sx = UnScaleByZoomLower(_vdd->dpi.left, _vdd->dpi.zoom);
 	const  int sy = UnScaleByZoomLower(_vdd->dpi.top, _vdd->dpi.zoom);
 	const uint line_padding = 2 * (sy & 1);
-	uint8_t    colour_index_base = static_cast<uint8_t>((sx + line_padding) & 3);
+	const uint8_t colour_index_base = static_cast<uint8_t>((sx + line_padding) & 3);
 
 	const  int incr_a = (1 << (to_underlying(vp->zoom) - 2)) / ZOOM_BASE;
 	const  int incr_b = (1 << (to_underlying(vp->zoom) - 1)) / ZOOM_BASE;
 	const  int a = (_vdd->dpi.left >> 2) / ZOOM_BASE;
-	int        b = (_vdd->dpi.top >> 1) / ZOOM_BASE;
+	const  int b_start = (_vdd->dpi.top >> 1) / ZOOM_BASE;
 	const  int w = UnScaleByZoom(_vdd->dpi.width, vp->zoom);
 	const  int h = UnScaleByZoom(_vdd->dpi.height, vp->zoom);
-	int        j = 0;
 
 	const int land_cache_start = _vdd->offset_x + (_vdd->offset_y * vp->width);
-	uint32_t *land_cache_ptr32 = reinterpret_cast<uint32_t *>(vp->land_pixel_cache.data()) + land_cache_start;
-	uint8_t *land_cache_ptr8 = reinterpret_cast<uint8_t *>(vp->land_pixel_cache.data()) + land_cache_start;
-
-	bool cache_updated = false;
 
-	/* Render base map. */
-	do { // For each line
-		int i = w;
-		uint8_t colour_index = colour_index_base;
-		colour_index_base ^= 2;
-		int c = b - a;
-		int d = b + a;
-		do { // For each pixel of a line
-			if (is_32bpp) {
-				if (*land_cache_ptr32 == 0xD7D7D7D7) {
-					*land_cache_ptr32 = ViewportMapGetColour<is_32bpp, show_slope>(vp, c, d, colour_index);
-					cache_updated = true;
+	/* Render base map, in horizontal bands of lines which may be processed concurrently.
+	 * Each band collects the bridges it finds separately, these are merged in band order afterwards. */
+	const uint band_count = (HasBit(_viewport_debug_flags, VDF_DISABLE_THREAD) || h < 2 * VIEWPORT_MAP_BAND_MIN_LINES) ? 1 : std::min<uint>(h / VIEWPORT_MAP_BAND_MIN_LINES, VIEWPORT_MAP_BAND_MAX_COUNT);
+	std::array<ViewportMapBridgeSets, VIEWPORT_MAP_BAND_MAX_COUNT> band_bridges;
+	std::array<bool, VIEWPORT_MAP_BAND_MAX_COUNT> band_cache_updated{};
+
+	auto render_band = [&](uint band) {
+		const int j_start = (h * band) / band_count;
+		const int j_end = (h * (band + 1)) / band_count;
+		ViewportMapBridgeSets &bridges = band_bridges[band];
+		bool updated = false;
+
+		uint8_t line_colour_index_base = colour_index_base ^ ((j_start & 1) ? 2 : 0);
+		int b = b_start + (j_start * incr_b);
+		uint32_t *land_cache_ptr32 = reinterpret_cast<uint32_t *>(vp->land_pixel_cache.data()) + land_cache_start + (j_start * vp->width);
+		uint8_t *land_cache_ptr8 = reinterpret_cast<uint8_t *>(vp->land_pixel_cache.data()) + land_cache_start + (j_start * vp->width);
+
+		for (int j = j_start; j < j_end; j++) { // For each line
+			int i = w;
+			uint8_t colour_index = line_colour_index_base;
+			line_colour_index_base ^= 2;
+			int c = b - a;
+			int d = b + a;
+			do { // For each pixel of a line
+				if (is_32bpp) {
+					if (*land_cache_ptr32 == 0xD7D7D7D7) {
+						*land_cache_ptr32 = ViewportMapGetColour<is_32bpp, show_slope>(vp, bridges, c, d, colour_index);
+						updated = true;
+					}
+					land_cache_ptr32++;
+				} else {
+					if (*land_cache_ptr8 == 0xD7) {
+						*land_cache_ptr8 = (uint8_t) ViewportMapGetColour<is_32bpp, show_slope>(vp, bridges, c, d, colour_index);
+						updated = true;
+					}
+					land_cache_ptr8++;
 				}
-				land_cache_ptr32++;
+				colour_index = (colour_index + 1) & 3;
+				c -= incr_a;
+				d += incr_a;
+			} while (--i);
+			if (is_32bpp) {
+				land_cache_ptr32 += (vp->width - w);
 			} else {
-				if (*land_cache_ptr8 == 0xD7) {
-					*land_cache_ptr8 = (uint8_t) ViewportMapGetColour<is_32bpp, show_slope>(vp, c, d, colour_index);
-					cache_updated = true;
-				}
-				land_cache_ptr8++;
+				land_cache_ptr8 += (vp->width - w);
 			}
-			colour_index = (colour_index + 1) & 3;
-			c -= incr_a;
-			d += incr_a;
-		} while (--i);
-		if (is_32bpp) {
-			land_cache_ptr32 += (vp->width - w);
-		} else {
-			land_cache_ptr8 += (vp->width - w);
+			b += incr_b;
 		}
-		b += incr_b;
-	} while (++j < h);
+		band_cache_updated[band] = updated;
+	};
+
+	if (band_count == 1) {
+		render_band(0);
+	} else {
+		_general_worker_pool.ParallelFor(band_count, render_band);
+	}
+
+	bool cache_updated = false;
+	for (uint band = 0; band < band_count; band++) {
+		if (!band_cache_updated[band]) continue;
+		cache_updated = true;
+		_vdd->map_bridges.Merge(band_bridges[band]);
+	}
 
 	auto draw_tunnels = [&](const int y_intercept_min, const int y_intercept_max, const TunnelToMapStorage &storage) {
 		auto iter = std::lower_bound(storage.tunnels.begin(), storage.tunnels.end(), y_intercept_min, [](const TunnelToMap &a, int b) -> bool {
@@ -4008,14 +4081,14 @@ void ViewportMapDraw(Viewport * const vp)
 		}
 
 		/* Render bridges */
-		if (_settings_client.gui.show_bridges_on_map && _vdd->bridge_to_map_x.size() != 0) {
-			for (const auto &it : _vdd->bridge_to_map_x) { // For each bridge
+		if (_settings_client.gui.show_bridges_on_map && _vdd->map_bridges.bridge_to_map_x.size() != 0) {
+			for (const auto &it : _vdd->map_bridges.bridge_to_map_x) { // For each bridge
 				TunnelBridgeToMap tbtm { it.first, it.second };
 				ViewportMapDrawBridgeTunnel<is_32bpp>(vp, &tbtm, (GetBridgeHeight(tbtm.from_tile) - 1) * TILE_HEIGHT, false, w, h, blitter);
 			}
 		}
-		if (_settings_client.gui.show_bridges_on_map && _vdd->bridge_to_map_y.size() != 0) {
-			for (const auto &it : _vdd->bridge_to_map_y) { // For each bridge
+		if (_settings_client.gui.show_bridges_on_map && _vdd->map_bridges.bridge_to_map_y.size() != 0) {
+			for (const auto &it : _vdd->map_bridges.bridge_to_map_y) { // For each bridge
 				TunnelBridgeToMap tbtm { it.first, it.second };
 				ViewportMapDrawBridgeTunnel<is_32bpp>(vp, &tbtm, (GetBridgeHeight(tbtm.from_tile) - 1) * TILE_HEIGHT, false, w, h, blitter);
 			}
@@ -4102,10 +4175,34 @@ static void ViewportProcessParentSprites(ViewportDrawerDynamic *vdd, uint data_i
 			ViewportProcessParentSprites(vdd, data_index);
 		}
 	} else {
-		_vp_sprite_sorter(&data->psts);
+		if (unlikely(HasBit(_viewport_debug_flags, VDF_DISABLE_BUCKET_SPRITE_SORTER))) {
+			_vp_unbucketed_sprite_sorter(&data->psts);
+		} else {
+			_vp_sprite_sorter(&data->psts);
+		}
 	}
 }
 
+/**
+ * Load the sprites of the draw lists which are not yet in the sprite cache, in parallel, before they are stored for the render job.
+ * @param vdd Viewport drawer with the filled draw lists.
+ */
+static void ViewportPrefetchSprites(ViewportDrawerDynamic *vdd)
+{
+	std::vector<SpriteID> sprites;
+	sprites.reserve(vdd->tile_sprites_to_draw.size() + vdd->parent_sprites_to_draw.size() + vdd->child_screen_sprites_to_draw.size());
+	for (const TileSpriteToDraw &ts : vdd->tile_sprites_to_draw) {
+		sprites.push_back(GB(ts.image, 0, SPRITE_WIDTH));
+	}
+	for (const ParentSpriteToDraw &ps : vdd->parent_sprites_to_draw) {
+		if (ps.image != SPR_EMPTY_BOUNDING_BOX) sprites.push_back(GB(ps.image, 0, SPRITE_WIDTH));
+	}
+	for (const ChildScreenSpriteToDraw &cs : vdd->child_screen_sprites_to_draw) {
+		sprites.push_back(GB(cs.image, 0, SPRITE_WIDTH));
+	}
+	PrefetchSprites(sprites, LowZoomMask(vdd->dpi.zoom));
+}
+
 static void ViewportDoDrawPhase2(Viewport *vp, ViewportDrawerDynamic *vdd);
 static void ViewportDoDrawPhase3(Viewport *vp);
 static void ViewportDoDrawRenderJob(Viewport *vp, ViewportDrawerDynamic *vdd);
@@ -4113,6 +4210,7 @@ static void ViewportDoDrawRenderJob(Viewport *vp, ViewportDrawerDynamic *vdd);
 /* This is run in the main thread */
 void ViewportDoDraw(Viewport *vp, int left, int top, int right, int bottom, NWidgetDisplayFlags display_flags)
 {
+	TraceZone trace_zone("Viewport collect");
 	if (_spare_viewport_drawers.empty()) {
 		_vdd.reset(new ViewportDrawerDynamic());
 	} else {
@@ -4219,6 +4317,8 @@ void ViewportDoDraw(Viewport *vp, int left, int top, int right, int bottom, NWid
 		ViewportAddLandscape();
 		ViewportAddVehicles(&_vdd->dpi, vp->update_vehicles);
 
+		if (!HasBit(_viewport_debug_flags, VDF_DISABLE_THREAD)) ViewportPrefetchSprites(_vdd.get());
+
 		for (const TileSpriteToDraw &ts : _vdd->tile_sprites_to_draw) {
 			PrepareDrawSpriteViewportSpriteStore(_vdd->sprite_data, &_vdd->dpi, ts.image, ts.pal);
 		}
@@ -4241,6 +4341,7 @@ void ViewportDoDraw(Viewport *vp, int left, int top, int right, int bottom, NWid
 
 /* This is run in a worker thread */
 static void ViewportDoDrawRenderSubJob(Viewport *vp, ViewportDrawerDynamic *vdd, uint data_index) {
+	TraceZone trace_zone("Viewport draw parent sprites");
 	ViewportDrawParentSprites(vdd, &vdd->parent_sprite_sets[data_index].dpi, &vdd->parent_sprite_sets[data_index].psts, &vdd->child_screen_sprites_to_draw);
 
 	if (_draw_dirty_blocks && HasBit(_viewport_debug_flags, VDF_DIRTY_BLOCK_PER_SPLIT)) {
@@ -4265,6 +4366,7 @@ static void ViewportDoDrawRenderSubJob(Viewport *vp, ViewportDrawerDynamic *vdd,
 /* This is run in a worker thread */
 static void ViewportDoDrawRenderJob(Viewport *vp, ViewportDrawerDynamic *vdd)
 {
+	TraceZone trace_zone("Viewport render");
 	ViewportAddKdtreeSigns(vdd, &vdd->dpi, false);
 
 	DrawTextEffects(vdd, &vdd->dpi, vdd->IsTransparencySet(TO_LOADING));
@@ -4327,6 +4429,7 @@ void ViewportDoDrawProcessAllPending()
 /* This may be run either in a worker thread, or in the main thead */
 static void ViewportDoDrawPhase2(Viewport *vp, ViewportDrawerDynamic *vdd)
 {
+	TraceZone trace_zone("Viewport overlays");
 	if (_draw_dirty_blocks && !(HasBit(_viewport_debug_flags, VDF_DIRTY_BLOCK_PER_SPLIT) && vp->zoom < ZoomLevel::DrawMap)) {
 		ViewportDrawDirtyBlocks(&vdd->dpi, HasBit(_viewport_debug_flags, VDF_DIRTY_BLOCK_PER_DRAW));
 	}
@@ -4355,6 +4458,7 @@ static void ViewportDoDrawPhase2(Viewport *vp, ViewportDrawerDynamic *vdd)
 /* This is run in the main thread */
 static void ViewportDoDrawPhase3(Viewport *vp)
 {
+	TraceZone trace_zone("Viewport strings and plans");
 	DrawPixelInfo dp = _vdd->dpi;
 	ZoomLevel zoom = _vdd->dpi.zoom;
 	dp.zoom = ZoomLevel::Min;
@@ -4389,8 +4493,7 @@ static void ViewportDoDrawPhase3(Viewport *vp)
 				_vdd->display_flags.Test(NWidgetDisplayFlag::ShadeDimmed) ? PALETTE_TO_TRANSPARENT : PALETTE_NEWSPAPER, FillRectMode::Recolour);
 	}
 
-	_vdd->bridge_to_map_x.clear();
-	_vdd->bridge_to_map_y.clear();
+	_vdd->map_bridges.Clear();
 	_vdd->string_sprites_to_draw.clear();
 	_vdd->tile_sprites_to_draw.clear();
 	_vdd->parent_sprites_to_draw.clear();
@@ -4838,6 +4941,8 @@ void MarkAllViewportMapsDirty(int left, int top, int right, int bottom)
 
 void MarkAllViewportMapLandscapesDirty()
 {
+	InvalidateSmallMapColourCache();
+
 	for (Window *w : Window::Iterate()) {
 		Viewport *vp = w->viewport;
 		if (vp != nullptr && vp->zoom >= ZoomLevel::DrawMap) {
@@ -4894,6 +4999,8 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridge_level_offset, int tile_height_override)
 {
+	if (!(flags & (VMDF_NOT_MAP_MODE | VMDF_NOT_LANDSCAPE))) MarkSmallMapTileDirty(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - 31  * ZOOM_BASE,
@@ -4906,6 +5013,8 @@ void MarkTileDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags, int bridg
 
 void MarkTileGroundDirtyByTile(TileIndex tile, ViewportMarkDirtyFlags flags)
 {
+	if (!(flags & (VMDF_NOT_MAP_MODE | VMDF_NOT_LANDSCAPE))) MarkSmallMapTileDirty(tile);
+
 	int x = TileX(tile) * TILE_SIZE;
 	int y = TileY(tile) * TILE_SIZE;
 	Point top = RemapCoords(x, y, GetTileMaxPixelZ(tile));
@@ -6965,26 +7074,33 @@ Point GetViewportStationMiddle(const Viewport *vp, const Station *st)
 struct ViewportSSCSS {
 	VpSorterChecker fct_checker; ///< The check function.
 	VpSpriteSorter fct_sorter;   ///< The sorting function.
+	bool bucketed;               ///< Whether the sorter uses spatial bucketing.
 };
 
 /** List of sorters ordered from best to worst. */
 static const ViewportSSCSS _vp_sprite_sorters[] = {
 #ifdef WITH_SSE
-	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41 },
+	{ &ViewportSortParentSpritesAVX2Checker, &ViewportSortParentSpritesAVX2, true },
+	{ &ViewportSortParentSpritesSSE41Checker, &ViewportSortParentSpritesSSE41, false },
 #endif
-	{ &ViewportSortParentSpritesChecker, &ViewportSortParentSprites }
+	{ &ViewportSortParentSpritesChecker, &ViewportSortParentSprites, false }
 };
 
-/** Choose the "best" sprite sorter and set _vp_sprite_sorter. */
+/** Choose the "best" sprite sorter and set _vp_sprite_sorter, and the best one without spatial bucketing. */
 void InitializeSpriteSorter()
 {
+	_vp_sprite_sorter = nullptr;
 	for (const auto &sprite_sorter : _vp_sprite_sorters) {
 		if (sprite_sorter.fct_checker()) {
-			_vp_sprite_sorter = sprite_sorter.fct_sorter;
-			break;
+			if (_vp_sprite_sorter == nullptr) _vp_sprite_sorter = sprite_sorter.fct_sorter;
+			if (!sprite_sorter.bucketed) {
+				_vp_unbucketed_sprite_sorter = sprite_sorter.fct_sorter;
+				break;
+			}
 		}
 	}
 	dbg_assert(_vp_sprite_sorter != nullptr);
+	dbg_assert(_vp_unbucketed_sprite_sorter != nullptr);
 }
 
 /**
@@ -92,10 +92,13 @@ typedef bool (*VpSorterChecker)();
 typedef void (*VpSpriteSorter)(ParentSpriteToSortVector *psd);
 
 bool ViewportSortParentSpritesSpecial(ParentSpriteToDraw *ps, ParentSpriteToDraw *ps2, ParentSpriteToDraw **psd, ParentSpriteToDraw **psd2);
+bool ViewportSortParentSpritesSpecialIsInFront(const ParentSpriteToDraw *ps, const ParentSpriteToDraw *ps2, bool &in_front);
 
 #ifdef WITH_SSE
 bool ViewportSortParentSpritesSSE41Checker();
 void ViewportSortParentSpritesSSE41(ParentSpriteToSortVector *psdv);
+bool ViewportSortParentSpritesAVX2Checker();
+void ViewportSortParentSpritesAVX2(ParentSpriteToSortVector *psdv);
 #endif
 
 void InitializeSpriteSorter();
@@ -0,0 +1,270 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file viewport_sprite_sorter_avx2.cpp Sprite sorter that uses AVX2 and spatial bucketing. */
+
+#ifdef WITH_SSE
+
+#include "stdafx.h"
+#include "cpu.h"
+#include "immintrin.h"
+#include "viewport_sprite_sorter.h"
+#include "viewport_func.h"
+#include "core/math_func.hpp"
+
+#include "safeguards.h"
+
+/**
+ * This sorter produces exactly the same order as ViewportSortParentSprites and ViewportSortParentSpritesSSE41.
+ *
+ * Those sort each sprite in turn by scanning all later sprites which are not yet done,
+ * and moving each sprite which has to be drawn before it to the front.
+ * The result of one scan is therefore: the moved sprites in reverse order, the sorted sprite, and then the remaining sprites in their previous order.
+ *
+ * The bounding boxes are kept in a structure of arrays in the current draw order, so that 8 sprites can be compared at once.
+ * Runs of #SPRITE_SORTER_BUCKET_SIZE consecutive sprites form a bucket, which keeps the lowest minimum X, Y and Z of its sprites.
+ * As nearby sprites are added to the draw list in close succession, most buckets are spatially compact,
+ * and a whole bucket can be skipped when all of its sprites are in front of the sorted sprite on one of the axes.
+ */
+
+static constexpr uint SPRITE_SORTER_LANES = 8;             ///< Number of sprites compared at once.
+static constexpr uint SPRITE_SORTER_BUCKET_SIZE = 32;      ///< Number of consecutive sprites in a bucket, must be a multiple of #SPRITE_SORTER_LANES.
+static constexpr uint SPRITE_SORTER_MIN_SPRITES = 256;     ///< Below this number of sprites, the unbucketed sorter is faster.
+static constexpr int32_t SPRITE_SORTER_SPECIAL_MARGIN = 4; ///< Extent by which a special bounding box may be enlarged, see ViewportSortParentSpritesSpecialIsInFront.
+static constexpr int32_t SPRITE_SORTER_DONE = INT32_MAX;   ///< Minimum X of sprites which are done, so that they are always in front.
+
+static_assert(SPRITE_SORTER_BUCKET_SIZE % SPRITE_SORTER_LANES == 0);
+
+/**
+ * Move sprites in front of the sprite being sorted, see ViewportSortParentSpritesMoveInFront.
+ * @param data Array to reorder.
+ * @param pos Position of the sprite being sorted.
+ * @param moved Positions of the sprites to move in front, in ascending order.
+ * @param scratch Scratch space.
+ */
+template <typename T>
+static void SpriteSorterMoveInFront(T *data, uint pos, const std::vector<uint> &moved, std::vector<T> &scratch)
+{
+	scratch.clear();
+	for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+		scratch.push_back(data[*it]);
+	}
+	scratch.push_back(data[pos]);
+
+	/* Shift the runs of sprites between the moved ones towards the end, starting with the last run. */
+	const uint count = (uint)moved.size();
+	for (uint i = count; i-- > 0;) {
+		const uint start = (i == 0 ? pos : moved[i - 1]) + 1;
+		const uint end = moved[i];
+		std::copy_backward(data + start, data + end, data + end + (count - i));
+	}
+
+	std::copy(scratch.begin(), scratch.end(), data + pos);
+}
+
+/** Bounding boxes of the sprites to sort, as a structure of arrays in the current draw order. */
+struct SpriteSorterColumns {
+	enum Column : uint8_t {
+		COL_XMIN,  ///< Minimum X, or #SPRITE_SORTER_DONE.
+		COL_YMIN,
+		COL_ZMIN,
+		COL_XMAX,
+		COL_YMAX,
+		COL_ZMAX,
+		COL_SUM,   ///< Sum of all bounding box coordinates.
+		COL_END,
+	};
+
+	std::vector<int32_t> data;            ///< All columns, each of them padded_size long.
+	std::vector<uint8_t> special;         ///< Whether the sprite has VSSSF_SORT_SPECIAL set and is not yet done.
+	std::vector<int32_t> bucket_min;      ///< Lowest minimum X, Y and Z of each bucket.
+	std::vector<int32_t> scratch;
+	std::vector<uint8_t> scratch_special;
+	std::vector<ParentSpriteToDraw *> scratch_ptrs;
+	uint padded_size = 0;
+
+	inline int32_t *Get(Column col) { return this->data.data() + col * this->padded_size; }
+
+	void Load(ParentSpriteToDraw * const *psd, uint count)
+	{
+		this->padded_size = Align(count, SPRITE_SORTER_BUCKET_SIZE);
+		this->data.assign(COL_END * this->padded_size, SPRITE_SORTER_DONE);
+		this->special.assign(this->padded_size, 0);
+
+		for (uint i = 0; i < count; i++) {
+			const ParentSpriteToDraw *ps = psd[i];
+			if (ps->IsComparisonDone()) continue;
+			this->Get(COL_XMIN)[i] = ps->xmin;
+			this->Get(COL_YMIN)[i] = ps->ymin;
+			this->Get(COL_ZMIN)[i] = ps->zmin;
+			this->Get(COL_XMAX)[i] = ps->xmax;
+			this->Get(COL_YMAX)[i] = ps->ymax;
+			this->Get(COL_ZMAX)[i] = ps->zmax;
+			this->Get(COL_SUM)[i] = ps->xmin + ps->xmax + ps->ymin + ps->ymax + ps->zmin + ps->zmax;
+			this->special[i] = (ps->special_flags & VSSSF_SORT_SPECIAL) != 0;
+		}
+
+		this->bucket_min.resize((this->padded_size / SPRITE_SORTER_BUCKET_SIZE) * 3);
+		this->UpdateBuckets(0, this->padded_size - 1);
+	}
+
+	/**
+	 * Recalculate the bounds of all buckets containing the given positions.
+	 * @param first First position.
+	 * @param last Last position (inclusive).
+	 */
+	void UpdateBuckets(uint first, uint last)
+	{
+		for (uint bucket = first / SPRITE_SORTER_BUCKET_SIZE; bucket <= last / SPRITE_SORTER_BUCKET_SIZE; bucket++) {
+			const uint start = bucket * SPRITE_SORTER_BUCKET_SIZE;
+			for (uint axis = 0; axis < 3; axis++) {
+				const int32_t *col = this->Get((Column)(COL_XMIN + axis)) + start;
+				this->bucket_min[bucket * 3 + axis] = *std::min_element(col, col + SPRITE_SORTER_BUCKET_SIZE);
+			}
+		}
+	}
+
+	/** Mark the sprite at a position as done. */
+	void SetDone(uint pos)
+	{
+		this->Get(COL_XMIN)[pos] = SPRITE_SORTER_DONE;
+		this->special[pos] = 0;
+	}
+
+	/**
+	 * Move sprites in front of the sprite being sorted, in all columns and the sprite array.
+	 * @param psd Sprite array.
+	 * @param pos Position of the sprite being sorted.
+	 * @param moved Positions of the sprites to move in front, in ascending order.
+	 */
+	void MoveInFront(ParentSpriteToDraw **psd, uint pos, const std::vector<uint> &moved)
+	{
+		for (uint col = 0; col < COL_END; col++) {
+			SpriteSorterMoveInFront(this->Get((Column)col), pos, moved, this->scratch);
+		}
+		SpriteSorterMoveInFront(this->special.data(), pos, moved, this->scratch_special);
+		SpriteSorterMoveInFront(psd, pos, moved, this->scratch_ptrs);
+
+		this->UpdateBuckets(pos, moved.back());
+	}
+};
+
+GNU_TARGET("avx2")
+static inline __m256i SpriteSorterLoad(SpriteSorterColumns &cols, SpriteSorterColumns::Column col, uint pos)
+{
+	return _mm256_loadu_si256((const __m256i *)(cols.Get(col) + pos));
+}
+
+/**
+ * Find the sprites in a group of #SPRITE_SORTER_LANES positions which have to be moved in front of the sprite being sorted.
+ * @param cols Bounding box columns.
+ * @param pos First position of the group.
+ * @param ps_min Minimum X, Y and Z of the sprite being sorted, broadcast.
+ * @param ps_max Maximum X, Y and Z of the sprite being sorted, broadcast.
+ * @param ps_sum Sum of the bounding box coordinates of the sprite being sorted, broadcast.
+ * @return Bit mask of the positions to move.
+ */
+GNU_TARGET("avx2")
+static inline uint SpriteSorterCompareGroup(SpriteSorterColumns &cols, uint pos, const __m256i ps_min[3], const __m256i ps_max[3], __m256i ps_sum)
+{
+	using C = SpriteSorterColumns;
+
+	/* ps2 is definitely in front of ps on one of the axes (or is done), so is never moved. */
+	__m256i in_front = _mm256_cmpgt_epi32(SpriteSorterLoad(cols, C::COL_XMIN, pos), ps_max[0]);
+	in_front = _mm256_or_si256(in_front, _mm256_cmpgt_epi32(SpriteSorterLoad(cols, C::COL_YMIN, pos), ps_max[1]));
+	in_front = _mm256_or_si256(in_front, _mm256_cmpgt_epi32(SpriteSorterLoad(cols, C::COL_ZMIN, pos), ps_max[2]));
+
+	/* ps2 is behind ps on one of the axes, so the bounding boxes do not overlap. */
+	__m256i behind = _mm256_cmpgt_epi32(ps_min[0], SpriteSorterLoad(cols, C::COL_XMAX, pos));
+	behind = _mm256_or_si256(behind, _mm256_cmpgt_epi32(ps_min[1], SpriteSorterLoad(cols, C::COL_YMAX, pos)));
+	behind = _mm256_or_si256(behind, _mm256_cmpgt_epi32(ps_min[2], SpriteSorterLoad(cols, C::COL_ZMAX, pos)));
+
+	/* Overlapping bounding boxes are ordered by the sum of their coordinates. */
+	__m256i move = _mm256_or_si256(behind, _mm256_cmpgt_epi32(ps_sum, SpriteSorterLoad(cols, C::COL_SUM, pos)));
+	move = _mm256_andnot_si256(in_front, move);
+
+	return (uint)_mm256_movemask_ps(_mm256_castsi256_ps(move));
+}
+
+/** Sort parent sprites pointer array using AVX2 and spatial bucketing. */
+GNU_TARGET("avx2")
+void ViewportSortParentSpritesAVX2(ParentSpriteToSortVector *psdv)
+{
+	const uint count = (uint)psdv->size();
+	if (count < SPRITE_SORTER_MIN_SPRITES) {
+		ViewportSortParentSpritesSSE41(psdv);
+		return;
+	}
+
+	using C = SpriteSorterColumns;
+	C cols;
+	ParentSpriteToDraw ** const psd = psdv->data();
+	cols.Load(psd, count);
+	const uint bucket_count = cols.padded_size / SPRITE_SORTER_BUCKET_SIZE;
+
+	std::vector<uint> moved;
+
+	uint pos = 0;
+	while (pos < count) {
+		ParentSpriteToDraw * const ps = psd[pos];
+		if (ps->IsComparisonDone()) {
+			pos++;
+			continue;
+		}
+
+		const bool is_special = cols.special[pos] != 0;
+		ps->SetComparisonDone(true);
+		cols.SetDone(pos);
+
+		const __m256i ps_min[3] = { _mm256_set1_epi32(ps->xmin), _mm256_set1_epi32(ps->ymin), _mm256_set1_epi32(ps->zmin) };
+		const __m256i ps_max[3] = { _mm256_set1_epi32(ps->xmax), _mm256_set1_epi32(ps->ymax), _mm256_set1_epi32(ps->zmax) };
+		const __m256i ps_sum = _mm256_set1_epi32(cols.Get(C::COL_SUM)[pos]);
+
+		/* Special sprites may compare using a slightly enlarged bounding box. */
+		const int32_t margin = is_special ? SPRITE_SORTER_SPECIAL_MARGIN : 0;
+		const int32_t bucket_xmax = ps->xmax + margin;
+		const int32_t bucket_ymax = ps->ymax + margin;
+		const int32_t bucket_zmax = ps->zmax;
+
+		moved.clear();
+		const uint first = pos + 1;
+		for (uint bucket = first / SPRITE_SORTER_BUCKET_SIZE; bucket < bucket_count; bucket++) {
+			const int32_t *bucket_min = &cols.bucket_min[bucket * 3];
+			if (bucket_min[0] > bucket_xmax || bucket_min[1] > bucket_ymax || bucket_min[2] > bucket_zmax) continue;
+
+			const uint bucket_start = bucket * SPRITE_SORTER_BUCKET_SIZE;
+			for (uint group = std::max(bucket_start, first & ~(SPRITE_SORTER_LANES - 1)); group < bucket_start + SPRITE_SORTER_BUCKET_SIZE; group += SPRITE_SORTER_LANES) {
+				uint mask = SpriteSorterCompareGroup(cols, group, ps_min, ps_max, ps_sum);
+
+				if (is_special) {
+					for (uint i = 0; i < SPRITE_SORTER_LANES; i++) {
+						bool in_front;
+						if (cols.special[group + i] != 0 && ViewportSortParentSpritesSpecialIsInFront(ps, psd[group + i], in_front)) AssignBit(mask, i, in_front);
+					}
+				}
+
+				/* Sprites up to and including the sorted one are done, so never in the mask. */
+				for (uint i : SetBitIterator(mask)) {
+					moved.push_back(group + i);
+				}
+			}
+		}
+
+		if (!moved.empty()) cols.MoveInFront(psd, pos, moved);
+	}
+}
+
+/**
+ * Check whether the current CPU supports AVX2.
+ * @return True iff the CPU supports AVX2.
+ */
+bool ViewportSortParentSpritesAVX2Checker()
+{
+	return HasCPUAVX2Support();
+}
+
+#endif /* WITH_SSE */
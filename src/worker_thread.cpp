@@ -82,3 +82,54 @@ void WorkerThreadPool::Run(WorkerThreadPool *pool)
 		pool->done_cv.notify_all();
 	}
 }
+
+/* static */ void WorkerThreadPool::RunParallelForItems(ParallelForState *state)
+{
+	while (true) {
+		uint item = state->next_item.fetch_add(1, std::memory_order_relaxed);
+		if (item >= state->count) return;
+
+		state->func(state->ctx, item);
+
+		if (state->items_done.fetch_add(1, std::memory_order_acq_rel) + 1 == state->count) {
+			std::lock_guard<std::mutex> lk(state->lock);
+			state->done_cv.notify_all();
+		}
+	}
+}
+
+/* static */ void WorkerThreadPool::ParallelForJob(ParallelForState *state)
+{
+	RunParallelForItems(state);
+	if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete state;
+}
+
+void WorkerThreadPool::ParallelForImpl(uint count, ParallelForState::ItemFunc *func, void *ctx)
+{
+	if (count == 0) return;
+
+	uint jobs = std::min<uint>(this->GetWorkerCount(), count - 1);
+	if (jobs == 0) {
+		for (uint i = 0; i < count; i++) {
+			func(ctx, i);
+		}
+		return;
+	}
+
+	ParallelForState *state = new ParallelForState();
+	state->func = func;
+	state->ctx = ctx;
+	state->count = count;
+	state->refs.store(jobs + 1, std::memory_order_relaxed);
+	for (uint i = 0; i < jobs; i++) {
+		this->EnqueueJob<ParallelForJob>(state);
+	}
+
+	RunParallelForItems(state);
+
+	{
+		std::unique_lock<std::mutex> lk(state->lock);
+		state->done_cv.wait(lk, [state]() { return state->items_done.load(std::memory_order_acquire) == state->count; });
+	}
+	if (state->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete state;
+}
@@ -12,6 +12,7 @@
 
 #include "core/bit_cast.hpp"
 #include "core/ring_buffer_queue.hpp"
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <array>
@@ -41,9 +42,26 @@ private:
 	std::condition_variable worker_wait_cv;
 	std::condition_variable done_cv;
 
+	/** Shared state of a #ParallelFor call, this is reference counted as queued jobs may outlive the call. */
+	struct ParallelForState {
+		using ItemFunc = void(void *ctx, uint item);
+
+		ItemFunc *func;
+		void *ctx;
+		uint count;
+		std::atomic<uint> next_item{0};
+		std::atomic<uint> items_done{0};
+		std::atomic<uint> refs{1};
+		std::mutex lock;
+		std::condition_variable done_cv;
+	};
+
 	static void Run(WorkerThreadPool *pool);
+	static void RunParallelForItems(ParallelForState *state);
+	static void ParallelForJob(ParallelForState *state);
 
 	void EnqueueWorkerJob(WorkerJob job);
+	void ParallelForImpl(uint count, ParallelForState::ItemFunc *func, void *ctx);
 
 public:
 
@@ -64,6 +82,31 @@ public:
 		this->EnqueueWorkerJob(job);
 	}
 
+	/**
+	 * Call func(item) for each item in [0, count), spread over the worker threads and the calling thread.
+	 * The calling thread also processes items, so this does not depend on any worker becoming free.
+	 * Items may run in any order and concurrently, this returns once all items have completed.
+	 * @param count Number of items.
+	 * @param func Functor to call for each item.
+	 */
+	template <typename F>
+	void ParallelFor(uint count, F &&func)
+	{
+		this->ParallelForImpl(count, [](void *ctx, uint item) {
+			(*static_cast<std::remove_reference_t<F> *>(ctx))(item);
+		}, &func);
+	}
+
+	/**
+	 * Get the number of worker threads, not including the calling thread.
+	 * @return Number of workers.
+	 */
+	uint GetWorkerCount()
+	{
+		std::lock_guard<std::mutex> lk(this->lock);
+		return this->workers;
+	}
+
 	~WorkerThreadPool()
 	{
 		this->Stop();
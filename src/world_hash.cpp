@@ -0,0 +1,290 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <https://www.gnu.org/licenses/old-licenses/gpl-2.0>.
+ */
+
+/** @file world_hash.cpp Sharded hashes of the world state, for localising desyncs. */
+
+#include "stdafx.h"
+#include "cargopacket.h"
+#include "company_base.h"
+#include "debug_desync.h"
+#include "map_func.h"
+#include "order_base.h"
+#include "station_base.h"
+#include "vehicle_base.h"
+#include "worker_thread.h"
+#include "core/checksum_func.hpp"
+
+#include <cstring>
+
+#include "safeguards.h"
+
+static const char * const _world_state_hash_part_names[WSHP_END] = {
+	"map",
+	"vehicles",
+	"stations",
+	"cargo_packets",
+	"orders",
+	"companies",
+};
+
+/**
+ * Get the name of a part of the world state hash.
+ * @param part The part.
+ * @return The name, as used by the dump_world_hash console command.
+ */
+const char *GetWorldStateHashPartName(WorldStateHashPart part)
+{
+	return _world_state_hash_part_names[part];
+}
+
+/**
+ * Describe what a shard of the world state hash covers.
+ * @param part The part.
+ * @param shard The shard, map regions are in row major order.
+ * @param region_size_log Log2 of the width/height of a map region.
+ * @return The tiles or pool items of the shard.
+ */
+std::string DescribeWorldStateHashShard(WorldStateHashPart part, uint shard, uint region_size_log)
+{
+	if (part == WSHP_MAP) {
+		const uint regions_x = CeilDivT<uint>(Map::SizeX(), 1 << region_size_log);
+		return fmt::format("tiles {} x {}", (shard % regions_x) << region_size_log, (shard / regions_x) << region_size_log);
+	}
+	return fmt::format("items {} - {}", shard * WORLD_STATE_HASH_POOL_SHARD_SIZE, ((shard + 1) * WORLD_STATE_HASH_POOL_SHARD_SIZE) - 1);
+}
+
+/**
+ * Get the hash of a part of the world state, this is the hash of all shards of that part.
+ * @param part The part.
+ * @return The hash.
+ */
+uint64_t WorldStateHash::PartHash(WorldStateHashPart part) const
+{
+	SimpleChecksum64 checksum;
+	for (uint64_t shard : this->shards[part]) {
+		checksum.Update(shard);
+	}
+	return checksum.state;
+}
+
+/**
+ * Get the root hash of the world state, this is the hash of the hashes of all parts.
+ * @return The hash.
+ */
+uint64_t WorldStateHash::RootHash() const
+{
+	SimpleChecksum64 checksum;
+	for (uint part = 0; part < WSHP_END; part++) {
+		checksum.Update(this->PartHash(static_cast<WorldStateHashPart>(part)));
+	}
+	return checksum.state;
+}
+
+/**
+ * Hash the tiles of one map region.
+ * @param region_size_log Log2 of the width/height of a region.
+ * @param rx Region x coordinate.
+ * @param ry Region y coordinate.
+ * @return The hash.
+ */
+static uint64_t HashMapRegion(uint region_size_log, uint rx, uint ry)
+{
+	const uint x_start = rx << region_size_log;
+	const uint y_start = ry << region_size_log;
+	const uint x_end = std::min<uint>(x_start + (1 << region_size_log), Map::SizeX());
+	const uint y_end = std::min<uint>(y_start + (1 << region_size_log), Map::SizeY());
+
+	SimpleChecksum64 checksum;
+	for (uint y = y_start; y < y_end; y++) {
+		for (uint x = x_start; x < x_end; x++) {
+			const TileIndex tile = TileXY(x, y);
+			uint64_t m;
+			uint32_t me;
+			static_assert(sizeof(m) == sizeof(Tile));
+			static_assert(sizeof(me) == sizeof(TileExtended));
+			std::memcpy(&m, &_m[tile], sizeof(m));
+			std::memcpy(&me, &_me[tile], sizeof(me));
+			checksum.Update(m);
+			checksum.Update(me);
+		}
+	}
+	return checksum.state;
+}
+
+static void HashVehicle(SimpleChecksum64 &checksum, const Vehicle *v)
+{
+	checksum.Update(to_underlying(v->type) | (v->direction << 8) | (static_cast<uint64_t>(v->vehstatus.base()) << 16) | (static_cast<uint64_t>(v->engine_type.base()) << 32));
+	checksum.Update(v->tile.base() | (static_cast<uint64_t>(v->cur_real_order_index) << 32));
+	checksum.Update(static_cast<uint32_t>(v->x_pos) | (static_cast<uint64_t>(static_cast<uint32_t>(v->y_pos)) << 32));
+	checksum.Update(static_cast<uint32_t>(v->z_pos) | (static_cast<uint64_t>(v->cur_speed) << 32) | (static_cast<uint64_t>(v->progress) << 48) | (static_cast<uint64_t>(v->subspeed) << 56));
+	checksum.Update(v->cargo.StoredCount() | (static_cast<uint64_t>(v->reliability) << 32));
+	checksum.Update(v->profit_this_year.base());
+}
+
+static void HashStation(SimpleChecksum64 &checksum, const Station *st)
+{
+	checksum.Update(st->xy.base() | (static_cast<uint64_t>(st->facilities.base()) << 32));
+	for (const GoodsEntry &ge : st->goods) {
+		checksum.Update(ge.rating | (static_cast<uint64_t>(ge.status.base()) << 8));
+	}
+}
+
+static void HashCargoPacket(SimpleChecksum64 &checksum, const CargoPacket *cp)
+{
+	checksum.Update(cp->Count() | (static_cast<uint64_t>(cp->GetPeriodsInTransit()) << 16) | (static_cast<uint64_t>(cp->GetFirstStation().base()) << 32));
+	checksum.Update(cp->GetNextHop().base());
+	checksum.Update(cp->GetFeederShare().base());
+}
+
+static void HashOrderList(SimpleChecksum64 &checksum, const OrderList *list)
+{
+	for (VehicleOrderID i = 0; i < list->GetNumOrders(); i++) {
+		const Order *order = list->GetOrderAt(i);
+		checksum.Update(order->GetType() | (static_cast<uint64_t>(order->GetRawFlags()) << 8) | (static_cast<uint64_t>(order->GetDestination().value) << 24) | (static_cast<uint64_t>(order->GetMaxSpeed()) << 48));
+		checksum.Update(order->GetWaitTime() | (static_cast<uint64_t>(order->GetTravelTime()) << 32));
+		checksum.Update(order->GetXData());
+	}
+}
+
+static void HashCompany(SimpleChecksum64 &checksum, const Company *c)
+{
+	checksum.Update(c->money.base());
+	checksum.Update(c->current_loan.base());
+}
+
+/**
+ * Hash the items of one shard of a pool.
+ * @tparam T The pool item type.
+ * @tparam hash_item The function adding one item to the hash.
+ * @param shard The shard, which covers WORLD_STATE_HASH_POOL_SHARD_SIZE consecutive indices.
+ * @return The hash.
+ */
+template <typename T, void (*hash_item)(SimpleChecksum64 &, const T *)>
+static uint64_t HashPoolShard(uint shard)
+{
+	SimpleChecksum64 checksum;
+	const size_t end = std::min<size_t>((static_cast<size_t>(shard) + 1) * WORLD_STATE_HASH_POOL_SHARD_SIZE, T::GetPoolSize());
+	for (size_t index = static_cast<size_t>(shard) * WORLD_STATE_HASH_POOL_SHARD_SIZE; index < end; index++) {
+		const T *item = T::GetIfValid(index);
+		if (item == nullptr) continue;
+		checksum.Update(index);
+		hash_item(checksum, item);
+	}
+	return checksum.state;
+}
+
+/**
+ * Get the number of shards of a part of the world state hash.
+ * @param part The part.
+ * @param region_size_log Log2 of the width/height of a map region.
+ * @return The number of shards.
+ */
+uint GetWorldStateHashShardCount(WorldStateHashPart part, uint region_size_log)
+{
+	auto pool_shards = [](size_t pool_size) { return static_cast<uint>(CeilDivT<size_t>(pool_size, WORLD_STATE_HASH_POOL_SHARD_SIZE)); };
+	switch (part) {
+		case WSHP_MAP: return CeilDivT<uint>(Map::SizeX(), 1 << region_size_log) * CeilDivT<uint>(Map::SizeY(), 1 << region_size_log);
+		case WSHP_VEHICLES: return pool_shards(Vehicle::GetPoolSize());
+		case WSHP_STATIONS: return pool_shards(Station::GetPoolSize());
+		case WSHP_CARGO_PACKETS: return pool_shards(CargoPacket::GetPoolSize());
+		case WSHP_ORDERS: return pool_shards(OrderList::GetPoolSize());
+		case WSHP_COMPANIES: return pool_shards(Company::GetPoolSize());
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Compute the hash of one shard of the world state.
+ * Shards past the end of a part hash as empty, so that differently sized pools can still be compared.
+ * @param part The part.
+ * @param shard The shard, map regions are in row major order.
+ * @param region_size_log Log2 of the width/height of a map region.
+ * @return The hash.
+ */
+uint64_t ComputeWorldStateHashShard(WorldStateHashPart part, uint shard, uint region_size_log)
+{
+	switch (part) {
+		case WSHP_MAP: {
+			const uint regions_x = CeilDivT<uint>(Map::SizeX(), 1 << region_size_log);
+			return HashMapRegion(region_size_log, shard % regions_x, shard / regions_x);
+		}
+		case WSHP_VEHICLES: return HashPoolShard<Vehicle, HashVehicle>(shard);
+		case WSHP_STATIONS: return HashPoolShard<Station, HashStation>(shard);
+		case WSHP_CARGO_PACKETS: return HashPoolShard<CargoPacket, HashCargoPacket>(shard);
+		case WSHP_ORDERS: return HashPoolShard<OrderList, HashOrderList>(shard);
+		case WSHP_COMPANIES: return HashPoolShard<Company, HashCompany>(shard);
+		default: NOT_REACHED();
+	}
+}
+
+/**
+ * Compute the sharded hash of the current world state.
+ * Map regions are hashed in parallel on the worker pool.
+ * @param region_size_log Log2 of the width/height of a map region.
+ * @return The hash.
+ */
+WorldStateHash ComputeWorldStateHash(uint region_size_log)
+{
+	WorldStateHash hash;
+	hash.region_size_log = region_size_log;
+	hash.regions_x = CeilDivT<uint>(Map::SizeX(), 1 << region_size_log);
+
+	std::vector<uint64_t> &map_shards = hash.shards[WSHP_MAP];
+	map_shards.resize(GetWorldStateHashShardCount(WSHP_MAP, region_size_log));
+	_general_worker_pool.ParallelFor(static_cast<uint>(map_shards.size()), [&](uint shard) {
+		map_shards[shard] = ComputeWorldStateHashShard(WSHP_MAP, shard, region_size_log);
+	});
+
+	for (uint part = WSHP_MAP + 1; part < WSHP_END; part++) {
+		const WorldStateHashPart hash_part = static_cast<WorldStateHashPart>(part);
+		const uint count = GetWorldStateHashShardCount(hash_part, region_size_log);
+		for (uint shard = 0; shard < count; shard++) {
+			hash.shards[part].push_back(ComputeWorldStateHashShard(hash_part, shard, region_size_log));
+		}
+	}
+
+	return hash;
+}
+
+/**
+ * Compute the hashes of the next shards of the world state, in a rotation over all shards of all parts.
+ * This is used by the server to send a few shard hashes with each sync, so that over time the whole
+ * world state is compared with each client, without hashing all of it at once.
+ * @param count The number of shards to hash.
+ * @return The shard hashes.
+ */
+std::vector<WorldStateShardHash> ComputeNextWorldStateShardHashes(uint count)
+{
+	static WorldStateHashPart part = WSHP_MAP;
+	static uint shard = 0;
+
+	std::vector<WorldStateShardHash> result;
+	/* The map has at least one region, so the rotation always finds enough shards. */
+	while (result.size() < count) {
+		if (shard >= GetWorldStateHashShardCount(part, WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG)) {
+			part = static_cast<WorldStateHashPart>((part + 1) % WSHP_END);
+			shard = 0;
+			continue;
+		}
+		result.push_back({ part, shard, ComputeWorldStateHashShard(part, shard, WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG) });
+		shard++;
+	}
+	return result;
+}
+
+/**
+ * Find the first shard whose hash differs from the local world state.
+ * @param expected The shard hashes to compare with, as computed by #ComputeNextWorldStateShardHashes.
+ * @return The first differing shard, or nullptr if all match.
+ */
+const WorldStateShardHash *FindWorldStateShardHashMismatch(std::span<const WorldStateShardHash> expected)
+{
+	for (const WorldStateShardHash &shard_hash : expected) {
+		if (ComputeWorldStateHashShard(shard_hash.part, shard_hash.shard, WORLD_STATE_HASH_DEFAULT_REGION_SIZE_LOG) != shard_hash.hash) return &shard_hash;
+	}
+	return nullptr;
+}